@@ -1,20 +1,63 @@
 include("QXlsx\QXlsx\QXlsx.pri")
 
-QT += core gui widgets charts
+QT += core gui widgets charts concurrent
 QT += charts
 
 TARGET = MapAnalyzer
 TEMPLATE = app
 
 SOURCES += main.cpp \
+           cli.cpp \
            MemoryDetailDialog.cpp \
            mainwindow.cpp \
-           MapParser.cpp
+           MapParser.cpp \
+           comparisondialog.cpp \
+           demangler.cpp \
+           dependencygraph.cpp \
+           discardreport.cpp \
+           elfreader.cpp \
+           excelexport.cpp \
+           frontcodednames.cpp \
+           heatmapdialog.cpp \
+           heatmapview.cpp \
+           linkerscript.cpp \
+           mapmodel.cpp \
+           modelcache.cpp \
+           occupancymap.cpp \
+           paddinganalysis.cpp \
+           reportdialog.cpp \
+           sizebudget.cpp \
+           stackusage.cpp \
+           symbolfilter.cpp \
+           symboltabledialog.cpp \
+           symboltablemodel.cpp
 
 HEADERS += mainwindow.h \
            MapParser.h \
            MemoryDetailDialog.h \
-           clickablelabel.h
+           checkedstream.h \
+           clickablelabel.h \
+           cli.h \
+           comparisondialog.h \
+           demangler.h \
+           dependencygraph.h \
+           discardreport.h \
+           elfreader.h \
+           excelexport.h \
+           frontcodednames.h \
+           heatmapdialog.h \
+           heatmapview.h \
+           linkerscript.h \
+           mapmodel.h \
+           modelcache.h \
+           occupancymap.h \
+           paddinganalysis.h \
+           reportdialog.h \
+           sizebudget.h \
+           stackusage.h \
+           symbolfilter.h \
+           symboltabledialog.h \
+           symboltablemodel.h
 
 RESOURCES += \
     assets.qrc
@@ -3,7 +3,15 @@
 ########################################
 
 QT += core
-QT += gui-private
+QT += gui
+QT += concurrent
+
+# The zip reader and writer use zlib directly; link the zlib Qt was built with
+qtConfig(system-zlib) {
+    QMAKE_USE_PRIVATE += zlib
+} else {
+    QT_PRIVATE += zlib-private
+}
 
 # TODO: Define your C++ version. c++14, c++17, etc.
 CONFIG += c++11
@@ -65,6 +73,7 @@ $${QXLSX_HEADERPATH}xlsxcelllocation.h \
 $${QXLSX_HEADERPATH}xlsxcellrange.h \
 $${QXLSX_HEADERPATH}xlsxcellreference.h \
 $${QXLSX_HEADERPATH}xlsxcell_p.h \
+$${QXLSX_HEADERPATH}xlsxcelltable_p.h \
 $${QXLSX_HEADERPATH}xlsxchart.h \
 $${QXLSX_HEADERPATH}xlsxchartsheet.h \
 $${QXLSX_HEADERPATH}xlsxchartsheet_p.h \
@@ -92,6 +101,10 @@ $${QXLSX_HEADERPATH}xlsxrichstring.h \
 $${QXLSX_HEADERPATH}xlsxrichstring_p.h \
 $${QXLSX_HEADERPATH}xlsxsharedstrings_p.h \
 $${QXLSX_HEADERPATH}xlsxsimpleooxmlfile_p.h \
+$${QXLSX_HEADERPATH}xlsxstreamreader.h \
+$${QXLSX_HEADERPATH}xlsxstreamreader_p.h \
+$${QXLSX_HEADERPATH}xlsxstreamwriter.h \
+$${QXLSX_HEADERPATH}xlsxstreamwriter_p.h \
 $${QXLSX_HEADERPATH}xlsxstyles_p.h \
 $${QXLSX_HEADERPATH}xlsxtheme_p.h \
 $${QXLSX_HEADERPATH}xlsxutility_p.h \
@@ -110,6 +123,7 @@ $${QXLSX_SOURCEPATH}xlsxcellformula.cpp \
 $${QXLSX_SOURCEPATH}xlsxcelllocation.cpp \
 $${QXLSX_SOURCEPATH}xlsxcellrange.cpp \
 $${QXLSX_SOURCEPATH}xlsxcellreference.cpp \
+$${QXLSX_SOURCEPATH}xlsxcelltable.cpp \
 $${QXLSX_SOURCEPATH}xlsxchart.cpp \
 $${QXLSX_SOURCEPATH}xlsxchartsheet.cpp \
 $${QXLSX_SOURCEPATH}xlsxcolor.cpp \
@@ -129,6 +143,8 @@ $${QXLSX_SOURCEPATH}xlsxrelationships.cpp \
 $${QXLSX_SOURCEPATH}xlsxrichstring.cpp \
 $${QXLSX_SOURCEPATH}xlsxsharedstrings.cpp \
 $${QXLSX_SOURCEPATH}xlsxsimpleooxmlfile.cpp \
+$${QXLSX_SOURCEPATH}xlsxstreamreader.cpp \
+$${QXLSX_SOURCEPATH}xlsxstreamwriter.cpp \
 $${QXLSX_SOURCEPATH}xlsxstyles.cpp \
 $${QXLSX_SOURCEPATH}xlsxtheme.cpp \
 $${QXLSX_SOURCEPATH}xlsxutility.cpp \
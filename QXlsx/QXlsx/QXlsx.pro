@@ -4,7 +4,7 @@ TARGET = QXlsx
 TEMPLATE = lib
 CONFIG += staticlib
 QT += core
-QT += gui-private
+QT += gui
 
 #####################################################################
 # set debug/release build environment
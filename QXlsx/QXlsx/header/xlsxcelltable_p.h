@@ -0,0 +1,126 @@
+// xlsxcelltable_p.h
+
+#ifndef XLSXCELLTABLE_P_H
+#define XLSXCELLTABLE_P_H
+
+#include "xlsxcell.h"
+#include "xlsxglobal.h"
+
+#include <QVector>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE_XLSX
+
+class WorksheetPrivate;
+
+/*
+ * Cell storage of a worksheet.
+ *
+ * Rows are grouped in chunks of 256 and every row is a list of runs of
+ * consecutive columns, ordered by column. A short gap is filled with empty
+ * slots rather than starting a new run, so dense rows end up as one run and
+ * sparse rows as a few small ones.
+ *
+ * Plain cells (numbers, dates, booleans, shared strings and blanks) are kept
+ * as 16-byte slots holding the value and the xf index of their format. Cells
+ * with a formula, a rich string or any other type keep their Cell object.
+ * cellAt() builds a Cell for a plain slot on demand, so changes made to it
+ * have to be stored back with setValue().
+ */
+class CellTable
+{
+public:
+    enum SlotType : quint8 {
+        EmptySlot,
+        NumberSlot,
+        DateSlot,
+        BoolSlot,
+        StringSlot, // index into the shared strings
+        BlankSlot,
+        CustomSlot, // number read from a cell without type, kept as text by Cell
+        CellSlot // index into objects
+    };
+
+    struct Slot
+    {
+        Slot()
+            : number(0)
+            , style(-1)
+            , type(EmptySlot)
+        {
+        }
+
+        union {
+            double number;
+            qint32 index;
+            bool boolean;
+        };
+        qint32 style; // xf index, -1 without format
+        SlotType type;
+    };
+
+    struct Run
+    {
+        int firstColumn;
+        QVector<Slot> slots;
+
+        int lastColumn() const { return firstColumn + slots.size() - 1; }
+    };
+    typedef QVector<Run> Row;
+
+    explicit CellTable(const WorksheetPrivate *sheet);
+
+    void setValue(int row, int column, const std::shared_ptr<Cell> &cell);
+    void setSlot(int row, int column, const Slot &slot);
+    void setSharedString(int row, int column, int index, const Format &format);
+
+    std::shared_ptr<Cell> cellAt(int row, int column) const;
+    std::shared_ptr<Cell> cellOf(const Slot &slot) const;
+    bool contains(int row, int column) const;
+    bool isEmpty() const { return count == 0; }
+
+    // Runs of the row, or nullptr if the row has no cells
+    const Row *row(int row) const;
+
+    // Calls f(row, runs) for every row with cells, in row order
+    template <typename Function>
+    void forEachRow(Function f) const
+    {
+        for (int c = 0; c < chunks.size(); ++c) {
+            const QVector<Row> &rows = chunks[c];
+            for (int r = 0; r < rows.size(); ++r) {
+                if (!rows[r].isEmpty())
+                    f(c * ChunkRows + r + 1, rows[r]);
+            }
+        }
+    }
+
+    int firstRow    = -1;
+    int firstColumn = -1;
+    int lastRow     = -1;
+    int lastColumn  = -1;
+
+private:
+    enum {
+        ChunkRows = 256,
+        MaxGap    = 3 // empty slots cost less than a new run up to this gap
+    };
+
+    Slot *slotAt(int row, int column);
+    const Slot *findSlot(int row, int column) const;
+    void store(int row, int column, const Slot &slot);
+
+    const WorksheetPrivate *sheet;
+    QVector<QVector<Row>> chunks; // empty until a row of the chunk is used
+    QVector<std::shared_ptr<Cell>> objects;
+    QVector<qint32> freeObjects;
+    int count = 0;
+};
+
+QT_END_NAMESPACE_XLSX
+
+Q_DECLARE_TYPEINFO(QXlsx::CellTable::Slot, Q_MOVABLE_TYPE);
+Q_DECLARE_TYPEINFO(QXlsx::CellTable::Run, Q_MOVABLE_TYPE);
+
+#endif // XLSXCELLTABLE_P_H
@@ -29,9 +29,23 @@ class QXLSX_EXPORT Document : public QObject
     Q_DECLARE_PRIVATE(Document) // D-Pointer. Qt classes have a Q_DECLARE_PRIVATE
                                 // macro in the public class. The macro reads: qglobal.h
 public:
+    enum Compression {
+        CompressionStore, // parts are stored as they are
+        CompressionFast,
+        CompressionDefault,
+        CompressionMax
+    };
+
+    enum LoadMode {
+        LoadEverything,
+        LoadOnDemand // sheets are read when first used
+    };
+
     explicit Document(QObject *parent = nullptr);
     Document(const QString &xlsxName, QObject *parent = nullptr);
+    Document(const QString &xlsxName, LoadMode mode, QObject *parent = nullptr);
     Document(QIODevice *device, QObject *parent = nullptr);
+    Document(QIODevice *device, LoadMode mode, QObject *parent = nullptr);
     ~Document();
 
     bool write(const CellReference &cell, const QVariant &value, const Format &format = Format());
@@ -119,6 +133,10 @@ public:
 
     bool saveAsCsv(const QString mainCSVFileName) const;
 
+    Compression compression() const;
+    void setCompression(Compression compression);
+    void setPartCompression(const QString &filePattern, Compression compression);
+
     // copy style from one xlsx file to other
     static bool copyStyle(const QString &from, const QString &to);
 
@@ -133,6 +151,9 @@ public:
     bool autosizeColumnWidth();
 
 private:
+    friend class StreamReaderPrivate;
+    friend class StreamWriterPrivate;
+
     QMap<int, int> getMaximalColumnWidth(int firstRow = 1, int lastRow = INT_MAX);
 
 private:
@@ -8,10 +8,17 @@
 #include "xlsxglobal.h"
 #include "xlsxworkbook.h"
 
+#include <QList>
 #include <QMap>
+#include <QPair>
+
+#include <memory>
 
 QT_BEGIN_NAMESPACE_XLSX
 
+class ZipReader;
+class ZipWriter;
+
 class DocumentPrivate
 {
     Q_DECLARE_PUBLIC(Document)
@@ -20,9 +27,16 @@ public:
     void init();
 
     bool loadPackage(QIODevice *device);
+    bool loadPackage(ZipReader &zipReader, bool loadSheets);
+    bool loadPackageOnDemand(const std::shared_ptr<ZipReader> &zipReader);
+    static void loadSheetOnDemand(AbstractSheet *sheet,
+                                  const std::shared_ptr<ZipReader> &zipReader);
+    void releasePackage() const;
     bool savePackage(QIODevice *device) const;
+    bool savePackage(ZipWriter &zipWriter, bool worksheetsStreamed) const;
 
     bool saveCsv(const QString mainCSVFileName) const;
+    int compressionLevel(const QString &filePath) const;
 
     // copy style from one xlsx file to other
     static bool copyStyle(const QString &from, const QString &to);
@@ -35,6 +49,9 @@ public:
     std::shared_ptr<Workbook> workbook;
     std::shared_ptr<ContentTypes> contentTypes;
     bool isLoad;
+
+    Document::Compression compression;
+    QList<QPair<QString, Document::Compression>> partCompressions; // file pattern, compression
 };
 
 QT_END_NAMESPACE_XLSX
@@ -8,6 +8,8 @@
 #include <QByteArray>
 #include <QString>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE_XLSX
 
 class MediaFile
@@ -18,6 +20,7 @@ public:
 
 public:
     void set(const QByteArray &bytes, const QString &suffix, const QString &mimeType = QString());
+    void setLoader(const std::function<QByteArray()> &loader, const QString &suffix);
     QString suffix() const;
     QString mimeType() const;
     QByteArray contents() const;
@@ -31,6 +34,8 @@ public:
     QString fileName() const;
 
 protected:
+    void load() const;
+
     QString m_fileName;
     QByteArray m_contents;
     QString m_suffix;
@@ -39,6 +44,7 @@ protected:
     int m_index;
     bool m_indexValid;
     QByteArray m_hashKey;
+    std::function<QByteArray()> m_loader; // reads the contents on first use
 };
 
 QT_END_NAMESPACE_XLSX
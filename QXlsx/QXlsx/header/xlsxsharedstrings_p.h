@@ -40,9 +40,13 @@
 #include "xlsxglobal.h"
 #include "xlsxrichstring.h"
 
+#include <QAtomicInt>
+#include <QBitArray>
 #include <QHash>
 #include <QIODevice>
+#include <QMutex>
 #include <QStringList>
+#include <QVector>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
@@ -66,32 +70,57 @@ class SharedStrings : public AbstractOOXmlFile
 public:
     SharedStrings(CreateFlag flag);
     int count() const;
+    int uniqueCount() const;
     bool isEmpty() const;
 
     int addSharedString(const QString &string);
     int addSharedString(const RichString &string);
     void removeSharedString(const QString &string);
     void removeSharedString(const RichString &string);
-    void incRefByStringIndex(int idx);
+    void incRefByStringIndex(int idx, int count = 1);
 
     int getSharedStringIndex(const QString &string) const;
     int getSharedStringIndex(const RichString &string) const;
     RichString getSharedString(int index) const;
+    QString getSharedPlainString(int index) const;
+    bool isRichString(int index) const;
     QList<RichString> getSharedStrings() const;
 
     void saveToXmlFile(QIODevice *device) const override;
     bool loadFromXmlFile(QIODevice *device) override;
 
 private:
-    void readString(QXmlStreamReader &reader);                            // <si>
-    void readRichStringPart(QXmlStreamReader &reader, RichString &rich);  // <r>
-    void readPlainStringPart(QXmlStreamReader &reader, RichString &rich); // <v>
-    Format readRichStringPart_rPr(QXmlStreamReader &reader);
+    RichString readString(QXmlStreamReader &reader) const;                      // <si>
+    void readRichStringPart(QXmlStreamReader &reader, RichString &rich) const;  // <r>
+    void readPlainStringPart(QXmlStreamReader &reader, RichString &rich) const; // <v>
+    Format readRichStringPart_rPr(QXmlStreamReader &reader) const;
     void writeRichStringPart_rPr(QXmlStreamWriter &writer, const Format &format) const;
+    void appendString(const RichString &string);
+    void addStringRefs(int idx, int count);
+    void removeStringAt(int index);
 
-    QHash<RichString, XlsxSharedStringInfo> m_stringTable; // for fast lookup
-    QList<RichString> m_stringList;
+    bool indexStrings(const QByteArray &data);
+    void decodeString(int index) const;
+    void ensureTables() const;
+
+    // Plain strings are kept as QString only; the few rich strings have
+    // their own table so that plain ones never build or hash a RichString
+    QHash<QString, XlsxSharedStringInfo> m_stringTable;         // plain strings, for fast lookup
+    QHash<RichString, XlsxSharedStringInfo> m_richStringTable; // rich strings, for lookup
+    QStringList m_stringList;                                  // plain text of every index
+    QHash<int, RichString> m_richStrings;                      // rich strings by index
     int m_stringCount;
+
+    // Lazy mode, see indexStrings(): the part stays as it was read and a <si>
+    // is decoded when its string is first used. The lookup tables are built,
+    // decoding everything, only when a string has to be found by its text.
+    QAtomicInt m_lazy;
+    mutable QMutex m_mutex;     // guards decoding while m_lazy is set
+    QByteArray m_xmlData;       // the sst part
+    QVector<int> m_offsets;     // start of every <si>, then the end of the last one
+    QBitArray m_decoded;        // strings of m_stringList already decoded
+    QBitArray m_mayBeRich;      // <si> with a <r> run, kept until the next load
+    QVector<int> m_pendingRefs; // uses counted before the lookup tables exist
 };
 
 QT_END_NAMESPACE_XLSX
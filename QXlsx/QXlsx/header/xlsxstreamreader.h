@@ -0,0 +1,55 @@
+// xlsxstreamreader.h
+
+#ifndef QXLSX_XLSXSTREAMREADER_H
+#define QXLSX_XLSXSTREAMREADER_H
+
+#include "xlsxcell.h"
+#include "xlsxglobal.h"
+
+#include <QIODevice>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE_XLSX
+
+class StreamReaderPrivate;
+
+struct StreamCell
+{
+    int column          = 0;
+    Cell::CellType type = Cell::NumberType;
+    int styleIndex      = -1;
+    QVariant value; // cached result for formulas, QDateTime for date formats
+};
+
+class QXLSX_EXPORT StreamReader
+{
+    Q_DECLARE_PRIVATE(StreamReader)
+public:
+    explicit StreamReader(const QString &fileName);
+    explicit StreamReader(QIODevice *device);
+    ~StreamReader();
+
+    bool isValid() const;
+    QStringList sheetNames() const;
+    bool selectSheet(int index);
+    bool selectSheet(const QString &name);
+
+    bool readNextRow();
+    int row() const;
+    const QVector<StreamCell> &cells() const;
+    QVariant read(int column) const;
+
+    bool hasError() const;
+    QString errorString() const;
+
+private:
+    Q_DISABLE_COPY(StreamReader)
+    StreamReaderPrivate *const d_ptr;
+};
+
+QT_END_NAMESPACE_XLSX
+
+#endif // QXLSX_XLSXSTREAMREADER_H
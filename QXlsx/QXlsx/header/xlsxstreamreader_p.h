@@ -0,0 +1,48 @@
+// xlsxstreamreader_p.h
+
+#ifndef XLSXSTREAMREADER_P_H
+#define XLSXSTREAMREADER_P_H
+
+#include "xlsxdocument.h"
+#include "xlsxglobal.h"
+#include "xlsxstreamreader.h"
+#include "xlsxzipreader_p.h"
+
+#include <QIODevice>
+#include <QXmlStreamReader>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE_XLSX
+
+class StreamReaderPrivate
+{
+    Q_DECLARE_PUBLIC(StreamReader)
+public:
+    StreamReaderPrivate(StreamReader *p, ZipReader *zip);
+
+    bool load();
+    bool openSheet(int index);
+    void readCell();
+    QVariant cellValue(Cell::CellType type, const QString &text);
+    bool isDateStyle(int styleIndex);
+    bool fail(const QString &message);
+
+    StreamReader *q_ptr;
+    std::unique_ptr<ZipReader> zipReader;
+    Document document; // workbook, styles and shared strings; sheets stay empty
+    bool valid;
+    QString error;
+
+    std::unique_ptr<QIODevice> sheetData; // XML of the selected sheet, inflated as it is read
+    std::unique_ptr<QXmlStreamReader> reader;
+    bool inSheetData;
+
+    int row;
+    QVector<StreamCell> cells; // the current row, reused for the next one
+    QVector<qint8> dateStyles; // per style index: -1 unknown, 0 no, 1 date
+};
+
+QT_END_NAMESPACE_XLSX
+
+#endif // XLSXSTREAMREADER_P_H
@@ -0,0 +1,45 @@
+// xlsxstreamwriter.h
+
+#ifndef QXLSX_XLSXSTREAMWRITER_H
+#define QXLSX_XLSXSTREAMWRITER_H
+
+#include "xlsxformat.h"
+#include "xlsxglobal.h"
+
+#include <QIODevice>
+#include <QString>
+#include <QVariant>
+
+QT_BEGIN_NAMESPACE_XLSX
+
+class Document;
+class Worksheet;
+class StreamWriterPrivate;
+
+class QXLSX_EXPORT StreamWriter
+{
+    Q_DECLARE_PRIVATE(StreamWriter)
+public:
+    explicit StreamWriter(const QString &fileName);
+    explicit StreamWriter(QIODevice *device);
+    ~StreamWriter();
+
+    bool addSheet(const QString &name = QString());
+    Worksheet *currentWorksheet() const;
+    Document *document() const;
+
+    bool writeRow(const QVariantList &values, const Format &format = Format());
+    bool writeRow(int column, const QVariantList &values, const Format &format = Format());
+    int rowCount() const;
+
+    bool close();
+    bool error() const;
+
+private:
+    Q_DISABLE_COPY(StreamWriter)
+    StreamWriterPrivate *const d_ptr;
+};
+
+QT_END_NAMESPACE_XLSX
+
+#endif // QXLSX_XLSXSTREAMWRITER_H
@@ -0,0 +1,48 @@
+// xlsxstreamwriter_p.h
+
+#ifndef XLSXSTREAMWRITER_P_H
+#define XLSXSTREAMWRITER_P_H
+
+#include "xlsxdocument.h"
+#include "xlsxglobal.h"
+#include "xlsxstreamwriter.h"
+#include "xlsxzipwriter_p.h"
+
+#include <QBuffer>
+#include <QXmlStreamWriter>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE_XLSX
+
+class StreamWriterPrivate
+{
+    Q_DECLARE_PUBLIC(StreamWriter)
+public:
+    StreamWriterPrivate(StreamWriter *p, ZipWriter *zip);
+
+    bool beginSheetData();
+    bool finishSheet();
+    bool savePackage();
+    bool writeRow(int column, const QVariantList &values, const Format &format);
+    void writeCell(int column, const QVariant &value, const Format &format);
+    bool flush(bool force);
+
+    StreamWriter *q_ptr;
+    Document document; // workbook, styles and the empty sheet objects
+    std::unique_ptr<ZipWriter> zipWriter;
+
+    Worksheet *sheet;   // sheet being streamed, nullptr before the first addSheet()
+    int sheetNumber;    // n of xl/worksheets/sheet<n>.xml
+    int row;            // last row written to the current sheet
+    bool sheetDataOpen; // head written, rows may follow
+    bool closed;
+    bool failed;
+
+    QBuffer buffer; // serialized rows not yet handed to zipWriter
+    std::unique_ptr<QXmlStreamWriter> writer;
+};
+
+QT_END_NAMESPACE_XLSX
+
+#endif // XLSXSTREAMWRITER_P_H
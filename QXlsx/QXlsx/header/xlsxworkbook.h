@@ -78,6 +78,9 @@ private:
     friend class WorksheetPrivate;
     friend class Document;
     friend class DocumentPrivate;
+    friend class StreamReaderPrivate;
+    friend class StreamWriterPrivate;
+    friend class CellTable;
 
     Workbook(Workbook::CreateFlag flag);
 
@@ -9,8 +9,11 @@
 #include "xlsxtheme_p.h"
 #include "xlsxworkbook.h"
 
+#include <QSet>
 #include <QStringList>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE_XLSX
 
 struct XlsxDefineNameData {
@@ -41,6 +44,9 @@ class WorkbookPrivate : public AbstractOOXmlFilePrivate
 public:
     WorkbookPrivate(Workbook *q, Workbook::CreateFlag flag);
 
+    void loadSheet(AbstractSheet *sheet);
+    void loadPendingSheets();
+
     std::shared_ptr<SharedStrings> sharedStrings;
     QList<std::shared_ptr<AbstractSheet>> sheets;
     QList<std::shared_ptr<SimpleOOXmlFile>> externalLinks;
@@ -51,6 +57,11 @@ public:
     QList<std::shared_ptr<Chart>> chartFiles;
     QList<XlsxDefineNameData> definedNamesList;
 
+    // Sheets of a document loaded with Document::LoadOnDemand that are not
+    // read yet, and the function that reads one of them
+    QSet<const AbstractSheet *> pendingSheets;
+    std::function<void(AbstractSheet *)> sheetLoader;
+
     bool strings_to_numbers_enabled;
     bool strings_to_hyperlinks_enabled;
     bool html_to_richstring_enabled;
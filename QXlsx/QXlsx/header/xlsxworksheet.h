@@ -41,6 +41,7 @@ class QXLSX_EXPORT Worksheet : public AbstractSheet
 
 private:
     friend class DocumentPrivate;
+    friend class StreamWriterPrivate;
     friend class Workbook;
     friend class ::WorksheetTest;
     Worksheet(const QString &sheetName, int sheetId, Workbook *book, CreateFlag flag);
@@ -6,6 +6,7 @@
 #include "xlsxabstractsheet_p.h"
 #include "xlsxcell.h"
 #include "xlsxcellformula.h"
+#include "xlsxcelltable_p.h"
 #include "xlsxconditionalformatting.h"
 #include "xlsxdatavalidation.h"
 #include "xlsxworksheet.h"
@@ -132,56 +133,6 @@ struct XlsxColumnInfo {
     bool collapsed;
 };
 
-class CellTable
-{
-public:
-    static QList<int> sorteIntList(QList<int> &&keys)
-    {
-        std::sort(keys.begin(), keys.end());
-        return keys;
-    }
-
-    inline QList<int> sortedRows() const
-    {
-        QList<int> keys = cells.keys();
-        std::sort(keys.begin(), keys.end());
-        return keys;
-    }
-
-    void setValue(int row, int column, const std::shared_ptr<Cell> &cell)
-    {
-        cells[row].insert(column, cell);
-        firstRow    = qMin(firstRow, row);
-        firstColumn = qMin(firstColumn, column);
-        lastRow     = qMin(lastRow, row);
-        lastColumn  = qMin(lastColumn, column);
-    }
-
-    std::shared_ptr<Cell> cellAt(int row, int column) const
-    {
-        return cells.value(row).value(column);
-    }
-
-    bool contains(int row, int column) const
-    {
-        auto it = cells.find(row);
-        if (it != cells.end()) {
-            return it->contains(column);
-        }
-        return false;
-    }
-
-    bool isEmpty() const { return cells.isEmpty(); }
-
-    // It's faster with a single QHash, but in Qt5 it's capacity limits
-    // how much cells we can hold
-    QHash<int, QHash<int, std::shared_ptr<Cell>>> cells;
-    int firstRow    = -1;
-    int firstColumn = -1;
-    int lastRow     = -1;
-    int lastColumn  = -1;
-};
-
 class WorksheetPrivate : public AbstractSheetPrivate
 {
     Q_DECLARE_PUBLIC(Worksheet)
@@ -197,12 +148,20 @@ public:
     void calculateSpans() const;
     void splitColsInfo(int colFirst, int colLast);
     void validateDimension();
+    void commitSharedStringRefs();
 
+    void saveXmlHead(QXmlStreamWriter &writer, bool withDimension = true) const;
     void saveXmlSheetData(QXmlStreamWriter &writer) const;
+    void saveXmlTail(QXmlStreamWriter &writer) const;
     void saveXmlCellData(QXmlStreamWriter &writer,
                          int row,
                          int col,
                          std::shared_ptr<Cell> cell) const;
+    void saveXmlSlotData(QXmlStreamWriter &writer,
+                         int row,
+                         int col,
+                         const CellTable::Slot &slot) const;
+    void saveXmlCellStyle(QXmlStreamWriter &writer, int row, int col, int xfIndex) const;
     void saveXmlMergeCells(QXmlStreamWriter &writer) const;
     void saveXmlHyperlinks(QXmlStreamWriter &writer) const;
     void saveXmlDrawings(QXmlStreamWriter &writer) const;
@@ -240,6 +199,7 @@ public:
     QList<ConditionalFormatting> conditionalFormattingList;
 
     QHash<int, CellFormula> sharedFormulaMap; // shared formula map
+    QVector<int> sharedStringRefs;            // uses per index while loading
 
     CellRange dimension;
 
@@ -5,15 +5,27 @@
 
 #include "xlsxglobal.h"
 
+#include <QByteArray>
+#include <QHash>
 #include <QIODevice>
-#include <QScopedPointer>
 #include <QStringList>
 #include <QVector>
 
-class QZipReader;
+#include <memory>
+
+class QFile;
 
 QT_BEGIN_NAMESPACE_XLSX
 
+/*
+ * Reads a zip archive from one contiguous block of memory: the file mapped
+ * into memory, the data of a QBuffer, or a copy of any other device. A
+ * device given to the reader must stay open while the reader is used. The
+ * central directory is indexed by path when the archive is opened.
+ *
+ * All const members only read that block, so they can be called from
+ * several threads at once.
+ */
 class ZipReader
 {
 public:
@@ -22,13 +34,35 @@ public:
     ~ZipReader();
     bool exists() const;
     QStringList filePaths() const;
+    bool contains(const QString &fileName) const;
     QByteArray fileData(const QString &fileName) const;
 
+    // Reads the entry as it is inflated; stored entries are read straight
+    // from the archive. The device must not outlive the reader.
+    std::unique_ptr<QIODevice> openFile(const QString &fileName) const;
+
 private:
     Q_DISABLE_COPY(ZipReader)
+
+    struct Entry
+    {
+        quint16 method           = 0;
+        quint64 compressedSize   = 0;
+        quint64 uncompressedSize = 0;
+        quint64 headerOffset     = 0;
+    };
+
     void init();
-    QScopedPointer<QZipReader> m_reader;
+    bool readCentralDirectory();
+    const char *entryData(const Entry &entry) const;
+
+    std::unique_ptr<QFile> m_file; // set when the reader opened the file itself
+    QByteArray m_copy;             // archive read from a device that cannot be mapped
+    const char *m_data;
+    qint64 m_size;
+    bool m_valid;
     QStringList m_filePaths;
+    QHash<QString, Entry> m_entries;
 };
 
 QT_END_NAMESPACE_XLSX
@@ -5,27 +5,91 @@
 
 #include "xlsxglobal.h"
 
+#include <QByteArray>
 #include <QIODevice>
 #include <QString>
+#include <QVector>
 
-class QZipWriter;
+#include <memory>
 
 QT_BEGIN_NAMESPACE_XLSX
 
+/*
+ * Writes a zip archive. Compression levels are zlib's: 0 stores the entry,
+ * 1 (fastest) to 9 (smallest) deflate it and -1 is zlib's default. ZIP64
+ * records are written for entries, offsets and archives past the classic
+ * limits of 4 GiB and 65535 entries.
+ */
 class ZipWriter
 {
 public:
+    enum { DefaultLevel = -1 };
+
+    // An entry compressed ahead of time by deflatePart(), which only touches
+    // its arguments and can run on any thread
+    struct Part
+    {
+        QString filePath;
+        QByteArray payload;
+        quint32 crc              = 0;
+        quint64 uncompressedSize = 0;
+        quint16 method           = 0;
+    };
+
     explicit ZipWriter(const QString &filePath);
     explicit ZipWriter(QIODevice *device);
     ~ZipWriter();
 
+    static Part deflatePart(const QString &filePath, const QByteArray &data,
+                            int level = DefaultLevel);
+
     void addFile(const QString &filePath, QIODevice *device);
     void addFile(const QString &filePath, const QByteArray &data);
+    void addPart(const Part &part);
+
+    // Streamed entry: data is deflated as it is written and the CRC and
+    // sizes follow in a data descriptor, so nothing is buffered. The sizes
+    // are not known up front, so the entry is always written as ZIP64, with
+    // 8-byte sizes in the descriptor. Only one entry can be open at a time;
+    // addFile() must not be called meanwhile.
+    bool openFile(const QString &filePath, int level = DefaultLevel);
+    bool writeData(const char *data, qint64 size);
+    bool closeFile();
+
     bool error() const;
     void close();
 
 private:
-    QZipWriter *m_writer;
+    Q_DISABLE_COPY(ZipWriter)
+
+    struct Entry
+    {
+        QByteArray name;
+        quint16 flags            = 0;
+        quint16 method           = 0;
+        quint32 crc              = 0;
+        quint64 compressedSize   = 0;
+        quint64 uncompressedSize = 0;
+        quint64 offset           = 0;
+        bool zip64               = false; // local header has the ZIP64 extra field
+    };
+    struct Deflater;
+
+    void init();
+    bool writeBytes(const char *data, qint64 size);
+    bool writeLocalHeader(const Entry &entry);
+    void writeEndOfCentralDirectory(quint64 directoryOffset, quint64 directorySize);
+    bool deflateChunk(const char *data, qint64 size, int flush);
+
+    QIODevice *m_device;
+    bool m_ownsDevice;
+    bool m_error;
+    quint64 m_offset;
+    quint16 m_dosTime;
+    quint16 m_dosDate;
+    QVector<Entry> m_entries;
+    Entry m_current;
+    std::unique_ptr<Deflater> m_deflater; // set while a streamed entry is open
 };
 
 QT_END_NAMESPACE_XLSX
@@ -0,0 +1,259 @@
+// xlsxcelltable.cpp
+
+#include "xlsxcelltable_p.h"
+
+#include "xlsxcell_p.h"
+#include "xlsxrichstring.h"
+#include "xlsxsharedstrings_p.h"
+#include "xlsxstyles_p.h"
+#include "xlsxworkbook.h"
+#include "xlsxworksheet_p.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE_XLSX
+
+CellTable::CellTable(const WorksheetPrivate *sheet)
+    : sheet(sheet)
+{
+}
+
+/*!
+ * \internal
+ * Returns the slot of (\a row, \a column), creating it, and the run and the
+ * row around it, if needed.
+ */
+CellTable::Slot *CellTable::slotAt(int row, int column)
+{
+    const int chunk = (row - 1) / ChunkRows;
+    if (chunks.size() <= chunk)
+        chunks.resize(chunk + 1);
+    if (chunks[chunk].isEmpty())
+        chunks[chunk].resize(ChunkRows);
+    Row &runs = chunks[chunk][(row - 1) % ChunkRows];
+
+    // First run that reaches column when extended by at most MaxGap slots
+    const int i = int(std::lower_bound(runs.constBegin(), runs.constEnd(), column,
+                                       [](const Run &run, int c) {
+                                           return run.lastColumn() + MaxGap + 1 < c;
+                                       }) -
+                      runs.constBegin());
+    if (i == runs.size() || runs[i].firstColumn - MaxGap - 1 > column) {
+        Run run;
+        run.firstColumn = column;
+        run.slots.resize(1);
+        runs.insert(i, run);
+        return runs[i].slots.data();
+    }
+
+    Run &run = runs[i];
+    if (column < run.firstColumn) {
+        run.slots.insert(0, run.firstColumn - column, Slot());
+        run.firstColumn = column;
+    } else if (column > run.lastColumn()) {
+        run.slots.resize(column - run.firstColumn + 1);
+
+        // The run may now be close enough to the next one to join it
+        if (i + 1 < runs.size() && runs[i + 1].firstColumn - run.lastColumn() - 1 <= MaxGap) {
+            run.slots.resize(runs[i + 1].firstColumn - run.firstColumn);
+            run.slots += runs[i + 1].slots;
+            runs.remove(i + 1);
+        }
+    }
+    return runs[i].slots.data() + (column - runs[i].firstColumn);
+}
+
+const CellTable::Slot *CellTable::findSlot(int row, int column) const
+{
+    const Row *runs = this->row(row);
+    if (!runs)
+        return nullptr;
+
+    auto it = std::lower_bound(runs->begin(), runs->end(), column,
+                               [](const Run &run, int c) { return run.lastColumn() < c; });
+    if (it == runs->end() || it->firstColumn > column)
+        return nullptr;
+    const Slot *slot = it->slots.constData() + (column - it->firstColumn);
+    return slot->type == EmptySlot ? nullptr : slot;
+}
+
+const CellTable::Row *CellTable::row(int row) const
+{
+    const int chunk = (row - 1) / ChunkRows;
+    if (row < 1 || chunk >= chunks.size() || chunks[chunk].isEmpty())
+        return nullptr;
+    const Row &runs = chunks[chunk][(row - 1) % ChunkRows];
+    return runs.isEmpty() ? nullptr : &runs;
+}
+
+void CellTable::store(int row, int column, const Slot &slot)
+{
+    Q_ASSERT_X(row >= 1 && column >= 1, "CellTable::store", "rows and columns start from 1");
+    Slot *target = slotAt(row, column);
+    if (target->type == CellSlot) {
+        objects[target->index].reset();
+        freeObjects.append(target->index);
+    } else if (target->type == EmptySlot) {
+        ++count;
+    }
+    *target = slot;
+
+    if (count == 1 && firstRow < 0) {
+        firstRow = lastRow = row;
+        firstColumn = lastColumn = column;
+    } else {
+        firstRow    = qMin(firstRow, row);
+        firstColumn = qMin(firstColumn, column);
+        lastRow     = qMax(lastRow, row);
+        lastColumn  = qMax(lastColumn, column);
+    }
+}
+
+/*!
+ * \internal
+ * Stores \a cell at (\a row, \a column), reduced to a plain slot when nothing
+ * but its value, type and registered format has to be kept.
+ */
+void CellTable::setValue(int row, int column, const std::shared_ptr<Cell> &cell)
+{
+    const CellPrivate *d = cell->d_ptr;
+    const Format &format = d->format;
+    const int valueType  = d->value.userType();
+    const bool numeric   = valueType == QMetaType::Double || valueType == QMetaType::Int ||
+                         valueType == QMetaType::UInt || valueType == QMetaType::LongLong ||
+                         valueType == QMetaType::ULongLong || valueType == QMetaType::Float;
+
+    Slot slot;
+    if (!d->formula.isValid() && (format.isEmpty() || format.xfIndexValid())) {
+        slot.style = format.isEmpty() ? -1 : format.xfIndex();
+        switch (d->cellType) {
+        case Cell::NumberType:
+            if (!d->value.isValid()) {
+                slot.type = BlankSlot;
+            } else if (numeric) {
+                slot.type   = NumberSlot;
+                slot.number = d->value.toDouble();
+            }
+            break;
+        case Cell::DateType:
+            if (numeric) {
+                slot.type   = DateSlot;
+                slot.number = d->value.toDouble();
+            }
+            break;
+        case Cell::BooleanType:
+            if (valueType == QMetaType::Bool) {
+                slot.type    = BoolSlot;
+                slot.boolean = d->value.toBool();
+            }
+            break;
+        case Cell::SharedStringType:
+            if (!d->richString.isRichString()) {
+                slot.index = sheet->sharedStrings()->getSharedStringIndex(d->value.toString());
+                if (slot.index >= 0)
+                    slot.type = StringSlot;
+            }
+            break;
+        case Cell::CustomType:
+            // Only if the text comes back unchanged from the number
+            if (valueType == QMetaType::QString) {
+                const QString text = d->value.toString();
+                bool ok;
+                slot.number = text.toDouble(&ok);
+                if (ok && QString::number(slot.number, 'g', 15) == text)
+                    slot.type = CustomSlot;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (slot.type == EmptySlot) {
+        slot.style = -1;
+        slot.type  = CellSlot;
+        if (freeObjects.isEmpty()) {
+            slot.index = objects.size();
+            objects.append(cell);
+        } else {
+            slot.index          = freeObjects.takeLast();
+            objects[slot.index] = cell;
+        }
+    }
+    store(row, column, slot);
+}
+
+/*!
+ * \internal
+ * Stores a plain \a slot, as read from another table. CellSlot is not
+ * accepted here.
+ */
+void CellTable::setSlot(int row, int column, const Slot &slot)
+{
+    Q_ASSERT(slot.type != CellSlot);
+    store(row, column, slot);
+}
+
+/*!
+ * \internal
+ * Stores the shared string \a index with \a format without going through a
+ * Cell; used by the loader, which knows the index already.
+ */
+void CellTable::setSharedString(int row, int column, int index, const Format &format)
+{
+    Slot slot;
+    slot.type  = StringSlot;
+    slot.index = index;
+    slot.style = format.isEmpty() ? -1 : format.xfIndex();
+    store(row, column, slot);
+}
+
+/*!
+ * \internal
+ * Returns the Cell of \a slot: the stored object, or a new Cell built from
+ * a plain slot.
+ */
+std::shared_ptr<Cell> CellTable::cellOf(const Slot &slot) const
+{
+    if (slot.type == CellSlot)
+        return objects[slot.index];
+
+    Worksheet *parent  = static_cast<Worksheet *>(sheet->q_ptr);
+    const Format format = slot.style >= 0 ? sheet->workbook->styles()->xfFormat(slot.style)
+                                          : Format();
+    switch (slot.type) {
+    case NumberSlot:
+        return std::make_shared<Cell>(slot.number, Cell::NumberType, format, parent, slot.style);
+    case DateSlot:
+        return std::make_shared<Cell>(slot.number, Cell::DateType, format, parent, slot.style);
+    case BoolSlot:
+        return std::make_shared<Cell>(slot.boolean, Cell::BooleanType, format, parent, slot.style);
+    case StringSlot: {
+        const RichString text = sheet->sharedStrings()->getSharedString(slot.index);
+        auto cell = std::make_shared<Cell>(text.toPlainString(), Cell::SharedStringType, format,
+                                           parent, slot.style);
+        cell->d_ptr->richString = text;
+        return cell;
+    }
+    case BlankSlot:
+        return std::make_shared<Cell>(QVariant(), Cell::NumberType, format, parent, slot.style);
+    case CustomSlot:
+        return std::make_shared<Cell>(QString::number(slot.number, 'g', 15), Cell::CustomType,
+                                      format, parent, slot.style);
+    default:
+        return std::shared_ptr<Cell>();
+    }
+}
+
+std::shared_ptr<Cell> CellTable::cellAt(int row, int column) const
+{
+    const Slot *slot = findSlot(row, column);
+    return slot ? cellOf(*slot) : std::shared_ptr<Cell>();
+}
+
+bool CellTable::contains(int row, int column) const
+{
+    return findSlot(row, column) != nullptr;
+}
+
+QT_END_NAMESPACE_XLSX
@@ -17,6 +17,7 @@
 #include "xlsxworkbook.h"
 #include "xlsxworkbook_p.h"
 #include "xlsxworksheet.h"
+#include "xlsxworksheet_p.h"
 #include "xlsxzipreader_p.h"
 #include "xlsxzipwriter_p.h"
 
@@ -26,6 +27,10 @@
 #include <QFile>
 #include <QPointF>
 #include <QTemporaryFile>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <functional>
 
 /*
         From Wikipedia: The Open Packaging Conventions (OPC) is a
@@ -148,12 +153,31 @@ std::string copyTag(const std::string &sFrom, const std::string &sTo, const std:
 
     return sOut;
 }
+
+// Parses the entry \a path of \a zipReader into \a part while it is inflated
+template <typename Part>
+bool loadPart(Part *part, const ZipReader &zipReader, const QString &path)
+{
+    const std::unique_ptr<QIODevice> device = zipReader.openFile(path);
+    return device ? part->loadFromXmlFile(device.get()) : part->loadFromXmlData(QByteArray());
+}
+
+// Parses \a part, and its relationships when the package has them
+template <typename Part>
+bool loadPartWithRels(Part *part, const ZipReader &zipReader)
+{
+    const QString relPath = getRelFilePath(part->filePath());
+    if (zipReader.contains(relPath))
+        loadPart(part->relationships(), zipReader, relPath);
+    return loadPart(part, zipReader, part->filePath());
+}
 } // namespace xlsxDocumentCpp
 
 DocumentPrivate::DocumentPrivate(Document *p)
     : q_ptr(p)
     , defaultPackageName(QStringLiteral("Book1.xlsx"))
     , isLoad(false)
+    , compression(Document::CompressionDefault)
 {
 }
 
@@ -168,21 +192,106 @@ void DocumentPrivate::init()
 
 bool DocumentPrivate::loadPackage(QIODevice *device)
 {
-    Q_Q(Document);
     ZipReader zipReader(device);
-    QStringList filePaths = zipReader.filePaths();
+    return loadPackage(zipReader, true);
+}
+
+/*!
+ * \internal
+ * Loads the workbook, styles, shared strings and relationships of the
+ * package. A sheet is read, with its drawing and charts, when it is first
+ * used; \a zipReader is kept for that and for the media files, which are
+ * read when their contents are needed.
+ */
+bool DocumentPrivate::loadPackageOnDemand(const std::shared_ptr<ZipReader> &zipReader)
+{
+    if (!loadPackage(*zipReader, false))
+        return false;
+
+    WorkbookPrivate *workbook_d = workbook->d_func();
+    for (const auto &sheet : qAsConst(workbook_d->sheets))
+        workbook_d->pendingSheets.insert(sheet.get());
+    workbook_d->sheetLoader = [zipReader](AbstractSheet *sheet) {
+        loadSheetOnDemand(sheet, zipReader);
+    };
+    return true;
+}
+
+/*!
+ * \internal
+ * Reads \a sheet of a package loaded on demand, then the drawing of the
+ * sheet and the charts and media files it brings in.
+ */
+void DocumentPrivate::loadSheetOnDemand(AbstractSheet *sheet,
+                                        const std::shared_ptr<ZipReader> &zipReader)
+{
+    using xlsxDocumentCpp::loadPart;
+    using xlsxDocumentCpp::loadPartWithRels;
+
+    loadPartWithRels(sheet, *zipReader);
+    if (sheet->sheetType() == AbstractSheet::ST_WorkSheet)
+        static_cast<Worksheet *>(sheet)->d_func()->commitSharedStringRefs();
+
+    Drawing *drawing = sheet->drawing();
+    if (!drawing)
+        return;
+
+    // The anchors of the drawing append the charts and media files it uses,
+    // unless another sheet already brought them in
+    Workbook *workbook   = sheet->workbook();
+    const int chartCount = workbook->chartFiles().size();
+    const int mediaCount = workbook->mediaFiles().size();
+    loadPartWithRels(drawing, *zipReader);
+
+    const auto charts = workbook->chartFiles().mid(chartCount);
+    for (const auto &chart : charts)
+        loadPart(chart.get(), *zipReader, chart->filePath());
+
+    const auto mediaFiles = workbook->mediaFiles().mid(mediaCount);
+    for (const auto &mf : mediaFiles) {
+        const QString path   = mf->fileName();
+        const QString suffix = path.mid(path.lastIndexOf(QLatin1Char('.')) + 1);
+        mf->setLoader([zipReader, path]() { return zipReader->fileData(path); }, suffix);
+    }
+}
+
+/*!
+ * \internal
+ * Reads whatever a package loaded on demand still holds back, the pending
+ * sheets and the media contents, and lets go of the package. The package
+ * file may be the one about to be written, so this comes before it is
+ * opened for writing.
+ */
+void DocumentPrivate::releasePackage() const
+{
+    WorkbookPrivate *workbook_d = workbook->d_func();
+    workbook_d->loadPendingSheets();
+    for (const auto &mf : qAsConst(workbook_d->mediaFiles))
+        mf->contents(); // drops the loader, and the package with it
+}
+
+/*!
+ * \internal
+ * Loads the package parts from \a zipReader. Without \a loadSheets the
+ * workbook only lists its sheets and their contents are left unread, for
+ * StreamReader to walk row by row or for loadPackageOnDemand().
+ */
+bool DocumentPrivate::loadPackage(ZipReader &zipReader, bool loadSheets)
+{
+    Q_Q(Document);
+    using xlsxDocumentCpp::loadPart;
 
     // Load the Content_Types file
-    if (!filePaths.contains(QLatin1String("[Content_Types].xml")))
+    if (!zipReader.contains(QLatin1String("[Content_Types].xml")))
         return false;
     contentTypes = std::make_shared<ContentTypes>(ContentTypes::F_LoadFromExists);
-    contentTypes->loadFromXmlData(zipReader.fileData(QStringLiteral("[Content_Types].xml")));
+    loadPart(contentTypes.get(), zipReader, QStringLiteral("[Content_Types].xml"));
 
     // Load root rels file
-    if (!filePaths.contains(QLatin1String("_rels/.rels")))
+    if (!zipReader.contains(QLatin1String("_rels/.rels")))
         return false;
     Relationships rootRels;
-    rootRels.loadFromXmlData(zipReader.fileData(QStringLiteral("_rels/.rels")));
+    loadPart(&rootRels, zipReader, QStringLiteral("_rels/.rels"));
 
     // load core property
     QList<XlsxRelationship> rels_core =
@@ -193,7 +302,7 @@ bool DocumentPrivate::loadPackage(QIODevice *device)
         QString docPropsCore_Name = rels_core[0].target;
 
         DocPropsCore props(DocPropsCore::F_LoadFromExists);
-        props.loadFromXmlData(zipReader.fileData(docPropsCore_Name));
+        loadPart(&props, zipReader, docPropsCore_Name);
         const auto propNames = props.propertyNames();
         for (const QString &name : propNames)
             q->setDocumentProperty(name, props.property(name));
@@ -208,7 +317,7 @@ bool DocumentPrivate::loadPackage(QIODevice *device)
         QString docPropsApp_Name = rels_app[0].target;
 
         DocPropsApp props(DocPropsApp::F_LoadFromExists);
-        props.loadFromXmlData(zipReader.fileData(docPropsApp_Name));
+        loadPart(&props, zipReader, docPropsApp_Name);
         const auto propNames = props.propertyNames();
         for (const QString &name : propNames)
             q->setDocumentProperty(name, props.property(name));
@@ -226,9 +335,9 @@ bool DocumentPrivate::loadPackage(QIODevice *device)
     const QString xlworkbook_Dir  = parts.first();
     const QString relFilePath     = getRelFilePath(xlworkbook_Path);
 
-    workbook->relationships()->loadFromXmlData(zipReader.fileData(relFilePath));
+    loadPart(workbook->relationships(), zipReader, relFilePath);
     workbook->setFilePath(xlworkbook_Path);
-    workbook->loadFromXmlData(zipReader.fileData(xlworkbook_Path));
+    loadPart<AbstractOOXmlFile>(workbook.get(), zipReader, xlworkbook_Path);
 
     // load styles
     QList<XlsxRelationship> rels_styles =
@@ -247,7 +356,7 @@ bool DocumentPrivate::loadPackage(QIODevice *device)
         }
 
         std::shared_ptr<Styles> styles(new Styles(Styles::F_LoadFromExists));
-        styles->loadFromXmlData(zipReader.fileData(path));
+        loadPart(styles.get(), zipReader, path);
         workbook->d_func()->styles = styles;
     }
 
@@ -258,7 +367,7 @@ bool DocumentPrivate::loadPackage(QIODevice *device)
         // In normal case this should be sharedStrings.xml which in xl
         QString name = rels_sharedStrings[0].target;
         QString path = xlworkbook_Dir + QLatin1String("/") + name;
-        workbook->d_func()->sharedStrings->loadFromXmlData(zipReader.fileData(path));
+        loadPart(workbook->d_func()->sharedStrings.get(), zipReader, path);
     }
 
     // load theme
@@ -268,45 +377,47 @@ bool DocumentPrivate::loadPackage(QIODevice *device)
         // In normal case this should be theme/theme1.xml which in xl
         QString name = rels_theme[0].target;
         QString path = xlworkbook_Dir + QLatin1String("/") + name;
-        workbook->theme()->loadFromXmlData(zipReader.fileData(path));
+        loadPart(workbook->theme(), zipReader, path);
     }
 
+    // Sheets and charts only depend on what is loaded above, so they are
+    // parsed on the thread pool. The zip reader can be shared: every part
+    // is inflated by the thread that parses it.
+
     // load sheets
-    for (int i = 0; i < workbook->sheetCount(); ++i) {
-        AbstractSheet *sheet = workbook->sheet(i);
-        QString strFilePath  = sheet->filePath();
-        QString rel_path     = getRelFilePath(strFilePath);
-        // If the .rel file exists, load it.
-        if (zipReader.filePaths().contains(rel_path))
-            sheet->relationships()->loadFromXmlData(zipReader.fileData(rel_path));
-        sheet->loadFromXmlData(zipReader.fileData(sheet->filePath()));
+    if (loadSheets) {
+        QList<AbstractSheet *> sheets;
+        for (int i = 0; i < workbook->sheetCount(); ++i)
+            sheets.append(workbook->sheet(i));
+
+        QtConcurrent::blockingMap(sheets, [&zipReader](AbstractSheet *sheet) {
+            xlsxDocumentCpp::loadPartWithRels(sheet, zipReader);
+        });
+
+        // Worksheets count their shared string uses while loading; add them
+        // once nothing else touches the shared strings
+        for (AbstractSheet *sheet : qAsConst(sheets)) {
+            if (sheet->sheetType() == AbstractSheet::ST_WorkSheet)
+                static_cast<Worksheet *>(sheet)->d_func()->commitSharedStringRefs();
+        }
     }
 
     // load external links
     for (int i = 0; i < workbook->d_func()->externalLinks.count(); ++i) {
         SimpleOOXmlFile *link = workbook->d_func()->externalLinks[i].get();
-        QString rel_path      = getRelFilePath(link->filePath());
-        // If the .rel file exists, load it.
-        if (zipReader.filePaths().contains(rel_path))
-            link->relationships()->loadFromXmlData(zipReader.fileData(rel_path));
-        link->loadFromXmlData(zipReader.fileData(link->filePath()));
+        xlsxDocumentCpp::loadPartWithRels(link, zipReader);
     }
 
-    // load drawings
+    // load drawings, in order: their anchors number the media and chart files
     for (int i = 0; i < workbook->drawings().size(); ++i) {
-        Drawing *drawing = workbook->drawings()[i];
-        QString rel_path = getRelFilePath(drawing->filePath());
-        if (zipReader.filePaths().contains(rel_path))
-            drawing->relationships()->loadFromXmlData(zipReader.fileData(rel_path));
-        drawing->loadFromXmlData(zipReader.fileData(drawing->filePath()));
+        xlsxDocumentCpp::loadPartWithRels(workbook->drawings()[i], zipReader);
     }
 
     // load charts
     QList<std::shared_ptr<Chart>> chartFileToLoad = workbook->chartFiles();
-    for (int i = 0; i < chartFileToLoad.size(); ++i) {
-        std::shared_ptr<Chart> cf = chartFileToLoad[i];
-        cf->loadFromXmlData(zipReader.fileData(cf->filePath()));
-    }
+    QtConcurrent::blockingMap(chartFileToLoad, [&zipReader](std::shared_ptr<Chart> &cf) {
+        loadPart(cf.get(), zipReader, cf->filePath());
+    });
 
     // load media files
     const auto mediaFileToLoad = workbook->mediaFiles();
@@ -320,19 +431,88 @@ bool DocumentPrivate::loadPackage(QIODevice *device)
     return true;
 }
 
-bool DocumentPrivate::savePackage(QIODevice *device) const
+/*!
+ * \internal
+ * Returns the zlib level of the part \a filePath: the compression of the last
+ * matching part pattern, or the one of the document.
+ */
+int DocumentPrivate::compressionLevel(const QString &filePath) const
 {
-    Q_Q(const Document);
+    Document::Compression level = compression;
+    for (const auto &part : partCompressions) {
+        if (QDir::match(part.first, filePath))
+            level = part.second;
+    }
 
+    switch (level) {
+    case Document::CompressionStore:
+        return 0;
+    case Document::CompressionFast:
+        return 1;
+    case Document::CompressionMax:
+        return 9;
+    default:
+        return ZipWriter::DefaultLevel;
+    }
+}
+
+bool DocumentPrivate::savePackage(QIODevice *device) const
+{
     ZipWriter zipWriter(device);
     if (zipWriter.error())
         return false;
 
+    return savePackage(zipWriter, false);
+}
+
+/*!
+ * \internal
+ * Writes all parts of the package into \a zipWriter and closes it. When
+ * \a worksheetsStreamed is set the worksheet parts (and their relationships)
+ * have already been written by a StreamWriter and are only registered here.
+ */
+bool DocumentPrivate::savePackage(ZipWriter &zipWriter, bool worksheetsStreamed) const
+{
+    Q_Q(const Document);
+
+    // What a document loaded on demand has not read yet is written as read
+    releasePackage();
+
     contentTypes->clearOverrides();
 
     DocPropsApp docPropsApp(DocPropsApp::F_NewFromScratch);
     DocPropsCore docPropsCore(DocPropsCore::F_NewFromScratch);
 
+    // Parts are rendered and deflated on the thread pool and written below in
+    // the order they were queued, so the package does not depend on
+    // scheduling. A task renders a part together with the relationships the
+    // part fills while being saved.
+    typedef QList<ZipWriter::Part> Parts;
+    QList<QFuture<Parts>> queued;
+    auto render = [&queued](std::function<Parts()> task) {
+        queued.append(QtConcurrent::run(task));
+    };
+    // Parts rendered here, on this thread: only deflated on the pool
+    auto add = [this, &render](const QString &filePath, const QByteArray &data) {
+        const int level = compressionLevel(filePath);
+        render([filePath, data, level]() {
+            return Parts() << ZipWriter::deflatePart(filePath, data, level);
+        });
+    };
+    auto renderWithRels = [this, &render](const QString &filePath, const QString &relsPath,
+                                          const AbstractOOXmlFile *file) {
+        const int level     = compressionLevel(filePath);
+        const int relsLevel = compressionLevel(relsPath);
+        render([filePath, relsPath, file, level, relsLevel]() {
+            Parts parts;
+            parts << ZipWriter::deflatePart(filePath, file->saveToXmlData(), level);
+            Relationships *rel = file->relationships();
+            if (!rel->isEmpty())
+                parts << ZipWriter::deflatePart(relsPath, rel->saveToXmlData(), relsLevel);
+            return parts;
+        });
+    };
+
     // save worksheet xml files
     QList<std::shared_ptr<AbstractSheet>> worksheets =
         workbook->getSheetsByTypes(AbstractSheet::ST_WorkSheet);
@@ -343,14 +523,12 @@ bool DocumentPrivate::savePackage(QIODevice *device) const
         std::shared_ptr<AbstractSheet> sheet = worksheets[i];
         contentTypes->addWorksheetName(QStringLiteral("sheet%1").arg(i + 1));
         docPropsApp.addPartTitle(sheet->sheetName());
+        if (worksheetsStreamed)
+            continue;
 
-        zipWriter.addFile(QStringLiteral("xl/worksheets/sheet%1.xml").arg(i + 1),
-                          sheet->saveToXmlData());
-
-        Relationships *rel = sheet->relationships();
-        if (!rel->isEmpty())
-            zipWriter.addFile(QStringLiteral("xl/worksheets/_rels/sheet%1.xml.rels").arg(i + 1),
-                              rel->saveToXmlData());
+        renderWithRels(QStringLiteral("xl/worksheets/sheet%1.xml").arg(i + 1),
+                       QStringLiteral("xl/worksheets/_rels/sheet%1.xml.rels").arg(i + 1),
+                       sheet.get());
     }
 
     // save chartsheet xml files
@@ -363,12 +541,9 @@ bool DocumentPrivate::savePackage(QIODevice *device) const
         contentTypes->addWorksheetName(QStringLiteral("sheet%1").arg(i + 1));
         docPropsApp.addPartTitle(sheet->sheetName());
 
-        zipWriter.addFile(QStringLiteral("xl/chartsheets/sheet%1.xml").arg(i + 1),
-                          sheet->saveToXmlData());
-        Relationships *rel = sheet->relationships();
-        if (!rel->isEmpty())
-            zipWriter.addFile(QStringLiteral("xl/chartsheets/_rels/sheet%1.xml.rels").arg(i + 1),
-                              rel->saveToXmlData());
+        renderWithRels(QStringLiteral("xl/chartsheets/sheet%1.xml").arg(i + 1),
+                       QStringLiteral("xl/chartsheets/_rels/sheet%1.xml.rels").arg(i + 1),
+                       sheet.get());
     }
 
     // save external links xml files
@@ -376,31 +551,23 @@ bool DocumentPrivate::savePackage(QIODevice *device) const
         SimpleOOXmlFile *link = workbook->d_func()->externalLinks[i].get();
         contentTypes->addExternalLinkName(QStringLiteral("externalLink%1").arg(i + 1));
 
-        zipWriter.addFile(QStringLiteral("xl/externalLinks/externalLink%1.xml").arg(i + 1),
-                          link->saveToXmlData());
-        Relationships *rel = link->relationships();
-        if (!rel->isEmpty())
-            zipWriter.addFile(
-                QStringLiteral("xl/externalLinks/_rels/externalLink%1.xml.rels").arg(i + 1),
-                rel->saveToXmlData());
+        renderWithRels(QStringLiteral("xl/externalLinks/externalLink%1.xml").arg(i + 1),
+                       QStringLiteral("xl/externalLinks/_rels/externalLink%1.xml.rels").arg(i + 1),
+                       link);
     }
 
     // save workbook xml file
     contentTypes->addWorkbook();
-    zipWriter.addFile(QStringLiteral("xl/workbook.xml"), workbook->saveToXmlData());
-    zipWriter.addFile(QStringLiteral("xl/_rels/workbook.xml.rels"),
-                      workbook->relationships()->saveToXmlData());
+    add(QStringLiteral("xl/workbook.xml"), workbook->saveToXmlData());
+    add(QStringLiteral("xl/_rels/workbook.xml.rels"), workbook->relationships()->saveToXmlData());
 
     // save drawing xml files
     for (int i = 0; i < workbook->drawings().size(); ++i) {
         contentTypes->addDrawingName(QStringLiteral("drawing%1").arg(i + 1));
 
-        Drawing *drawing = workbook->drawings()[i];
-        zipWriter.addFile(QStringLiteral("xl/drawings/drawing%1.xml").arg(i + 1),
-                          drawing->saveToXmlData());
-        if (!drawing->relationships()->isEmpty())
-            zipWriter.addFile(QStringLiteral("xl/drawings/_rels/drawing%1.xml.rels").arg(i + 1),
-                              drawing->relationships()->saveToXmlData());
+        renderWithRels(QStringLiteral("xl/drawings/drawing%1.xml").arg(i + 1),
+                       QStringLiteral("xl/drawings/_rels/drawing%1.xml.rels").arg(i + 1),
+                       workbook->drawings()[i]);
     }
 
     // save docProps app/core xml file
@@ -411,33 +578,42 @@ bool DocumentPrivate::savePackage(QIODevice *device) const
     }
     contentTypes->addDocPropApp();
     contentTypes->addDocPropCore();
-    zipWriter.addFile(QStringLiteral("docProps/app.xml"), docPropsApp.saveToXmlData());
-    zipWriter.addFile(QStringLiteral("docProps/core.xml"), docPropsCore.saveToXmlData());
+    add(QStringLiteral("docProps/app.xml"), docPropsApp.saveToXmlData());
+    add(QStringLiteral("docProps/core.xml"), docPropsCore.saveToXmlData());
 
     // save sharedStrings xml file
     if (!workbook->sharedStrings()->isEmpty()) {
         contentTypes->addSharedString();
-        zipWriter.addFile(QStringLiteral("xl/sharedStrings.xml"),
-                          workbook->sharedStrings()->saveToXmlData());
+        const SharedStrings *sharedStrings = workbook->sharedStrings();
+        const QString filePath             = QStringLiteral("xl/sharedStrings.xml");
+        const int level                    = compressionLevel(filePath);
+        render([sharedStrings, filePath, level]() {
+            return Parts() << ZipWriter::deflatePart(filePath, sharedStrings->saveToXmlData(),
+                                                     level);
+        });
     }
 
     // save calc chain [dev16]
     contentTypes->addCalcChain();
-    zipWriter.addFile(QStringLiteral("xl/calcChain.xml"), workbook->styles()->saveToXmlData());
+    add(QStringLiteral("xl/calcChain.xml"), workbook->styles()->saveToXmlData());
 
     // save styles xml file
     contentTypes->addStyles();
-    zipWriter.addFile(QStringLiteral("xl/styles.xml"), workbook->styles()->saveToXmlData());
+    add(QStringLiteral("xl/styles.xml"), workbook->styles()->saveToXmlData());
 
     // save theme xml file
     contentTypes->addTheme();
-    zipWriter.addFile(QStringLiteral("xl/theme/theme1.xml"), workbook->theme()->saveToXmlData());
+    add(QStringLiteral("xl/theme/theme1.xml"), workbook->theme()->saveToXmlData());
 
     // save chart xml files
     for (int i = 0; i < workbook->chartFiles().size(); ++i) {
         contentTypes->addChartName(QStringLiteral("chart%1").arg(i + 1));
         std::shared_ptr<Chart> cf = workbook->chartFiles()[i];
-        zipWriter.addFile(QStringLiteral("xl/charts/chart%1.xml").arg(i + 1), cf->saveToXmlData());
+        const QString filePath    = QStringLiteral("xl/charts/chart%1.xml").arg(i + 1);
+        const int level           = compressionLevel(filePath);
+        render([filePath, cf, level]() {
+            return Parts() << ZipWriter::deflatePart(filePath, cf->saveToXmlData(), level);
+        });
     }
 
     // save image files
@@ -447,8 +623,7 @@ bool DocumentPrivate::savePackage(QIODevice *device) const
         if (!mf->mimeType().isEmpty())
             contentTypes->addDefault(mf->suffix(), mf->mimeType());
 
-        zipWriter.addFile(QStringLiteral("xl/media/image%1.%2").arg(i + 1).arg(mf->suffix()),
-                          mf->contents());
+        add(QStringLiteral("xl/media/image%1.%2").arg(i + 1).arg(mf->suffix()), mf->contents());
     }
 
     // save root .rels xml file
@@ -459,13 +634,19 @@ bool DocumentPrivate::savePackage(QIODevice *device) const
                                     QStringLiteral("docProps/core.xml"));
     rootrels.addDocumentRelationship(QStringLiteral("/extended-properties"),
                                      QStringLiteral("docProps/app.xml"));
-    zipWriter.addFile(QStringLiteral("_rels/.rels"), rootrels.saveToXmlData());
+    add(QStringLiteral("_rels/.rels"), rootrels.saveToXmlData());
 
     // save content types xml file
-    zipWriter.addFile(QStringLiteral("[Content_Types].xml"), contentTypes->saveToXmlData());
+    add(QStringLiteral("[Content_Types].xml"), contentTypes->saveToXmlData());
+
+    for (QFuture<Parts> &future : queued) {
+        const Parts parts = future.result();
+        for (const ZipWriter::Part &part : parts)
+            zipWriter.addPart(part);
+    }
 
     zipWriter.close();
-    return true;
+    return !zipWriter.error();
 }
 
 //
@@ -665,17 +846,39 @@ Document::Document(QObject *parent)
  * The \a parent argument is passed to QObject's constructor.
  */
 Document::Document(const QString &name, QObject *parent)
+    : Document(name, LoadEverything, parent)
+{
+}
+
+/*!
+ * \overload
+ * Try to open an existing xlsx document named \a name.
+ * With LoadOnDemand only the workbook, its styles, shared strings and
+ * relationships are read here. A sheet is read, with its drawing and charts,
+ * the first time it is used. The file stays mapped until the document is
+ * saved or destroyed, since images are read from it when first needed.
+ * Saving reads whatever is left first, so the document can be saved over
+ * its own file.
+ * The \a parent argument is passed to QObject's constructor.
+ */
+Document::Document(const QString &name, LoadMode mode, QObject *parent)
     : QObject(parent)
     , d_ptr(new DocumentPrivate(this))
 {
     d_ptr->packageName = name;
 
     if (QFile::exists(name)) {
-        QFile xlsx(name);
-        if (xlsx.open(QFile::ReadOnly)) {
-            if (!d_ptr->loadPackage(&xlsx)) {
+        if (mode == LoadOnDemand) {
+            if (!d_ptr->loadPackageOnDemand(std::make_shared<ZipReader>(name))) {
                 // NOTICE: failed to load package
             }
+        } else {
+            QFile xlsx(name);
+            if (xlsx.open(QFile::ReadOnly)) {
+                if (!d_ptr->loadPackage(&xlsx)) {
+                    // NOTICE: failed to load package
+                }
+            }
         }
     }
 
@@ -688,11 +891,27 @@ Document::Document(const QString &name, QObject *parent)
  * The \a parent argument is passed to QObject's constructor.
  */
 Document::Document(QIODevice *device, QObject *parent)
+    : Document(device, LoadEverything, parent)
+{
+}
+
+/*!
+ * \overload
+ * Try to open an existing xlsx document from \a device, reading its sheets
+ * as \a mode tells. With LoadOnDemand the \a device must stay open until
+ * the document is saved or destroyed: sheets and images are read from it
+ * when first used. It must not be the device the document is saved to.
+ * The \a parent argument is passed to QObject's constructor.
+ */
+Document::Document(QIODevice *device, LoadMode mode, QObject *parent)
     : QObject(parent)
     , d_ptr(new DocumentPrivate(this))
 {
     if (device && device->isReadable()) {
-        if (!d_ptr->loadPackage(device)) {
+        const bool loaded = mode == LoadOnDemand
+                                ? d_ptr->loadPackageOnDemand(std::make_shared<ZipReader>(device))
+                                : d_ptr->loadPackage(device);
+        if (!loaded) {
             // NOTICE: failed to load package
         }
     }
@@ -1353,6 +1572,12 @@ bool Document::save() const
  */
 bool Document::saveAs(const QString &name) const
 {
+    Q_D(const Document);
+
+    // A document loaded on demand may be saved over its own file: everything
+    // still in the package is read before the file is truncated
+    d->releasePackage();
+
     QFile file(name);
     if (file.open(QIODevice::WriteOnly))
         return saveAs(&file);
@@ -1378,6 +1603,44 @@ bool Document::saveAsCsv(const QString mainCSVFileName) const
     return d->saveCsv(mainCSVFileName);
 }
 
+/*!
+ * Returns the compression used for the parts of the package when saving.
+ * The default is CompressionDefault.
+ */
+Document::Compression Document::compression() const
+{
+    Q_D(const Document);
+    return d->compression;
+}
+
+/*!
+ * Sets the \a compression used for the parts of the package when saving.
+ * CompressionFast trades a larger file for a much shorter save.
+ */
+void Document::setCompression(Compression compression)
+{
+    Q_D(Document);
+    d->compression = compression;
+}
+
+/*!
+ * Uses \a compression instead of compression() for the parts whose path in
+ * the package matches the wildcard \a filePattern, for example
+ * CompressionStore for "xl/media/*", whose images are compressed already.
+ * When several patterns match a part the one set last wins.
+ */
+void Document::setPartCompression(const QString &filePattern, Compression compression)
+{
+    Q_D(Document);
+    for (int i = 0; i < d->partCompressions.size(); ++i) {
+        if (d->partCompressions[i].first == filePattern) {
+            d->partCompressions.removeAt(i);
+            break;
+        }
+    }
+    d->partCompressions.append(qMakePair(filePattern, compression));
+}
+
 bool Document::isLoadPackage() const
 {
     Q_D(const Document);
@@ -30,6 +30,31 @@ void MediaFile::set(const QByteArray &bytes, const QString &suffix, const QStrin
     m_mimeType   = mimeType;
     m_hashKey    = QCryptographicHash::hash(m_contents, QCryptographicHash::Md5);
     m_indexValid = false;
+    m_loader     = nullptr;
+}
+
+/*!
+ * \internal
+ * Sets the function that reads the contents. It is called, once, when the
+ * contents or their hash key are first asked for.
+ */
+void MediaFile::setLoader(const std::function<QByteArray()> &loader, const QString &suffix)
+{
+    m_contents.clear();
+    m_hashKey.clear();
+    m_suffix = suffix;
+    m_loader = loader;
+}
+
+void MediaFile::load() const
+{
+    if (!m_loader)
+        return;
+
+    auto self        = const_cast<MediaFile *>(this);
+    self->m_contents = m_loader();
+    self->m_hashKey  = QCryptographicHash::hash(m_contents, QCryptographicHash::Md5);
+    self->m_loader   = nullptr;
 }
 
 void MediaFile::setFileName(const QString &name)
@@ -54,6 +79,7 @@ QString MediaFile::mimeType() const
 
 QByteArray MediaFile::contents() const
 {
+    load();
     return m_contents;
 }
 
@@ -75,6 +101,7 @@ void MediaFile::setIndex(int idx)
 
 QByteArray MediaFile::hashKey() const
 {
+    load();
     return m_hashKey;
 }
 
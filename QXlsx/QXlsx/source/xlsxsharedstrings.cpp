@@ -13,6 +13,9 @@
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
+#include <cctype>
+#include <cstring>
+
 QT_BEGIN_NAMESPACE_XLSX
 
 /*
@@ -25,6 +28,7 @@ QT_BEGIN_NAMESPACE_XLSX
 
 SharedStrings::SharedStrings(CreateFlag flag)
     : AbstractOOXmlFile(flag)
+    , m_lazy(0)
 {
     m_stringCount = 0;
 }
@@ -34,6 +38,11 @@ int SharedStrings::count() const
     return m_stringCount;
 }
 
+int SharedStrings::uniqueCount() const
+{
+    return m_stringList.size();
+}
+
 bool SharedStrings::isEmpty() const
 {
     return m_stringList.isEmpty();
@@ -41,33 +50,74 @@ bool SharedStrings::isEmpty() const
 
 int SharedStrings::addSharedString(const QString &string)
 {
-    return addSharedString(RichString(string));
+    ensureTables();
+    m_stringCount += 1;
+
+    // A single lookup whether the string is new or not
+    const int size             = m_stringTable.size();
+    XlsxSharedStringInfo &info = m_stringTable[string];
+    if (m_stringTable.size() == size) {
+        info.count += 1;
+        return info.index;
+    }
+
+    info.index = m_stringList.size();
+    m_stringList.append(string);
+    return info.index;
 }
 
 int SharedStrings::addSharedString(const RichString &string)
 {
+    if (!string.isRichString())
+        return addSharedString(string.toPlainString());
+
+    ensureTables();
     m_stringCount += 1;
 
-    auto it = m_stringTable.find(string);
-    if (it != m_stringTable.end()) {
+    auto it = m_richStringTable.find(string);
+    if (it != m_richStringTable.end()) {
         it->count += 1;
         return it->index;
     }
 
-    int index             = m_stringList.size();
-    m_stringTable[string] = XlsxSharedStringInfo(index);
-    m_stringList.append(string);
+    int index                 = m_stringList.size();
+    m_richStringTable[string] = XlsxSharedStringInfo(index);
+    m_richStrings.insert(index, string);
+    m_stringList.append(string.toPlainString());
     return index;
 }
 
-void SharedStrings::incRefByStringIndex(int idx)
+void SharedStrings::incRefByStringIndex(int idx, int count)
 {
     if (idx < 0 || idx >= m_stringList.size()) {
         qDebug("SharedStrings: invalid index");
         return;
     }
 
-    addSharedString(m_stringList[idx]);
+    m_stringCount += count;
+    if (m_lazy.loadAcquire()) {
+        // Counted without decoding; ensureTables() adds them to the tables
+        if (m_pendingRefs.isEmpty())
+            m_pendingRefs.resize(m_stringList.size());
+        m_pendingRefs[idx] += count;
+        return;
+    }
+    addStringRefs(idx, count);
+}
+
+void SharedStrings::addStringRefs(int idx, int count)
+{
+    auto rich = m_richStrings.constFind(idx);
+    if (rich != m_richStrings.constEnd()) {
+        auto it = m_richStringTable.find(*rich);
+        if (it != m_richStringTable.end())
+            it->count += count;
+        return;
+    }
+
+    auto it = m_stringTable.find(m_stringList[idx]);
+    if (it != m_stringTable.end())
+        it->count += count;
 }
 
 /*
@@ -75,7 +125,20 @@ void SharedStrings::incRefByStringIndex(int idx)
  */
 void SharedStrings::removeSharedString(const QString &string)
 {
-    removeSharedString(RichString(string));
+    ensureTables();
+    auto it = m_stringTable.find(string);
+    if (it == m_stringTable.end())
+        return;
+
+    m_stringCount -= 1;
+
+    it->count -= 1;
+
+    if (it->count <= 0) {
+        const int index = it->index;
+        m_stringTable.erase(it);
+        removeStringAt(index);
+    }
 }
 
 /*
@@ -83,8 +146,14 @@ void SharedStrings::removeSharedString(const QString &string)
  */
 void SharedStrings::removeSharedString(const RichString &string)
 {
-    auto it = m_stringTable.find(string);
-    if (it == m_stringTable.end())
+    if (!string.isRichString()) {
+        removeSharedString(string.toPlainString());
+        return;
+    }
+
+    ensureTables();
+    auto it = m_richStringTable.find(string);
+    if (it == m_richStringTable.end())
         return;
 
     m_stringCount -= 1;
@@ -92,37 +161,102 @@ void SharedStrings::removeSharedString(const RichString &string)
     it->count -= 1;
 
     if (it->count <= 0) {
-        for (int i = it->index + 1; i < m_stringList.size(); ++i)
-            m_stringTable[m_stringList[i]].index -= 1;
+        const int index = it->index;
+        m_richStringTable.erase(it);
+        removeStringAt(index);
+    }
+}
 
-        m_stringList.removeAt(it->index);
-        m_stringTable.remove(string);
+// Removes the string at index; the strings after it move down by one
+void SharedStrings::removeStringAt(int index)
+{
+    m_stringList.removeAt(index);
+    for (auto it = m_stringTable.begin(); it != m_stringTable.end(); ++it) {
+        if (it->index > index)
+            it->index -= 1;
+    }
+    for (auto it = m_richStringTable.begin(); it != m_richStringTable.end(); ++it) {
+        if (it->index > index)
+            it->index -= 1;
     }
+
+    QHash<int, RichString> richStrings;
+    for (auto it = m_richStrings.constBegin(); it != m_richStrings.constEnd(); ++it) {
+        if (it.key() != index)
+            richStrings.insert(it.key() > index ? it.key() - 1 : it.key(), it.value());
+    }
+    m_richStrings = richStrings;
 }
 
 int SharedStrings::getSharedStringIndex(const QString &string) const
 {
-    return getSharedStringIndex(RichString(string));
+    ensureTables();
+    auto it = m_stringTable.constFind(string);
+    if (it != m_stringTable.constEnd())
+        return it->index;
+    return -1;
 }
 
 int SharedStrings::getSharedStringIndex(const RichString &string) const
 {
-    auto it = m_stringTable.constFind(string);
-    if (it != m_stringTable.constEnd())
+    if (!string.isRichString())
+        return getSharedStringIndex(string.toPlainString());
+
+    ensureTables();
+    auto it = m_richStringTable.constFind(string);
+    if (it != m_richStringTable.constEnd())
         return it->index;
     return -1;
 }
 
 RichString SharedStrings::getSharedString(int index) const
 {
-    if (index < m_stringList.count() && index >= 0)
-        return m_stringList[index];
-    return RichString();
+    if (index < 0 || index >= m_stringList.count())
+        return RichString();
+
+    QMutexLocker locker(m_lazy.loadAcquire() ? &m_mutex : nullptr);
+    decodeString(index);
+    auto rich = m_richStrings.constFind(index);
+    if (rich != m_richStrings.constEnd())
+        return *rich;
+    return RichString(m_stringList[index]);
+}
+
+/*!
+ * \internal
+ * Returns the text of the string at \a index without building a RichString.
+ */
+QString SharedStrings::getSharedPlainString(int index) const
+{
+    if (index < 0 || index >= m_stringList.count())
+        return QString();
+
+    QMutexLocker locker(m_lazy.loadAcquire() ? &m_mutex : nullptr);
+    decodeString(index);
+    return m_stringList[index];
+}
+
+bool SharedStrings::isRichString(int index) const
+{
+    if (m_lazy.loadAcquire()) {
+        // Most strings are known to be plain without being decoded
+        if (index < 0 || index >= m_mayBeRich.size() || !m_mayBeRich.testBit(index))
+            return false;
+        QMutexLocker locker(&m_mutex);
+        decodeString(index);
+        return m_richStrings.contains(index);
+    }
+    return m_richStrings.contains(index);
 }
 
 QList<RichString> SharedStrings::getSharedStrings() const
 {
-    return m_stringList;
+    ensureTables();
+    QList<RichString> strings;
+    strings.reserve(m_stringList.size());
+    for (int i = 0; i < m_stringList.size(); ++i)
+        strings.append(getSharedString(i));
+    return strings;
 }
 
 void SharedStrings::writeRichStringPart_rPr(QXmlStreamWriter &writer, const Format &format) const
@@ -192,9 +326,10 @@ void SharedStrings::writeRichStringPart_rPr(QXmlStreamWriter &writer, const Form
 
 void SharedStrings::saveToXmlFile(QIODevice *device) const
 {
+    ensureTables();
     QXmlStreamWriter writer(device);
 
-    if (m_stringList.size() != m_stringTable.size()) {
+    if (m_stringList.size() != m_stringTable.size() + m_richStringTable.size()) {
         // Duplicated string items exist in m_stringList
         // Clean up can not be done here, as the indices
         // have been used when we save the worksheets part.
@@ -208,9 +343,11 @@ void SharedStrings::saveToXmlFile(QIODevice *device) const
     writer.writeAttribute(QStringLiteral("count"), QString::number(m_stringCount));
     writer.writeAttribute(QStringLiteral("uniqueCount"), QString::number(m_stringList.size()));
 
-    for (const RichString &string : m_stringList) {
+    for (int index = 0; index < m_stringList.size(); ++index) {
         writer.writeStartElement(QStringLiteral("si"));
-        if (string.isRichString()) {
+        auto rich = m_richStrings.constFind(index);
+        if (rich != m_richStrings.constEnd()) {
+            const RichString &string = *rich;
             // Rich text string
             for (int i = 0; i < string.fragmentCount(); ++i) {
                 writer.writeStartElement(QStringLiteral("r"));
@@ -229,7 +366,7 @@ void SharedStrings::saveToXmlFile(QIODevice *device) const
             }
         } else {
             writer.writeStartElement(QStringLiteral("t"));
-            QString pString = string.toPlainString();
+            const QString &pString = m_stringList[index];
             if (isSpaceReserveNeeded(pString))
                 writer.writeAttribute(QStringLiteral("xml:space"), QStringLiteral("preserve"));
             writer.writeCharacters(pString);
@@ -242,7 +379,7 @@ void SharedStrings::saveToXmlFile(QIODevice *device) const
     writer.writeEndDocument();
 }
 
-void SharedStrings::readString(QXmlStreamReader &reader)
+RichString SharedStrings::readString(QXmlStreamReader &reader) const
 {
     Q_ASSERT(reader.name() == QLatin1String("si"));
 
@@ -258,13 +395,25 @@ void SharedStrings::readString(QXmlStreamReader &reader)
                 readPlainStringPart(reader, richString);
         }
     }
+    return richString;
+}
 
-    int idx                   = m_stringList.size();
-    m_stringTable[richString] = XlsxSharedStringInfo(idx, 0);
-    m_stringList.append(richString);
+// Appends a string read from the part; its uses are counted by the sheets
+void SharedStrings::appendString(const RichString &string)
+{
+    int idx = m_stringList.size();
+    if (string.isRichString()) {
+        m_richStringTable[string] = XlsxSharedStringInfo(idx, 0);
+        m_richStrings.insert(idx, string);
+        m_stringList.append(string.toPlainString());
+    } else {
+        const QString text  = string.toPlainString();
+        m_stringTable[text] = XlsxSharedStringInfo(idx, 0);
+        m_stringList.append(text);
+    }
 }
 
-void SharedStrings::readRichStringPart(QXmlStreamReader &reader, RichString &richString)
+void SharedStrings::readRichStringPart(QXmlStreamReader &reader, RichString &richString) const
 {
     Q_ASSERT(reader.name() == QLatin1String("r"));
 
@@ -284,7 +433,7 @@ void SharedStrings::readRichStringPart(QXmlStreamReader &reader, RichString &ric
     richString.addFragment(text, format);
 }
 
-void SharedStrings::readPlainStringPart(QXmlStreamReader &reader, RichString &richString)
+void SharedStrings::readPlainStringPart(QXmlStreamReader &reader, RichString &richString) const
 {
     Q_ASSERT(reader.name() == QLatin1String("t"));
 
@@ -295,7 +444,7 @@ void SharedStrings::readPlainStringPart(QXmlStreamReader &reader, RichString &ri
     richString.addFragment(text, Format());
 }
 
-Format SharedStrings::readRichStringPart_rPr(QXmlStreamReader &reader)
+Format SharedStrings::readRichStringPart_rPr(QXmlStreamReader &reader) const
 {
     Q_ASSERT(reader.name() == QLatin1String("rPr"));
     Format format;
@@ -359,9 +508,143 @@ Format SharedStrings::readRichStringPart_rPr(QXmlStreamReader &reader)
     return format;
 }
 
+/*!
+ * \internal
+ * Records where every \<si\> of the part \a data starts, without decoding
+ * any of them, and switches to the lazy mode. Returns false, leaving the
+ * part to be parsed as a whole, when it cannot be cut into \<si\> elements
+ * by looking at the bytes: not UTF-8, with comments, CDATA sections or
+ * prefixed elements.
+ */
+bool SharedStrings::indexStrings(const QByteArray &data)
+{
+    if (!m_stringList.isEmpty() || data.startsWith("\xff\xfe") || data.startsWith("\xfe\xff"))
+        return false;
+
+    const int sst = data.indexOf("<sst");
+    if (sst < 0)
+        return false;
+    const QByteArray prolog = data.left(sst).toLower();
+    const int encoding      = prolog.indexOf("encoding=");
+    if (encoding >= 0 && prolog.mid(encoding + 10, 5) != "utf-8")
+        return false;
+
+    const char *const begin = data.constData();
+    const char *const end   = begin + data.size();
+    QVector<int> offsets;
+    QVector<int> richStrings;
+    int last = -1;
+    for (const char *p = begin + sst + 4; p < end; ++p) {
+        p = static_cast<const char *>(memchr(p, '<', size_t(end - p)));
+        if (!p)
+            break;
+
+        const char *name = p + 1;
+        auto isTag       = [name, end](const char *tag, int length) {
+            return end - name > length && memcmp(name, tag, size_t(length)) == 0 &&
+                   (name[length] == '>' || name[length] == '/' || isspace(uchar(name[length])));
+        };
+        if (*name == '!' || *name == '?')
+            return false;
+        if (isTag("si", 2)) {
+            offsets.append(int(p - begin));
+        } else if (isTag("r", 1)) {
+            const int current = offsets.size() - 1;
+            if (current >= 0 && (richStrings.isEmpty() || richStrings.last() != current))
+                richStrings.append(current);
+        } else if (isTag("/sst", 4)) {
+            last = int(p - begin);
+            break;
+        } else if (*name != '/') {
+            // Any other element is only expected inside a <si>, unprefixed
+            const char *n = name;
+            while (n < end && *n != '>' && *n != '/' && !isspace(uchar(*n)) && *n != ':')
+                ++n;
+            if (n < end && *n == ':')
+                return false;
+        }
+    }
+    if (last < 0)
+        return false;
+    offsets.append(last);
+
+    const int count = offsets.size() - 1;
+    m_xmlData       = data;
+    m_offsets       = offsets;
+    m_decoded       = QBitArray(count);
+    m_mayBeRich     = QBitArray(count);
+    for (int index : qAsConst(richStrings))
+        m_mayBeRich.setBit(index);
+    m_stringList.reserve(count);
+    for (int i = 0; i < count; ++i)
+        m_stringList.append(QString());
+    m_lazy.storeRelease(1);
+    return true;
+}
+
+/*!
+ * \internal
+ * Decodes the string at \a index if the lazy mode has not done it yet. The
+ * caller holds m_mutex while the lazy mode is on.
+ */
+void SharedStrings::decodeString(int index) const
+{
+    if (m_decoded.isEmpty() || m_decoded.testBit(index))
+        return;
+
+    const int from = m_offsets[index];
+    QXmlStreamReader reader(
+        QByteArray::fromRawData(m_xmlData.constData() + from, m_offsets[index + 1] - from));
+    reader.readNextStartElement();
+    const RichString string = readString(reader);
+
+    auto self = const_cast<SharedStrings *>(this);
+    if (string.isRichString())
+        self->m_richStrings.insert(index, string);
+    self->m_stringList[index] = string.toPlainString();
+    self->m_decoded.setBit(index);
+}
+
+/*!
+ * \internal
+ * Leaves the lazy mode: decodes the remaining strings, builds the lookup
+ * tables and adds the uses counted meanwhile.
+ */
+void SharedStrings::ensureTables() const
+{
+    if (!m_lazy.loadAcquire())
+        return;
+    QMutexLocker locker(&m_mutex);
+    if (!m_lazy.loadAcquire())
+        return;
+
+    auto self = const_cast<SharedStrings *>(this);
+    for (int i = 0; i < m_stringList.size(); ++i) {
+        decodeString(i);
+        auto rich = m_richStrings.constFind(i);
+        if (rich != m_richStrings.constEnd())
+            self->m_richStringTable[*rich] = XlsxSharedStringInfo(i, 0);
+        else
+            self->m_stringTable[m_stringList[i]] = XlsxSharedStringInfo(i, 0);
+    }
+    for (int i = 0; i < m_pendingRefs.size(); ++i) {
+        if (m_pendingRefs[i] > 0)
+            self->addStringRefs(i, m_pendingRefs[i]);
+    }
+
+    self->m_xmlData.clear();
+    self->m_offsets.clear();
+    self->m_decoded.clear();
+    self->m_pendingRefs.clear();
+    self->m_lazy.storeRelease(0);
+}
+
 bool SharedStrings::loadFromXmlFile(QIODevice *device)
 {
-    QXmlStreamReader reader(device);
+    const QByteArray data = device->readAll();
+    const bool lazy       = indexStrings(data);
+
+    QXmlStreamReader reader(data);
     int count               = 0;
     bool hasUniqueCountAttr = true;
     while (!reader.atEnd()) {
@@ -372,8 +655,10 @@ bool SharedStrings::loadFromXmlFile(QIODevice *device)
                 hasUniqueCountAttr = attributes.hasAttribute(QLatin1String("uniqueCount"));
                 if (hasUniqueCountAttr)
                     count = attributes.value(QLatin1String("uniqueCount")).toInt();
+                if (lazy)
+                    break; // the strings are decoded when used
             } else if (reader.name() == QLatin1String("si")) {
-                readString(reader);
+                appendString(readString(reader));
             }
         }
     }
@@ -383,7 +668,7 @@ bool SharedStrings::loadFromXmlFile(QIODevice *device)
         return false;
     }
 
-    if (m_stringList.size() != m_stringTable.size()) {
+    if (m_stringList.size() != m_stringTable.size() + m_richStringTable.size()) {
         // qDebug("Warning: Duplicated items exist in shared string table.");
         // Nothing we can do here, as indices of the strings will be used when loading sheets.
     }
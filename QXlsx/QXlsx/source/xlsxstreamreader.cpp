@@ -0,0 +1,368 @@
+// xlsxstreamreader.cpp
+
+#include "xlsxstreamreader.h"
+
+#include "xlsxabstractsheet.h"
+#include "xlsxdocument_p.h"
+#include "xlsxrichstring.h"
+#include "xlsxsharedstrings_p.h"
+#include "xlsxstreamreader_p.h"
+#include "xlsxstyles_p.h"
+#include "xlsxutility_p.h"
+#include "xlsxworkbook.h"
+
+#include <QDateTime>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE_XLSX
+
+StreamReaderPrivate::StreamReaderPrivate(StreamReader *p, ZipReader *zip)
+    : q_ptr(p)
+    , zipReader(zip)
+    , valid(false)
+    , inSheetData(false)
+    , row(0)
+{
+}
+
+bool StreamReaderPrivate::fail(const QString &message)
+{
+    error       = message;
+    inSheetData = false;
+    return false;
+}
+
+/*!
+ * \internal
+ * Loads everything but the sheet contents and selects the first worksheet.
+ */
+bool StreamReaderPrivate::load()
+{
+    if (!zipReader->exists() || !document.d_func()->loadPackage(*zipReader, false))
+        return fail(QStringLiteral("Not a valid xlsx package"));
+
+    // One slot per cellXfs entry; s= indexes beyond it are not dates
+    Workbook *workbook = document.workbook();
+    dateStyles.fill(-1, workbook->styles()->xfFormatCount());
+
+    // A broken first sheet is reported by hasError(), the package stays usable
+    for (int i = 0; i < workbook->sheetCount(); ++i) {
+        if (workbook->sheet(i)->sheetType() == AbstractSheet::ST_WorkSheet) {
+            openSheet(i);
+            break;
+        }
+    }
+    return true;
+}
+
+/*!
+ * \internal
+ * Positions the reader just inside \<sheetData\> of the sheet \a index.
+ */
+bool StreamReaderPrivate::openSheet(int index)
+{
+    Workbook *workbook = document.workbook();
+    if (index < 0 || index >= workbook->sheetCount())
+        return fail(QStringLiteral("No sheet at index %1").arg(index));
+    AbstractSheet *sheet = workbook->sheet(index);
+    if (sheet->sheetType() != AbstractSheet::ST_WorkSheet)
+        return fail(QStringLiteral("%1 is not a worksheet").arg(sheet->sheetName()));
+
+    reader.reset();
+    sheetData = zipReader->openFile(sheet->filePath());
+    if (!sheetData)
+        return fail(QStringLiteral("%1 cannot be read").arg(sheet->filePath()));
+    reader.reset(new QXmlStreamReader(sheetData.get()));
+
+    error.clear();
+    row = 0;
+    cells.clear();
+    while (!reader->atEnd()) {
+        if (reader->readNext() == QXmlStreamReader::StartElement &&
+            reader->name() == QLatin1String("sheetData")) {
+            inSheetData = true;
+            return true;
+        }
+    }
+    return fail(reader->hasError() ? reader->errorString()
+                                   : QStringLiteral("%1 has no sheetData").arg(sheet->filePath()));
+}
+
+/*!
+ * \internal
+ * Returns true if the cell format \a styleIndex is a date or time format.
+ * Resolved once per style; an index outside cellXfs is never a date.
+ */
+bool StreamReaderPrivate::isDateStyle(int styleIndex)
+{
+    if (styleIndex < 0 || styleIndex >= dateStyles.size())
+        return false;
+
+    qint8 &known = dateStyles[styleIndex];
+    if (known < 0)
+        known = document.workbook()->styles()->xfFormat(styleIndex).isDateTimeFormat() ? 1 : 0;
+    return known == 1;
+}
+
+QVariant StreamReaderPrivate::cellValue(Cell::CellType type, const QString &text)
+{
+    switch (type) {
+    case Cell::SharedStringType:
+        return document.workbook()->sharedStrings()->getSharedPlainString(text.toInt());
+    case Cell::BooleanType:
+        return text.toInt() != 0;
+    case Cell::DateType: {
+        // serial number under a date format, or an ISO 8601 value of t="d"
+        bool ok;
+        const double number = text.toDouble(&ok);
+        if (ok)
+            return datetimeFromNumber(number, document.workbook()->isDate1904());
+        return QDateTime::fromString(text, Qt::ISODate);
+    }
+    case Cell::InlineStringType:
+    case Cell::StringType:
+    case Cell::ErrorType:
+        return text;
+    default:
+        return text.toDouble();
+    }
+}
+
+/*!
+ * \internal
+ * Decodes the \<c\> element the reader is on and appends it to the row. The
+ * formula, if any, is skipped: its cached result is the value.
+ */
+void StreamReaderPrivate::readCell()
+{
+    const QXmlStreamAttributes attributes = reader->attributes();
+    StreamCell cell;
+
+    // Column letters of "AB12"; r is optional, cells then follow each other
+    const auto ref = attributes.value(QLatin1String("r"));
+    for (int i = 0; i < ref.size() && ref.at(i) >= QLatin1Char('A'); ++i)
+        cell.column = cell.column * 26 + (ref.at(i).toUpper().unicode() - 'A' + 1);
+    if (cell.column <= 0)
+        cell.column = cells.isEmpty() ? 1 : cells.last().column + 1;
+
+    const auto style = attributes.value(QLatin1String("s"));
+    if (!style.isEmpty())
+        cell.styleIndex = style.toInt();
+
+    const auto type = attributes.value(QLatin1String("t"));
+    if (type == QLatin1String("s"))
+        cell.type = Cell::SharedStringType;
+    else if (type == QLatin1String("inlineStr"))
+        cell.type = Cell::InlineStringType;
+    else if (type == QLatin1String("str"))
+        cell.type = Cell::StringType;
+    else if (type == QLatin1String("b"))
+        cell.type = Cell::BooleanType;
+    else if (type == QLatin1String("e"))
+        cell.type = Cell::ErrorType;
+    else if (type == QLatin1String("d") || isDateStyle(cell.styleIndex))
+        cell.type = Cell::DateType;
+
+    QString text;
+    bool hasValue = false;
+    while (reader->readNextStartElement()) {
+        if (reader->name() == QLatin1String("v")) {
+            text     = reader->readElementText();
+            hasValue = true;
+        } else if (reader->name() == QLatin1String("is")) {
+            // Plain text of all runs; phonetic hints are dropped
+            while (reader->readNextStartElement()) {
+                if (reader->name() == QLatin1String("t")) {
+                    text += reader->readElementText();
+                } else if (reader->name() == QLatin1String("r")) {
+                    while (reader->readNextStartElement()) {
+                        if (reader->name() == QLatin1String("t"))
+                            text += reader->readElementText();
+                        else
+                            reader->skipCurrentElement();
+                    }
+                } else {
+                    reader->skipCurrentElement();
+                }
+            }
+            hasValue = true;
+        } else {
+            reader->skipCurrentElement(); // f, extLst
+        }
+    }
+
+    if (hasValue)
+        cell.value = cellValue(cell.type, text);
+    cells.append(cell);
+}
+
+/*!
+  \class StreamReader
+  \inmodule QtXlsx
+  \brief Forward-only reader yielding the rows of a worksheet one at a time.
+
+  Only the workbook, styles and shared strings are loaded up front. The sheet
+  XML is inflated and decoded as readNextRow() advances and only the current
+  row is kept; no Cell objects or CellTable are built, so reading does not
+  wait for the whole sheet and memory does not grow with the number of rows.
+
+  \code
+  StreamReader reader("report.xlsx");
+  while (reader.readNextRow()) {
+      for (const StreamCell &cell : reader.cells())
+          use(reader.row(), cell.column, cell.value);
+  }
+  \endcode
+*/
+
+/*!
+ * Opens the xlsx file \a fileName and selects its first worksheet.
+ */
+StreamReader::StreamReader(const QString &fileName)
+    : d_ptr(new StreamReaderPrivate(this, new ZipReader(fileName)))
+{
+    d_ptr->valid = d_ptr->load();
+}
+
+/*!
+ * Reads the package from \a device and selects its first worksheet.
+ */
+StreamReader::StreamReader(QIODevice *device)
+    : d_ptr(new StreamReaderPrivate(this, new ZipReader(device)))
+{
+    d_ptr->valid = d_ptr->load();
+}
+
+StreamReader::~StreamReader()
+{
+    delete d_ptr;
+}
+
+/*!
+ * Returns true if the package could be opened.
+ */
+bool StreamReader::isValid() const
+{
+    Q_D(const StreamReader);
+    return d->valid;
+}
+
+/*!
+ * Returns the names of all sheets, worksheets or not, in workbook order.
+ */
+QStringList StreamReader::sheetNames() const
+{
+    Q_D(const StreamReader);
+    return d->document.sheetNames();
+}
+
+/*!
+ * Rewinds to the top of the worksheet at \a index. Returns false if there
+ * is no such worksheet.
+ */
+bool StreamReader::selectSheet(int index)
+{
+    Q_D(StreamReader);
+    return d->valid && d->openSheet(index);
+}
+
+/*!
+ * \overload
+ * Rewinds to the top of the worksheet called \a name.
+ */
+bool StreamReader::selectSheet(const QString &name)
+{
+    return selectSheet(sheetNames().indexOf(name));
+}
+
+/*!
+ * Advances to the next row that has an element in the sheet; empty rows are
+ * not reported. Returns false at the end of the sheet or on a parse error.
+ */
+bool StreamReader::readNextRow()
+{
+    Q_D(StreamReader);
+    d->cells.clear();
+    if (!d->inSheetData)
+        return false;
+
+    QXmlStreamReader &reader = *d->reader;
+    while (!reader.atEnd()) {
+        const QXmlStreamReader::TokenType token = reader.readNext();
+        if (token == QXmlStreamReader::StartElement && reader.name() == QLatin1String("row")) {
+            const QXmlStreamAttributes attributes = reader.attributes();
+            const auto r                          = attributes.value(QLatin1String("r"));
+            d->row                                = r.isEmpty() ? d->row + 1 : r.toInt();
+            while (reader.readNextStartElement()) {
+                if (reader.name() == QLatin1String("c"))
+                    d->readCell();
+                else
+                    reader.skipCurrentElement();
+            }
+            if (reader.hasError())
+                return d->fail(reader.errorString());
+            return true;
+        }
+        if (token == QXmlStreamReader::EndElement && reader.name() == QLatin1String("sheetData"))
+            break;
+    }
+
+    d->inSheetData = false;
+    if (reader.hasError())
+        d->fail(reader.errorString());
+    return false;
+}
+
+/*!
+ * Returns the number of the current row, starting at 1.
+ */
+int StreamReader::row() const
+{
+    Q_D(const StreamReader);
+    return d->row;
+}
+
+/*!
+ * Returns the cells of the current row in column order. Columns without an
+ * element in the sheet are absent. The vector is reused by readNextRow().
+ */
+const QVector<StreamCell> &StreamReader::cells() const
+{
+    Q_D(const StreamReader);
+    return d->cells;
+}
+
+/*!
+ * Returns the value of \a column in the current row, or an invalid QVariant
+ * if the cell is empty.
+ */
+QVariant StreamReader::read(int column) const
+{
+    Q_D(const StreamReader);
+    auto it = std::lower_bound(d->cells.constBegin(), d->cells.constEnd(), column,
+                               [](const StreamCell &cell, int c) { return cell.column < c; });
+    if (it == d->cells.constEnd() || it->column != column)
+        return QVariant();
+    return it->value;
+}
+
+/*!
+ * Returns true if the package or the selected sheet could not be read.
+ */
+bool StreamReader::hasError() const
+{
+    Q_D(const StreamReader);
+    return !d->error.isEmpty();
+}
+
+/*!
+ * Returns a description of the last error.
+ */
+QString StreamReader::errorString() const
+{
+    Q_D(const StreamReader);
+    return d->error;
+}
+
+QT_END_NAMESPACE_XLSX
@@ -0,0 +1,363 @@
+// xlsxstreamwriter.cpp
+
+#include "xlsxstreamwriter.h"
+
+#include "xlsxcellreference.h"
+#include "xlsxdocument_p.h"
+#include "xlsxrelationships_p.h"
+#include "xlsxstreamwriter_p.h"
+#include "xlsxstyles_p.h"
+#include "xlsxutility_p.h"
+#include "xlsxworkbook.h"
+#include "xlsxworksheet.h"
+#include "xlsxworksheet_p.h"
+
+#include <QDate>
+#include <QDateTime>
+#include <QTime>
+
+QT_BEGIN_NAMESPACE_XLSX
+
+namespace {
+// Serialized rows are handed to the zip entry once this much is pending
+const qint64 FlushSize = 64 * 1024;
+} // namespace
+
+StreamWriterPrivate::StreamWriterPrivate(StreamWriter *p, ZipWriter *zip)
+    : q_ptr(p)
+    , zipWriter(zip)
+    , sheet(nullptr)
+    , sheetNumber(0)
+    , row(0)
+    , sheetDataOpen(false)
+    , closed(false)
+    , failed(zip->error())
+{
+    buffer.open(QIODevice::WriteOnly);
+}
+
+/*!
+ * \internal
+ * Opens the zip entry of the current sheet and writes everything up to
+ * \<sheetData\>. Delayed until the first row so that column widths and view
+ * options set on currentWorksheet() are still picked up.
+ */
+bool StreamWriterPrivate::beginSheetData()
+{
+    if (sheetDataOpen)
+        return true;
+    const QString filePath = QStringLiteral("xl/worksheets/sheet%1.xml").arg(sheetNumber);
+    if (failed ||
+        !zipWriter->openFile(filePath, document.d_func()->compressionLevel(filePath))) {
+        failed = true;
+        return false;
+    }
+
+    WorksheetPrivate *sheet_d = sheet->d_func();
+    sheet_d->relationships->clear();
+
+    buffer.seek(0);
+    writer.reset(new QXmlStreamWriter(&buffer));
+    sheet_d->saveXmlHead(*writer, false);
+    writer->writeStartElement(QStringLiteral("sheetData"));
+    sheetDataOpen = true;
+    return flush(true);
+}
+
+/*!
+ * \internal
+ * Closes \<sheetData\>, writes the rest of the worksheet and its
+ * relationships. Does nothing if no sheet is open.
+ */
+bool StreamWriterPrivate::finishSheet()
+{
+    if (!sheet)
+        return !failed;
+    if (!beginSheetData())
+        return false;
+
+    writer->writeEndElement(); // sheetData
+    sheet->d_func()->saveXmlTail(*writer);
+    const bool written = flush(true) && zipWriter->closeFile();
+    writer.reset();
+
+    Relationships *rel = sheet->relationships();
+    if (written && !rel->isEmpty()) {
+        const QString relsPath =
+            QStringLiteral("xl/worksheets/_rels/sheet%1.xml.rels").arg(sheetNumber);
+        zipWriter->addPart(ZipWriter::deflatePart(relsPath, rel->saveToXmlData(),
+                                                  document.d_func()->compressionLevel(relsPath)));
+    }
+
+    sheet         = nullptr;
+    sheetDataOpen = false;
+    failed        = failed || !written || zipWriter->error();
+    return !failed;
+}
+
+/*!
+ * \internal
+ * Writes the parts other than the worksheets and closes the package.
+ */
+bool StreamWriterPrivate::savePackage()
+{
+    if (failed) {
+        zipWriter->close();
+        return false;
+    }
+    return document.d_func()->savePackage(*zipWriter, true);
+}
+
+/*!
+ * \internal
+ * Hands the serialized bytes to the zip entry. The buffer is rewound rather
+ * than cleared, so its allocation is reused and stays bounded by the largest
+ * flush.
+ */
+bool StreamWriterPrivate::flush(bool force)
+{
+    const qint64 pending = buffer.pos();
+    if (pending == 0 || (!force && pending < FlushSize))
+        return !failed;
+
+    if (!zipWriter->writeData(buffer.data().constData(), pending))
+        failed = true;
+    buffer.seek(0);
+    return !failed;
+}
+
+/*!
+ * \internal
+ * Serializes \a values as the next \<row\> of the open sheet.
+ */
+bool StreamWriterPrivate::writeRow(int column, const QVariantList &values, const Format &format)
+{
+    WorksheetPrivate *sheet_d = sheet->d_func();
+    if (sheet_d->checkDimensions(row + 1, column) ||
+        sheet_d->checkDimensions(row + 1, column + qMax(values.size(), 1) - 1))
+        return false;
+
+    // Resolved once for the whole row
+    Format fmt = format;
+    if (fmt.isValid())
+        document.workbook()->styles()->addXfFormat(fmt);
+
+    row++;
+    writer->writeStartElement(QStringLiteral("row"));
+    writer->writeAttribute(QStringLiteral("r"), QString::number(row));
+    for (int i = 0; i < values.size(); ++i) {
+        if (!values.at(i).isNull())
+            writeCell(column + i, values.at(i), fmt);
+    }
+    writer->writeEndElement(); // row
+
+    return flush(false);
+}
+
+/*!
+ * \internal
+ * Writes one \<c\> element of the current row. Strings are written inline so
+ * that no shared string table has to be kept until the end. \a format has
+ * already been registered with the workbook's Styles by writeRow().
+ */
+void StreamWriterPrivate::writeCell(int column, const QVariant &value, const Format &format)
+{
+    Workbook *workbook = document.workbook();
+    Format fmt         = format.isValid() ? format : sheet->d_func()->cellFormat(row, column);
+    const int type     = value.userType();
+
+    bool fixedFormat = false;
+    QString cellType;
+    QString number;
+    if (type == QMetaType::QString || type == QMetaType::QByteArray) {
+        cellType = QStringLiteral("inlineStr");
+    } else if (type == QMetaType::Bool) {
+        cellType = QStringLiteral("b");
+        number   = value.toBool() ? QStringLiteral("1") : QStringLiteral("0");
+    } else if (type == QMetaType::QDateTime || type == QMetaType::QDate) {
+        if (!fmt.isValid() || !fmt.isDateTimeFormat()) {
+            fmt.setNumberFormat(workbook->defaultDateFormat());
+            fixedFormat = true;
+        }
+        const QDateTime dt = type == QMetaType::QDate
+                                 ? QDateTime(value.toDate(), QTime(0, 0, 0))
+                                 : value.toDateTime();
+        number = QString::number(datetimeToNumber(dt, workbook->isDate1904()), 'g', 15);
+    } else if (type == QMetaType::QTime) {
+        if (!fmt.isValid() || !fmt.isDateTimeFormat()) {
+            fmt.setNumberFormat(QStringLiteral("hh:mm:ss"));
+            fixedFormat = true;
+        }
+        number = QString::number(timeToNumber(value.toTime()), 'g', 15);
+    } else {
+        bool ok;
+        const double d = value.toDouble(&ok);
+        if (ok)
+            number = QString::number(d, 'g', 15);
+        else
+            cellType = QStringLiteral("inlineStr");
+    }
+
+    writer->writeStartElement(QStringLiteral("c"));
+    writer->writeAttribute(QStringLiteral("r"), CellReference(row, column).toString());
+    if (fixedFormat)
+        workbook->styles()->addXfFormat(fmt);
+    if (!fmt.isEmpty())
+        writer->writeAttribute(QStringLiteral("s"), QString::number(fmt.xfIndex()));
+
+    if (cellType == QLatin1String("inlineStr")) {
+        const QString string = value.toString();
+        writer->writeAttribute(QStringLiteral("t"), cellType);
+        writer->writeStartElement(QStringLiteral("is"));
+        writer->writeStartElement(QStringLiteral("t"));
+        if (isSpaceReserveNeeded(string))
+            writer->writeAttribute(QStringLiteral("xml:space"), QStringLiteral("preserve"));
+        writer->writeCharacters(string);
+        writer->writeEndElement(); // t
+        writer->writeEndElement(); // is
+    } else {
+        if (!cellType.isEmpty())
+            writer->writeAttribute(QStringLiteral("t"), cellType);
+        writer->writeTextElement(QStringLiteral("v"), number);
+    }
+    writer->writeEndElement(); // c
+}
+
+/*!
+  \class StreamWriter
+  \inmodule QtXlsx
+  \brief Write-only xlsx writer whose memory use does not grow with the rows.
+
+  Rows are serialized as they are appended and deflated straight into the
+  worksheet's zip entry, so a sheet is written top to bottom and a row can
+  not be revisited. Cell formats are resolved through the workbook's Styles
+  like Document does; strings are stored inline instead of in the shared
+  string table.
+
+  Sheet-wide settings (column widths, grid lines, ...) are taken from
+  currentWorksheet() when the first row of the sheet is written. Everything
+  but the worksheets (workbook, styles, document properties) is written by
+  close(), from document().
+*/
+
+/*!
+ * Creates a stream writer for the xlsx file \a fileName.
+ */
+StreamWriter::StreamWriter(const QString &fileName)
+    : d_ptr(new StreamWriterPrivate(this, new ZipWriter(fileName)))
+{
+}
+
+/*!
+ * Creates a stream writer writing to \a device. The device is opened
+ * write-only if needed and closed by close().
+ */
+StreamWriter::StreamWriter(QIODevice *device)
+    : d_ptr(new StreamWriterPrivate(this, new ZipWriter(device)))
+{
+}
+
+/*!
+ * Destroys the writer, finishing the package if close() was not called.
+ */
+StreamWriter::~StreamWriter()
+{
+    close();
+    delete d_ptr;
+}
+
+/*!
+ * Finishes the current sheet and starts a worksheet named \a name, which
+ * receives the following rows. Returns false on failure.
+ */
+bool StreamWriter::addSheet(const QString &name)
+{
+    Q_D(StreamWriter);
+    if (d->closed || !d->finishSheet())
+        return false;
+    if (!d->document.addSheet(name))
+        return false;
+
+    d->sheet = d->document.currentWorksheet();
+    d->sheetNumber++;
+    d->row = 0;
+    return true;
+}
+
+/*!
+ * Returns the sheet being written, or nullptr before the first addSheet().
+ * Its cell content is not used: only sheet-wide settings are.
+ */
+Worksheet *StreamWriter::currentWorksheet() const
+{
+    Q_D(const StreamWriter);
+    return d->sheet;
+}
+
+/*!
+ * Returns the document holding the workbook, for document properties and
+ * workbook-wide settings.
+ */
+Document *StreamWriter::document() const
+{
+    Q_D(const StreamWriter);
+    return const_cast<Document *>(&d->document);
+}
+
+/*!
+ * Appends \a values as the next row of the current sheet, starting at the
+ * first column. Null values leave their cell empty. Returns false on failure.
+ */
+bool StreamWriter::writeRow(const QVariantList &values, const Format &format)
+{
+    return writeRow(1, values, format);
+}
+
+/*!
+ * \overload
+ * Appends \a values as the next row, starting at \a column.
+ */
+bool StreamWriter::writeRow(int column, const QVariantList &values, const Format &format)
+{
+    Q_D(StreamWriter);
+    if (d->closed || !d->sheet || !d->beginSheetData())
+        return false;
+
+    return d->writeRow(column, values, format);
+}
+
+/*!
+ * Returns the number of rows written to the current sheet.
+ */
+int StreamWriter::rowCount() const
+{
+    Q_D(const StreamWriter);
+    return d->row;
+}
+
+/*!
+ * Finishes the current sheet, writes the remaining parts of the package and
+ * closes the output. Returns false if anything could not be written.
+ */
+bool StreamWriter::close()
+{
+    Q_D(StreamWriter);
+    if (d->closed)
+        return !d->failed;
+
+    d->closed = true;
+    d->finishSheet();
+    d->failed = !d->savePackage();
+    return !d->failed;
+}
+
+/*!
+ * Returns true if an error occurred while writing.
+ */
+bool StreamWriter::error() const
+{
+    Q_D(const StreamWriter);
+    return d->failed;
+}
+
+QT_END_NAMESPACE_XLSX
@@ -80,6 +80,11 @@ Format Styles::xfFormat(int idx) const
     return m_xf_formatsList[idx];
 }
 
+int Styles::xfFormatCount() const
+{
+    return m_xf_formatsList.size();
+}
+
 Format Styles::dxfFormat(int idx) const
 {
     if (idx < 0 || idx >= m_dxf_formatsList.size())
@@ -49,6 +49,32 @@ WorkbookPrivate::WorkbookPrivate(Workbook *q, Workbook::CreateFlag flag)
     last_sheet_id         = 0;
 }
 
+/*!
+ * \internal
+ * Reads \a sheet if it is still waiting to be loaded on demand.
+ */
+void WorkbookPrivate::loadSheet(AbstractSheet *sheet)
+{
+    if (!pendingSheets.remove(sheet))
+        return;
+
+    sheetLoader(sheet);
+    if (pendingSheets.isEmpty())
+        sheetLoader = nullptr; // the archive is no longer needed by the sheets
+}
+
+/*!
+ * \internal
+ * Reads, in order, every sheet still waiting to be loaded on demand, then
+ * drops the loader.
+ */
+void WorkbookPrivate::loadPendingSheets()
+{
+    for (int i = 0; i < sheets.size() && !pendingSheets.isEmpty(); ++i)
+        loadSheet(sheets[i].get());
+    sheetLoader = nullptr;
+}
+
 Workbook::Workbook(CreateFlag flag)
     : AbstractOOXmlFile(new WorkbookPrivate(this, flag))
 {
@@ -268,7 +294,9 @@ AbstractSheet *Workbook::activeSheet() const
     Q_D(const Workbook);
     if (d->sheets.isEmpty())
         const_cast<Workbook *>(this)->addSheet();
-    return d->sheets[d->activesheetIndex].get();
+    AbstractSheet *sheet = d->sheets[d->activesheetIndex].get();
+    const_cast<WorkbookPrivate *>(d)->loadSheet(sheet);
+    return sheet;
 }
 
 bool Workbook::setActiveSheet(int index)
@@ -313,6 +341,7 @@ bool Workbook::deleteSheet(int index)
         return false;
     if (index < 0 || index >= d->sheets.size())
         return false;
+    d->pendingSheets.remove(d->sheets[index].get());
     d->sheets.removeAt(index);
     d->sheetNames.removeAt(index);
     return true;
@@ -363,6 +392,7 @@ bool Workbook::copySheet(int index, const QString &newName)
     }
 
     ++d->last_sheet_id;
+    d->loadSheet(d->sheets[index].get());
     AbstractSheet *sheet = d->sheets[index]->copy(worksheetName, d->last_sheet_id);
     d->sheets.append(std::shared_ptr<AbstractSheet>(sheet));
     d->sheetNames.append(sheet->sheetName());
@@ -387,7 +417,9 @@ AbstractSheet *Workbook::sheet(int index) const
     Q_D(const Workbook);
     if (index < 0 || index >= d->sheets.size())
         return nullptr;
-    return d->sheets.at(index).get();
+    AbstractSheet *sheet = d->sheets.at(index).get();
+    const_cast<WorkbookPrivate *>(d)->loadSheet(sheet);
+    return sheet;
 }
 
 SharedStrings *Workbook::sharedStrings() const
@@ -50,6 +50,7 @@ const int XLSX_STRING_MAX = 32767;
 
 WorksheetPrivate::WorksheetPrivate(Worksheet *p, Worksheet::CreateFlag flag)
     : AbstractSheetPrivate(p, flag)
+    , cellTable(this)
     , windowProtection(false)
     , showFormulas(false)
     , showGridLines(true)
@@ -81,16 +82,22 @@ void WorksheetPrivate::calculateSpans() const
     int span_max = -1;
 
     for (int row_num = dimension.firstRow(); row_num <= dimension.lastRow(); row_num++) {
-        for (int col_num = dimension.firstColumn(); col_num <= dimension.lastColumn(); col_num++) {
-            if (cellTable.contains(row_num, col_num)) {
-                if (span_max == -1) {
-                    span_min = col_num;
-                    span_max = col_num;
-                } else {
-                    if (col_num < span_min)
+        if (const CellTable::Row *runs = cellTable.row(row_num)) {
+            // Runs are ordered, but their edge slots may have been left empty
+            for (const CellTable::Run &run : *runs) {
+                for (int i = 0; i < run.slots.size(); ++i) {
+                    if (run.slots[i].type == CellTable::EmptySlot)
+                        continue;
+                    const int col_num = run.firstColumn + i;
+                    if (span_max == -1) {
                         span_min = col_num;
-                    else if (col_num > span_max)
                         span_max = col_num;
+                    } else {
+                        if (col_num < span_min)
+                            span_min = col_num;
+                        else if (col_num > span_max)
+                            span_max = col_num;
+                    }
                 }
             }
         }
@@ -192,30 +199,33 @@ Worksheet *Worksheet::copy(const QString &distName, int distId) const
 
     sheet_d->dimension = d->dimension;
 
-    for (auto it = d->cellTable.cells.begin(); it != d->cellTable.cells.end(); ++it) {
-        int row = it.key();
-        for (auto it2 = it.value().begin(); it2 != it.value().end(); ++it2) {
-            int col = it2.key();
+    SharedStrings *sharedStrings = d->workbook->sharedStrings();
+    d->cellTable.forEachRow([&](int row, const CellTable::Row &runs) {
+        for (const CellTable::Run &run : runs) {
+            for (int i = 0; i < run.slots.size(); ++i) {
+                const CellTable::Slot &slot = run.slots[i];
+                const int col               = run.firstColumn + i;
+                if (slot.type == CellTable::EmptySlot)
+                    continue;
+
+                // Plain slots carry no reference to the sheet
+                if (slot.type != CellTable::CellSlot) {
+                    if (slot.type == CellTable::StringSlot)
+                        sharedStrings->incRefByStringIndex(slot.index);
+                    sheet_d->cellTable.setSlot(row, col, slot);
+                    continue;
+                }
 
-            auto cell           = std::make_shared<Cell>(it2.value().get());
-            cell->d_ptr->parent = sheet;
+                auto cell           = std::make_shared<Cell>(d->cellTable.cellOf(slot).get());
+                cell->d_ptr->parent = sheet;
 
-            if (cell->cellType() == Cell::SharedStringType)
-                d->workbook->sharedStrings()->addSharedString(cell->d_ptr->richString);
+                if (cell->cellType() == Cell::SharedStringType)
+                    sharedStrings->addSharedString(cell->d_ptr->richString);
 
-            sheet_d->cellTable.setValue(row, col, cell);
+                sheet_d->cellTable.setValue(row, col, cell);
+            }
         }
-    }
-
-    // for (auto it = d->cellTable.cells.begin(); it != d->cellTable.cells.end(); ++it) {
-    //     auto cell           = std::make_shared<Cell>(it.value().get());
-    //     cell->d_ptr->parent = sheet;
-
-    //     if (cell->cellType() == Cell::SharedStringType)
-    //         d->workbook->sharedStrings()->addSharedString(cell->d_ptr->richString);
-
-    //     sheet_d->cellTable.setValue(CellTable::row(it.key()), CellTable::column(it.key()), cell);
-    // }
+    });
 
     sheet_d->merges = d->merges;
     //    sheet_d->rowsInfo = d->rowsInfo;
@@ -647,13 +657,17 @@ bool Worksheet::writeString(int row, int column, const QString &value, const For
     if (d->checkDimensions(row, column))
         return false;
 
-    RichString rs;
-    if (d->workbook->isHtmlToRichStringEnabled() && Qt::mightBeRichText(value))
+    if (d->workbook->isHtmlToRichStringEnabled() && Qt::mightBeRichText(value)) {
+        RichString rs;
         rs.setHtml(value);
-    else
-        rs.addFragment(value, Format());
+        return writeString(row, column, rs, format);
+    }
 
-    return writeString(row, column, rs, format);
+    // Plain text goes straight into the shared strings and the cell table
+    Format fmt = format.isValid() ? format : d->cellFormat(row, column);
+    d->workbook->styles()->addXfFormat(fmt);
+    d->cellTable.setSharedString(row, column, d->sharedStrings()->addSharedString(value), fmt);
+    return true;
 }
 
 /*!
@@ -783,13 +797,11 @@ bool Worksheet::writeFormula(int row,
         for (int r = range.firstRow(); r <= range.lastRow(); ++r) {
             for (int c = range.firstColumn(); c <= range.lastColumn(); ++c) {
                 if (!(r == row && c == column)) {
-                    if (auto cell = cellAt(r, c)) {
-                        cell->d_ptr->formula = sf;
-                    } else {
-                        auto newCell = std::make_shared<Cell>(result, Cell::NumberType, fmt, this);
-                        newCell->d_ptr->formula = sf;
-                        d->cellTable.setValue(row, column, newCell);
-                    }
+                    auto cell = cellAt(r, c);
+                    if (!cell)
+                        cell = std::make_shared<Cell>(result, Cell::NumberType, fmt, this);
+                    cell->d_ptr->formula = sf;
+                    d->cellTable.setValue(r, c, cell);
                 }
             }
         }
@@ -1224,8 +1236,10 @@ bool Worksheet::mergeCells(const CellRange &range, const Format &format)
             if (row == range.firstRow() && col == range.firstColumn()) {
                 auto cell = cellAt(row, col);
                 if (cell) {
-                    if (format.isValid())
+                    if (format.isValid()) {
                         cell->d_ptr->format = format;
+                        d->cellTable.setValue(row, col, cell);
+                    }
                 } else {
                     writeBlank(row, col, format);
                 }
@@ -1281,6 +1295,24 @@ void Worksheet::saveToXmlFile(QIODevice *device) const
 
     QXmlStreamWriter writer(device);
 
+    d->saveXmlHead(writer);
+
+    writer.writeStartElement(QStringLiteral("sheetData"));
+    if (d->dimension.isValid())
+        d->saveXmlSheetData(writer);
+    writer.writeEndElement(); // sheetData
+
+    d->saveXmlTail(writer);
+}
+
+/*!
+ * \internal
+ * Writes the worksheet up to, but not including, \<sheetData\>. The
+ * dimension is optional in SpreadsheetML and is left out when the rows are
+ * not known yet (streamed sheets).
+ */
+void WorksheetPrivate::saveXmlHead(QXmlStreamWriter &writer, bool withDimension) const
+{
     writer.writeStartDocument(QStringLiteral("1.0"), true);
     writer.writeStartElement(QStringLiteral("worksheet"));
     writer.writeAttribute(
@@ -1297,31 +1329,33 @@ void Worksheet::saveToXmlFile(QIODevice *device) const
     //     "http://schemas.microsoft.com/office/spreadsheetml/2009/9/ac");
     //     writer.writeAttribute("mc:Ignorable", "x14ac");
 
-    writer.writeStartElement(QStringLiteral("dimension"));
-    writer.writeAttribute(QStringLiteral("ref"), d->generateDimensionString());
-    writer.writeEndElement(); // dimension
+    if (withDimension) {
+        writer.writeStartElement(QStringLiteral("dimension"));
+        writer.writeAttribute(QStringLiteral("ref"), generateDimensionString());
+        writer.writeEndElement(); // dimension
+    }
 
     writer.writeStartElement(QStringLiteral("sheetViews"));
     writer.writeStartElement(QStringLiteral("sheetView"));
-    if (d->windowProtection)
+    if (windowProtection)
         writer.writeAttribute(QStringLiteral("windowProtection"), QStringLiteral("1"));
-    if (d->showFormulas)
+    if (showFormulas)
         writer.writeAttribute(QStringLiteral("showFormulas"), QStringLiteral("1"));
-    if (!d->showGridLines)
+    if (!showGridLines)
         writer.writeAttribute(QStringLiteral("showGridLines"), QStringLiteral("0"));
-    if (!d->showRowColHeaders)
+    if (!showRowColHeaders)
         writer.writeAttribute(QStringLiteral("showRowColHeaders"), QStringLiteral("0"));
-    if (!d->showZeros)
+    if (!showZeros)
         writer.writeAttribute(QStringLiteral("showZeros"), QStringLiteral("0"));
-    if (d->rightToLeft)
+    if (rightToLeft)
         writer.writeAttribute(QStringLiteral("rightToLeft"), QStringLiteral("1"));
-    if (d->tabSelected)
+    if (tabSelected)
         writer.writeAttribute(QStringLiteral("tabSelected"), QStringLiteral("1"));
-    if (!d->showRuler)
+    if (!showRuler)
         writer.writeAttribute(QStringLiteral("showRuler"), QStringLiteral("0"));
-    if (!d->showOutlineSymbols)
+    if (!showOutlineSymbols)
         writer.writeAttribute(QStringLiteral("showOutlineSymbols"), QStringLiteral("0"));
-    if (!d->showWhiteSpace)
+    if (!showWhiteSpace)
         writer.writeAttribute(QStringLiteral("showWhiteSpace"), QStringLiteral("0"));
     writer.writeAttribute(QStringLiteral("workbookViewId"), QStringLiteral("0"));
     writer.writeEndElement(); // sheetView
@@ -1329,22 +1363,22 @@ void Worksheet::saveToXmlFile(QIODevice *device) const
 
     writer.writeStartElement(QStringLiteral("sheetFormatPr"));
     writer.writeAttribute(QStringLiteral("defaultRowHeight"),
-                          QString::number(d->sheetFormatProps.defaultRowHeight));
+                          QString::number(sheetFormatProps.defaultRowHeight));
     writer.writeAttribute(QStringLiteral("customHeight"),
-                          xsdBoolean(d->sheetFormatProps.customHeight));
-    writer.writeAttribute(QStringLiteral("zeroHeight"), xsdBoolean(d->sheetFormatProps.zeroHeight));
+                          xsdBoolean(sheetFormatProps.customHeight));
+    writer.writeAttribute(QStringLiteral("zeroHeight"), xsdBoolean(sheetFormatProps.zeroHeight));
     writer.writeAttribute(QStringLiteral("outlineLevelRow"),
-                          QString::number(d->sheetFormatProps.outlineLevelRow));
+                          QString::number(sheetFormatProps.outlineLevelRow));
     writer.writeAttribute(QStringLiteral("outlineLevelCol"),
-                          QString::number(d->sheetFormatProps.outlineLevelCol));
+                          QString::number(sheetFormatProps.outlineLevelCol));
     // for Excel 2010
     //     writer.writeAttribute("x14ac:dyDescent", "0.25");
     writer.writeEndElement(); // sheetFormatPr
 
-    if (!d->colsInfo.isEmpty()) {
+    if (!colsInfo.isEmpty()) {
         writer.writeStartElement(QStringLiteral("cols"));
 
-        for (auto it = d->colsInfo.begin(); it != d->colsInfo.end(); ++it) {
+        for (auto it = colsInfo.begin(); it != colsInfo.end(); ++it) {
             std::shared_ptr<XlsxColumnInfo> col_info = it.value();
             writer.writeStartElement(QStringLiteral("col"));
             writer.writeAttribute(QStringLiteral("min"), QString::number(col_info->firstColumn));
@@ -1368,16 +1402,18 @@ void Worksheet::saveToXmlFile(QIODevice *device) const
         }
         writer.writeEndElement(); // cols
     }
+}
 
-    writer.writeStartElement(QStringLiteral("sheetData"));
-    if (d->dimension.isValid())
-        d->saveXmlSheetData(writer);
-    writer.writeEndElement(); // sheetData
-
-    d->saveXmlMergeCells(writer);
-    for (const ConditionalFormatting &cf : d->conditionalFormattingList)
+/*!
+ * \internal
+ * Writes everything after \</sheetData\> and closes the document.
+ */
+void WorksheetPrivate::saveXmlTail(QXmlStreamWriter &writer) const
+{
+    saveXmlMergeCells(writer);
+    for (const ConditionalFormatting &cf : conditionalFormattingList)
         cf.saveToXml(writer);
-    d->saveXmlDataValidations(writer);
+    saveXmlDataValidations(writer);
 
     //{{ liufeijin :  write  pagesettings  add by liufeijin 20181028
 
@@ -1385,86 +1421,86 @@ void Worksheet::saveToXmlFile(QIODevice *device) const
     // NOTE: empty element is not problem. but, empty structure of element is not parsed by Excel.
 
     // pageMargins
-    if (false == d->PMleft.isEmpty() && false == d->PMright.isEmpty() &&
-        false == d->PMtop.isEmpty() && false == d->PMbotton.isEmpty() &&
-        false == d->PMheader.isEmpty() && false == d->PMfooter.isEmpty()) {
+    if (false == PMleft.isEmpty() && false == PMright.isEmpty() &&
+        false == PMtop.isEmpty() && false == PMbotton.isEmpty() &&
+        false == PMheader.isEmpty() && false == PMfooter.isEmpty()) {
         writer.writeStartElement(QStringLiteral("pageMargins"));
 
-        writer.writeAttribute(QStringLiteral("left"), d->PMleft);
-        writer.writeAttribute(QStringLiteral("right"), d->PMright);
-        writer.writeAttribute(QStringLiteral("top"), d->PMtop);
-        writer.writeAttribute(QStringLiteral("bottom"), d->PMbotton);
-        writer.writeAttribute(QStringLiteral("header"), d->PMheader);
-        writer.writeAttribute(QStringLiteral("footer"), d->PMfooter);
+        writer.writeAttribute(QStringLiteral("left"), PMleft);
+        writer.writeAttribute(QStringLiteral("right"), PMright);
+        writer.writeAttribute(QStringLiteral("top"), PMtop);
+        writer.writeAttribute(QStringLiteral("bottom"), PMbotton);
+        writer.writeAttribute(QStringLiteral("header"), PMheader);
+        writer.writeAttribute(QStringLiteral("footer"), PMfooter);
 
         writer.writeEndElement(); // pageMargins
     }
 
     // dev57
-    if (!d->Prid.isEmpty()) {
+    if (!Prid.isEmpty()) {
         writer.writeStartElement(QStringLiteral("pageSetup")); // pageSetup
 
-        writer.writeAttribute(QStringLiteral("r:id"), d->Prid);
+        writer.writeAttribute(QStringLiteral("r:id"), Prid);
 
-        if (!d->PverticalDpi.isEmpty()) {
-            writer.writeAttribute(QStringLiteral("verticalDpi"), d->PverticalDpi);
+        if (!PverticalDpi.isEmpty()) {
+            writer.writeAttribute(QStringLiteral("verticalDpi"), PverticalDpi);
         }
 
-        if (!d->PhorizontalDpi.isEmpty()) {
-            writer.writeAttribute(QStringLiteral("horizontalDpi"), d->PhorizontalDpi);
+        if (!PhorizontalDpi.isEmpty()) {
+            writer.writeAttribute(QStringLiteral("horizontalDpi"), PhorizontalDpi);
         }
 
-        if (!d->PuseFirstPageNumber.isEmpty()) {
-            writer.writeAttribute(QStringLiteral("useFirstPageNumber"), d->PuseFirstPageNumber);
+        if (!PuseFirstPageNumber.isEmpty()) {
+            writer.writeAttribute(QStringLiteral("useFirstPageNumber"), PuseFirstPageNumber);
         }
 
-        if (!d->PfirstPageNumber.isEmpty()) {
-            writer.writeAttribute(QStringLiteral("firstPageNumber"), d->PfirstPageNumber);
+        if (!PfirstPageNumber.isEmpty()) {
+            writer.writeAttribute(QStringLiteral("firstPageNumber"), PfirstPageNumber);
         }
 
-        if (!d->Pscale.isEmpty()) {
-            writer.writeAttribute(QStringLiteral("scale"), d->Pscale);
+        if (!Pscale.isEmpty()) {
+            writer.writeAttribute(QStringLiteral("scale"), Pscale);
         }
 
-        if (!d->PpaperSize.isEmpty()) {
-            writer.writeAttribute(QStringLiteral("paperSize"), d->PpaperSize);
+        if (!PpaperSize.isEmpty()) {
+            writer.writeAttribute(QStringLiteral("paperSize"), PpaperSize);
         }
 
-        if (!d->Porientation.isEmpty()) {
-            writer.writeAttribute(QStringLiteral("orientation"), d->Porientation);
+        if (!Porientation.isEmpty()) {
+            writer.writeAttribute(QStringLiteral("orientation"), Porientation);
         }
 
-        if (!d->Pcopies.isEmpty()) {
-            writer.writeAttribute(QStringLiteral("copies"), d->Pcopies);
+        if (!Pcopies.isEmpty()) {
+            writer.writeAttribute(QStringLiteral("copies"), Pcopies);
         }
 
         writer.writeEndElement(); // pageSetup
 
-    } // if ( !d->Prid.isEmpty() )
+    } // if ( !Prid.isEmpty() )
 
     // headerFooter
-    if (!(d->ModdHeader.isNull()) || !(d->MoodFooter.isNull())) {
+    if (!(ModdHeader.isNull()) || !(MoodFooter.isNull())) {
         writer.writeStartElement(QStringLiteral("headerFooter")); // headerFooter
 
-        if (!d->MoodalignWithMargins.isEmpty()) {
-            writer.writeAttribute(QStringLiteral("alignWithMargins"), d->MoodalignWithMargins);
+        if (!MoodalignWithMargins.isEmpty()) {
+            writer.writeAttribute(QStringLiteral("alignWithMargins"), MoodalignWithMargins);
         }
 
-        if (!d->ModdHeader.isNull()) {
+        if (!ModdHeader.isNull()) {
             writer.writeStartElement(QStringLiteral("oddHeader"));
-            writer.writeCharacters(d->ModdHeader);
+            writer.writeCharacters(ModdHeader);
             writer.writeEndElement(); // oddHeader
         }
 
-        if (!d->MoodFooter.isNull()) {
-            writer.writeTextElement(QStringLiteral("oddFooter"), d->MoodFooter);
+        if (!MoodFooter.isNull()) {
+            writer.writeTextElement(QStringLiteral("oddFooter"), MoodFooter);
         }
 
         writer.writeEndElement(); // headerFooter
     }
 
-    d->saveXmlHyperlinks(writer);
-    d->saveXmlDrawings(writer);
+    saveXmlHyperlinks(writer);
+    saveXmlDrawings(writer);
 
     writer.writeEndElement(); // worksheet
     writer.writeEndDocument();
@@ -1486,9 +1522,9 @@ void WorksheetPrivate::saveXmlSheetData(QXmlStreamWriter &writer) const
     calculateSpans();
 
     for (int row_num = dimension.firstRow(); row_num <= dimension.lastRow(); row_num++) {
-        auto ctIt = cellTable.cells.constFind(row_num);
-        auto riIt = rowsInfo.constFind(row_num);
-        if (ctIt == cellTable.cells.constEnd() && riIt == rowsInfo.constEnd() &&
+        const CellTable::Row *runs = cellTable.row(row_num);
+        auto riIt                  = rowsInfo.constFind(row_num);
+        if (!runs && riIt == rowsInfo.constEnd() &&
             !comments.contains(row_num)) {
             // Only process rows with cell data / comments / formatting
             continue;
@@ -1533,12 +1569,14 @@ void WorksheetPrivate::saveXmlSheetData(QXmlStreamWriter &writer) const
         }
 
         // Write cell data if row contains filled cells
-        if (ctIt != cellTable.cells.constEnd()) {
-            for (int col_num = dimension.firstColumn(); col_num <= dimension.lastColumn();
-                 col_num++) {
-                auto cellIt = ctIt->find(col_num);
-                if (cellIt != ctIt->end()) {
-                    saveXmlCellData(writer, row_num, col_num, *cellIt);
+        if (runs) {
+            for (const CellTable::Run &run : *runs) {
+                for (int i = 0; i < run.slots.size(); ++i) {
+                    const CellTable::Slot &slot = run.slots[i];
+                    if (slot.type == CellTable::CellSlot)
+                        saveXmlCellData(writer, row_num, run.firstColumn + i, cellTable.cellOf(slot));
+                    else if (slot.type != CellTable::EmptySlot)
+                        saveXmlSlotData(writer, row_num, run.firstColumn + i, slot);
                 }
             }
         }
@@ -1546,22 +1584,15 @@ void WorksheetPrivate::saveXmlSheetData(QXmlStreamWriter &writer) const
     }
 }
 
-void WorksheetPrivate::saveXmlCellData(QXmlStreamWriter &writer,
-                                       int row,
-                                       int col,
-                                       std::shared_ptr<Cell> cell) const
+/*!
+ * \internal
+ * Writes the "s" attribute: the cell's \a xfIndex, or else the format of
+ * the row or the column, if any.
+ */
+void WorksheetPrivate::saveXmlCellStyle(QXmlStreamWriter &writer, int row, int col, int xfIndex) const
 {
-    Q_Q(const Worksheet);
-
-    // This is the innermost loop so efficiency is important.
-    QString cell_pos = CellReference(row, col).toString();
-
-    writer.writeStartElement(QStringLiteral("c"));
-    writer.writeAttribute(QStringLiteral("r"), cell_pos);
-
-    // Style used by the cell, row or col
-    if (!cell->format().isEmpty()) {
-        writer.writeAttribute(QStringLiteral("s"), QString::number(cell->format().xfIndex()));
+    if (xfIndex >= 0) {
+        writer.writeAttribute(QStringLiteral("s"), QString::number(xfIndex));
     } else {
         auto rIt = rowsInfo.constFind(row);
         if (rIt != rowsInfo.constEnd() && !(*rIt)->format.isEmpty()) {
@@ -1574,6 +1605,65 @@ void WorksheetPrivate::saveXmlCellData(QXmlStreamWriter &writer,
             }
         }
     }
+}
+
+/*!
+ * \internal
+ * Writes a plain cell slot straight from the table, with the same output as
+ * saveXmlCellData() gives for the Cell it stands for.
+ */
+void WorksheetPrivate::saveXmlSlotData(QXmlStreamWriter &writer,
+                                       int row,
+                                       int col,
+                                       const CellTable::Slot &slot) const
+{
+    writer.writeStartElement(QStringLiteral("c"));
+    writer.writeAttribute(QStringLiteral("r"), CellReference(row, col).toString());
+    saveXmlCellStyle(writer, row, col, slot.style);
+
+    switch (slot.type) {
+    case CellTable::StringSlot:
+        writer.writeAttribute(QStringLiteral("t"), QStringLiteral("s"));
+        writer.writeTextElement(QStringLiteral("v"), QString::number(slot.index));
+        break;
+    case CellTable::BoolSlot:
+        writer.writeAttribute(QStringLiteral("t"), QStringLiteral("b"));
+        writer.writeTextElement(QStringLiteral("v"),
+                                slot.boolean ? QStringLiteral("1") : QStringLiteral("0"));
+        break;
+    case CellTable::DateSlot:
+        writer.writeAttribute(QStringLiteral("t"), QStringLiteral("n"));
+        writer.writeTextElement(QStringLiteral("v"), QVariant(slot.number).toString());
+        break;
+    case CellTable::BlankSlot:
+        writer.writeAttribute(QStringLiteral("t"), QStringLiteral("n"));
+        break;
+    case CellTable::CustomSlot:
+        writer.writeTextElement(QStringLiteral("v"), QString::number(slot.number, 'g', 15));
+        break;
+    default: // NumberSlot
+        writer.writeAttribute(QStringLiteral("t"), QStringLiteral("n"));
+        writer.writeTextElement(QStringLiteral("v"), QString::number(slot.number, 'g', 15));
+        break;
+    }
+
+    writer.writeEndElement(); // c
+}
+
+void WorksheetPrivate::saveXmlCellData(QXmlStreamWriter &writer,
+                                       int row,
+                                       int col,
+                                       std::shared_ptr<Cell> cell) const
+{
+    Q_Q(const Worksheet);
+
+    // This is the innermost loop so efficiency is important.
+    QString cell_pos = CellReference(row, col).toString();
+
+    writer.writeStartElement(QStringLiteral("c"));
+    writer.writeAttribute(QStringLiteral("r"), cell_pos);
+
+    saveXmlCellStyle(writer, row, col, cell->format().isEmpty() ? -1 : cell->format().xfIndex());
 
     if (cell->cellType() == Cell::SharedStringType) // 's'
     {
@@ -2253,6 +2343,9 @@ void WorksheetPrivate::loadXmlSheetData(QXmlStreamReader &reader)
     int row_num = 0;
     int col_num = 0;
 
+    // Uses are counted in sharedStringRefs, see commitSharedStringRefs()
+    const int sharedStringCount = sharedStrings()->uniqueCount();
+
     while (!reader.atEnd() && !(reader.name() == QLatin1String("sheetData") &&
                                 reader.tokenType() == QXmlStreamReader::EndElement)) {
         if (reader.readNextStartElement()) {
@@ -2366,6 +2459,7 @@ void WorksheetPrivate::loadXmlSheetData(QXmlStreamReader &reader)
 
                 // create a heap of new cell
                 auto cell = std::make_shared<Cell>(QVariant{}, cellType, format, q, styleIndex);
+                int sharedIndex = -1;
 
                 while (!reader.atEnd() && !(reader.name() == QLatin1String("c") &&
                                             reader.tokenType() == QXmlStreamReader::EndElement)) {
@@ -2384,12 +2478,15 @@ void WorksheetPrivate::loadXmlSheetData(QXmlStreamReader &reader)
                             QString value = reader.readElementText();
                             if (cellType == Cell::SharedStringType) {
                                 int sst_idx = value.toInt();
-                                sharedStrings()->incRefByStringIndex(sst_idx);
-                                RichString rs          = sharedStrings()->getSharedString(sst_idx);
-                                QString strPlainString = rs.toPlainString();
-                                cell->d_func()->value  = strPlainString;
-                                if (rs.isRichString())
-                                    cell->d_func()->richString = rs;
+                                if (sst_idx >= 0 && sst_idx < sharedStringCount) {
+                                    sharedIndex = sst_idx;
+                                    if (sharedStringRefs.size() <= sst_idx)
+                                        sharedStringRefs.resize(sst_idx + 1);
+                                    ++sharedStringRefs[sst_idx];
+                                } else {
+                                    qDebug("SharedStrings: invalid index");
+                                    cell->d_func()->value = QString();
+                                }
                             } else if (cellType == Cell::NumberType) {
                                 cell->d_func()->value = value.toDouble();
                             } else if (cellType == Cell::BooleanType) {
@@ -2431,7 +2528,29 @@ void WorksheetPrivate::loadXmlSheetData(QXmlStreamReader &reader)
                     }
                 }
 
-                cellTable.setValue(pos.row(), pos.column(), cell);
+                // A cell with a malformed or out of range position is dropped
+                if (pos.row() < 1 || pos.row() > XLSX_ROW_MAX || pos.column() < 1 ||
+                    pos.column() > XLSX_COLUMN_MAX) {
+                    qDebug("Worksheet: invalid cell position");
+                    if (sharedIndex >= 0)
+                        --sharedStringRefs[sharedIndex];
+                    continue;
+                }
+
+                // The index is known, no need to look the text up again; the
+                // text is only read, and decoded, for cells kept as objects
+                const SharedStrings *sst = sharedStrings();
+                if (sharedIndex >= 0 && !cell->hasFormula() && !sst->isRichString(sharedIndex) &&
+                    (format.isEmpty() || format.xfIndexValid())) {
+                    cellTable.setSharedString(pos.row(), pos.column(), sharedIndex, format);
+                } else {
+                    if (sharedIndex >= 0) {
+                        cell->d_func()->value = sst->getSharedPlainString(sharedIndex);
+                        if (sst->isRichString(sharedIndex))
+                            cell->d_func()->richString = sst->getSharedString(sharedIndex);
+                    }
+                    cellTable.setValue(pos.row(), pos.column(), cell);
+                }
             }
         }
     }
@@ -2801,6 +2920,21 @@ bool Worksheet::loadFromXmlFile(QIODevice *device)
     return true;
 }
 
+/*!
+ * \internal
+ * Adds the shared string uses counted by loadXmlSheetData(). Sheets may be
+ * loaded concurrently, so they only touch the shared strings afterwards.
+ */
+void WorksheetPrivate::commitSharedStringRefs()
+{
+    for (int i = 0; i < sharedStringRefs.size(); ++i) {
+        if (sharedStringRefs[i] > 0)
+            sharedStrings()->incRefByStringIndex(i, sharedStringRefs[i]);
+    }
+    sharedStringRefs.clear();
+    sharedStringRefs.squeeze();
+}
+
 /*
  *  Documents imported from Google Docs does not contain dimension data.
  */
@@ -2847,32 +2981,34 @@ QVector<CellLocation> Worksheet::getFullCells(int *maxRow, int *maxCol) const
         return ret;
     }
 
-    const auto sortedRows = d->cellTable.sortedRows();
-    for (const auto row : sortedRows) {
-        const auto &columns      = d->cellTable.cells[row];
-        const auto columnsSorted = CellTable::sorteIntList(columns.keys());
-        for (const auto &col : columnsSorted) {
-            // It's faster to iterate but cellTable is unordered which might not
-            // be what callers want?
-            auto cell = std::make_shared<Cell>(columns.value(col).get());
+    d->cellTable.forEachRow([&](int row, const CellTable::Row &runs) {
+        for (const CellTable::Run &run : runs) {
+            for (int i = 0; i < run.slots.size(); ++i) {
+                const CellTable::Slot &slot = run.slots[i];
+                if (slot.type == CellTable::EmptySlot)
+                    continue;
 
-            CellLocation cl;
+                CellLocation cl;
 
-            cl.row = row;
-            if (row > (*maxRow)) {
-                (*maxRow) = row;
-            }
+                cl.row = row;
+                if (row > (*maxRow)) {
+                    (*maxRow) = row;
+                }
 
-            cl.col = col;
-            if (col > (*maxCol)) {
-                (*maxCol) = col;
-            }
+                cl.col = run.firstColumn + i;
+                if (cl.col > (*maxCol)) {
+                    (*maxCol) = cl.col;
+                }
 
-            cl.cell = cell;
+                // Plain slots are materialized as new cells already
+                cl.cell = slot.type == CellTable::CellSlot
+                              ? std::make_shared<Cell>(d->cellTable.cellOf(slot).get())
+                              : d->cellTable.cellOf(slot);
 
-            ret.push_back(cl);
+                ret.push_back(cl);
+            }
         }
-    }
+    });
 
     return ret;
 }
@@ -2,20 +2,164 @@
 
 #include "xlsxzipreader_p.h"
 
-#include <private/qzipreader_p.h>
+#include <QBuffer>
+#include <QFile>
+
+#include <climits>
+#include <cstring>
+
+#include <zlib.h>
 
 QT_BEGIN_NAMESPACE_XLSX
 
+namespace {
+
+const quint32 LocalHeaderSignature          = 0x04034b50;
+const quint32 CentralHeaderSignature        = 0x02014b50;
+const quint32 EndOfCentralDirSignature      = 0x06054b50;
+const quint32 Zip64EndOfCentralDirSignature = 0x06064b50;
+const quint32 Zip64LocatorSignature         = 0x07064b50;
+
+const quint16 FlagEncrypted           = 0x0001;
+const quint16 FlagUtf8Name            = 0x0800;
+const quint16 MethodStored            = 0;
+const quint16 MethodDeflated          = 8;
+const quint16 Zip64ExtraField         = 0x0001;
+const quint32 MaxField32              = 0xffffffffu;
+const int LocalHeaderSize             = 30;
+const int CentralHeaderSize           = 46;
+const int EndOfCentralDirSize         = 22;
+const int Zip64LocatorSize            = 20;
+const int Zip64EndOfCentralDirSize    = 56;
+
+quint64 readLE(const char *data, int bytes)
+{
+    quint64 value = 0;
+    for (int i = bytes - 1; i >= 0; --i)
+        value = (value << 8) | quint8(data[i]);
+    return value;
+}
+
+// Inflates a raw deflate stream held in memory as it is read
+class InflateDevice : public QIODevice
+{
+public:
+    InflateDevice(const char *data, quint64 compressedSize, quint64 size)
+        : m_input(data)
+        , m_remaining(compressedSize)
+        , m_size(size)
+        , m_produced(0)
+        , m_finished(false)
+    {
+        memset(&m_stream, 0, sizeof(m_stream));
+        m_ready = inflateInit2(&m_stream, -MAX_WBITS) == Z_OK;
+    }
+
+    ~InflateDevice() override
+    {
+        if (m_ready)
+            inflateEnd(&m_stream);
+    }
+
+    bool open(OpenMode mode) override
+    {
+        return m_ready && mode == ReadOnly && QIODevice::open(mode);
+    }
+
+    bool isSequential() const override { return true; }
+
+    qint64 bytesAvailable() const override
+    {
+        const quint64 left = m_size > m_produced ? m_size - m_produced : 0;
+        return qint64(left) + QIODevice::bytesAvailable();
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        qint64 total = 0;
+        while (total < maxSize && !m_finished) {
+            if (m_stream.avail_in == 0 && m_remaining > 0) {
+                const uInt n     = uInt(qMin<quint64>(m_remaining, 1u << 30));
+                m_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(m_input));
+                m_stream.avail_in = n;
+                m_input += n;
+                m_remaining -= n;
+            }
+
+            const uInt room   = uInt(qMin<qint64>(maxSize - total, 1 << 30));
+            m_stream.next_out  = reinterpret_cast<Bytef *>(data + total);
+            m_stream.avail_out = room;
+            const int ret      = inflate(&m_stream, Z_NO_FLUSH);
+            total += room - m_stream.avail_out;
+
+            if (ret == Z_STREAM_END) {
+                m_finished = true;
+            } else if (ret != Z_OK) {
+                setErrorString(QStringLiteral("Corrupt or truncated zip entry"));
+                m_finished = true;
+                if (total == 0)
+                    return -1;
+            }
+        }
+        m_produced += quint64(total);
+        return total;
+    }
+
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    z_stream m_stream;
+    const char *m_input;
+    quint64 m_remaining;
+    quint64 m_size;
+    quint64 m_produced;
+    bool m_ready;
+    bool m_finished;
+};
+
+} // namespace
+
 ZipReader::ZipReader(const QString &filePath)
-    : m_reader(new QZipReader(filePath))
+    : m_file(new QFile(filePath))
 {
     init();
+    if (!m_file->open(QIODevice::ReadOnly))
+        return;
+
+    // Mapped when possible; pages are then read only as entries are used
+    m_size = m_file->size();
+    m_data = reinterpret_cast<const char *>(m_file->map(0, m_size));
+    if (!m_data) {
+        m_copy = m_file->readAll();
+        m_data = m_copy.constData();
+        m_size = m_copy.size();
+    }
+    m_valid = readCentralDirectory();
 }
 
 ZipReader::ZipReader(QIODevice *device)
-    : m_reader(new QZipReader(device))
 {
     init();
+    if (!device->isOpen() && !device->open(QIODevice::ReadOnly))
+        return;
+
+    // The device is used in place when its bytes are already addressable
+    if (auto buffer = qobject_cast<QBuffer *>(device)) {
+        m_data = buffer->data().constData();
+        m_size = buffer->data().size();
+    } else if (auto file = qobject_cast<QFile *>(device)) {
+        m_size = file->size();
+        m_data = reinterpret_cast<const char *>(file->map(0, m_size));
+    }
+    if (!m_data) {
+        if (!device->isSequential())
+            device->seek(0);
+        m_copy = device->readAll();
+        m_data = m_copy.constData();
+        m_size = m_copy.size();
+    }
+    m_valid = readCentralDirectory();
 }
 
 ZipReader::~ZipReader()
@@ -24,16 +168,127 @@ ZipReader::~ZipReader()
 
 void ZipReader::init()
 {
-    const auto &allFiles = m_reader->fileInfoList();
-    for (const auto &fi : allFiles) {
-        if (fi.isFile || (!fi.isDir && !fi.isFile && !fi.isSymLink))
-            m_filePaths.append(fi.filePath);
+    m_data  = nullptr;
+    m_size  = 0;
+    m_valid = false;
+}
+
+/*!
+ * \internal
+ * Indexes the central directory. ZIP64 records are followed when the
+ * classic ones are saturated.
+ */
+bool ZipReader::readCentralDirectory()
+{
+    if (!m_data || m_size < EndOfCentralDirSize)
+        return false;
+
+    // The end record is followed by a comment of up to 64 KiB
+    qint64 end       = m_size - EndOfCentralDirSize;
+    const qint64 low = qMax<qint64>(0, end - 0xffff);
+    while (end >= low && readLE(m_data + end, 4) != EndOfCentralDirSignature)
+        --end;
+    if (end < low)
+        return false;
+
+    quint64 count  = readLE(m_data + end + 10, 2);
+    quint64 size   = readLE(m_data + end + 12, 4);
+    quint64 offset = readLE(m_data + end + 16, 4);
+
+    const qint64 locator = end - Zip64LocatorSize;
+    if (locator >= 0 && readLE(m_data + locator, 4) == Zip64LocatorSignature) {
+        const quint64 record = readLE(m_data + locator + 8, 8);
+        if (m_size < Zip64EndOfCentralDirSize ||
+            record > quint64(m_size - Zip64EndOfCentralDirSize) ||
+            readLE(m_data + record, 4) != Zip64EndOfCentralDirSignature)
+            return false;
+        count  = readLE(m_data + record + 32, 8);
+        size   = readLE(m_data + record + 40, 8);
+        offset = readLE(m_data + record + 48, 8);
+    }
+    if (offset > quint64(m_size) || size > quint64(m_size) - offset)
+        return false;
+
+    const char *p         = m_data + offset;
+    const char *const cde = p + size;
+    for (quint64 i = 0; i < count; ++i) {
+        if (cde - p < CentralHeaderSize || readLE(p, 4) != CentralHeaderSignature)
+            return false;
+
+        const quint16 flags       = quint16(readLE(p + 8, 2));
+        const int nameLength      = int(readLE(p + 28, 2));
+        const int extraLength     = int(readLE(p + 30, 2));
+        const int commentLength   = int(readLE(p + 32, 2));
+        const qint64 recordLength = CentralHeaderSize + nameLength + extraLength + commentLength;
+        if (cde - p < recordLength)
+            return false;
+
+        Entry entry;
+        entry.method           = quint16(readLE(p + 10, 2));
+        entry.compressedSize   = readLE(p + 20, 4);
+        entry.uncompressedSize = readLE(p + 24, 4);
+        entry.headerOffset     = readLE(p + 42, 4);
+        if (flags & FlagEncrypted)
+            entry.method = 0xffff; // not readable
+
+        // Saturated fields are found, in this order, in the ZIP64 extra field
+        const char *extra = p + CentralHeaderSize + nameLength;
+        for (int at = 0; at + 4 <= extraLength;) {
+            const int id     = int(readLE(extra + at, 2));
+            const int length = int(readLE(extra + at + 2, 2));
+            if (id == Zip64ExtraField) {
+                const char *field = extra + at + 4;
+                const char *last  = field + qMin(length, extraLength - at - 4);
+                if (entry.uncompressedSize == MaxField32 && last - field >= 8) {
+                    entry.uncompressedSize = readLE(field, 8);
+                    field += 8;
+                }
+                if (entry.compressedSize == MaxField32 && last - field >= 8) {
+                    entry.compressedSize = readLE(field, 8);
+                    field += 8;
+                }
+                if (entry.headerOffset == MaxField32 && last - field >= 8)
+                    entry.headerOffset = readLE(field, 8);
+            }
+            at += 4 + length;
+        }
+
+        const QByteArray rawName = QByteArray::fromRawData(p + CentralHeaderSize, nameLength);
+        const QString name       = (flags & FlagUtf8Name) ? QString::fromUtf8(rawName)
+                                                          : QString::fromLocal8Bit(rawName);
+        if (!name.endsWith(QLatin1Char('/'))) {
+            if (!m_entries.contains(name))
+                m_filePaths.append(name);
+            m_entries.insert(name, entry);
+        }
+        p += recordLength;
     }
+    return true;
+}
+
+/*!
+ * \internal
+ * Returns the first byte of the entry data, or nullptr if the local header
+ * does not fit in the archive.
+ */
+const char *ZipReader::entryData(const Entry &entry) const
+{
+    if (m_size < LocalHeaderSize || entry.headerOffset > quint64(m_size - LocalHeaderSize))
+        return nullptr;
+    const char *header = m_data + entry.headerOffset;
+    if (readLE(header, 4) != LocalHeaderSignature)
+        return nullptr;
+
+    const quint64 start =
+        entry.headerOffset + LocalHeaderSize + readLE(header + 26, 2) + readLE(header + 28, 2);
+    if (start > quint64(m_size) || entry.compressedSize > quint64(m_size) - start)
+        return nullptr;
+    return m_data + start;
 }
 
 bool ZipReader::exists() const
 {
-    return m_reader->exists();
+    return m_valid;
 }
 
 QStringList ZipReader::filePaths() const
@@ -41,9 +296,55 @@ QStringList ZipReader::filePaths() const
     return m_filePaths;
 }
 
+bool ZipReader::contains(const QString &fileName) const
+{
+    return m_entries.contains(fileName);
+}
+
 QByteArray ZipReader::fileData(const QString &fileName) const
 {
-    return m_reader->fileData(fileName);
+    auto it = m_entries.constFind(fileName);
+    if (it == m_entries.constEnd() || it->uncompressedSize > quint64(INT_MAX))
+        return QByteArray();
+    const char *data = entryData(*it);
+    if (!data)
+        return QByteArray();
+
+    if (it->method == MethodStored)
+        return QByteArray(data, int(it->compressedSize));
+    if (it->method != MethodDeflated)
+        return QByteArray();
+
+    InflateDevice device(data, it->compressedSize, it->uncompressedSize);
+    if (!device.open(QIODevice::ReadOnly))
+        return QByteArray();
+    QByteArray out(int(it->uncompressedSize), Qt::Uninitialized);
+    if (device.read(out.data(), out.size()) != out.size())
+        return QByteArray();
+    return out;
+}
+
+std::unique_ptr<QIODevice> ZipReader::openFile(const QString &fileName) const
+{
+    std::unique_ptr<QIODevice> device;
+    auto it = m_entries.constFind(fileName);
+    if (it == m_entries.constEnd())
+        return device;
+    const char *data = entryData(*it);
+    if (!data)
+        return device;
+
+    if (it->method == MethodStored && it->compressedSize <= quint64(INT_MAX)) {
+        // A view of the archive, nothing is copied
+        auto buffer = new QBuffer;
+        buffer->setData(QByteArray::fromRawData(data, int(it->compressedSize)));
+        device.reset(buffer);
+    } else if (it->method == MethodDeflated) {
+        device.reset(new InflateDevice(data, it->compressedSize, it->uncompressedSize));
+    }
+    if (device && !device->open(QIODevice::ReadOnly))
+        device.reset();
+    return device;
 }
 
 QT_END_NAMESPACE_XLSX
@@ -2,47 +2,413 @@
 
 #include "xlsxzipwriter_p.h"
 
-#include <private/qzipwriter_p.h>
+#include <QDateTime>
+#include <QFile>
 
-#include <QDebug>
+#include <cstring>
+
+#include <zlib.h>
 
 QT_BEGIN_NAMESPACE_XLSX
 
+namespace {
+
+const quint32 LocalHeaderSignature          = 0x04034b50;
+const quint32 DataDescriptorSignature       = 0x08074b50;
+const quint32 CentralHeaderSignature        = 0x02014b50;
+const quint32 EndOfCentralDirSignature      = 0x06054b50;
+const quint32 Zip64EndOfCentralDirSignature = 0x06064b50;
+const quint32 Zip64LocatorSignature         = 0x07064b50;
+
+const quint16 FlagDataDescriptor = 0x0008;
+const quint16 FlagUtf8Name       = 0x0800;
+const quint16 MethodStored       = 0;
+const quint16 MethodDeflated     = 8;
+const quint16 VersionNeeded      = 20;
+const quint16 VersionZip64       = 45;
+const quint16 Zip64ExtraField    = 0x0001;
+
+const quint64 MaxField16 = 0xffffu;
+const quint64 MaxField32 = 0xffffffffu;
+const int ChunkSize      = 64 * 1024;
+
+void appendLE(QByteArray &out, quint64 value, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        out.append(char((value >> (8 * i)) & 0xff));
+}
+
+quint32 updateCrc(quint32 crc, const char *data, qint64 size)
+{
+    while (size > 0) {
+        const uInt n = uInt(qMin<qint64>(size, ChunkSize));
+        crc          = quint32(crc32(crc, reinterpret_cast<const Bytef *>(data), n));
+        data += n;
+        size -= n;
+    }
+    return crc;
+}
+
+// Raw deflate (no zlib header) of a whole buffer; empty on failure
+QByteArray deflateData(const QByteArray &data, int level)
+{
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return QByteArray();
+
+    QByteArray out;
+    out.resize(int(deflateBound(&stream, uLong(data.size()))));
+    stream.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(data.constData()));
+    stream.avail_in  = uInt(data.size());
+    stream.next_out  = reinterpret_cast<Bytef *>(out.data());
+    stream.avail_out = uInt(out.size());
+
+    const int ret = deflate(&stream, Z_FINISH);
+    out.resize(int(stream.total_out));
+    deflateEnd(&stream);
+    return ret == Z_STREAM_END ? out : QByteArray();
+}
+
+// A field of the classic records, or the marker sending readers to ZIP64
+quint64 field32(quint64 value)
+{
+    return qMin(value, MaxField32);
+}
+
+} // namespace
+
+struct ZipWriter::Deflater
+{
+    z_stream stream;
+    QByteArray buffer;
+};
+
 ZipWriter::ZipWriter(const QString &filePath)
+    : m_device(new QFile(filePath))
+    , m_ownsDevice(true)
 {
-    m_writer = new QZipWriter(filePath, QIODevice::WriteOnly);
-    m_writer->setCompressionPolicy(QZipWriter::AutoCompress);
+    init();
+    if (!m_device->open(QIODevice::WriteOnly))
+        m_error = true;
 }
 
 ZipWriter::ZipWriter(QIODevice *device)
+    : m_device(device)
+    , m_ownsDevice(false)
 {
-    m_writer = new QZipWriter(device);
-    m_writer->setCompressionPolicy(QZipWriter::AutoCompress);
+    init();
+    if (!m_device->isOpen() && !m_device->open(QIODevice::WriteOnly))
+        m_error = true;
 }
 
 ZipWriter::~ZipWriter()
 {
-    delete m_writer;
+    if (m_deflater)
+        deflateEnd(&m_deflater->stream);
+    if (m_ownsDevice)
+        delete m_device;
+}
+
+void ZipWriter::init()
+{
+    m_error  = false;
+    m_offset = 0;
+
+    // All entries share the time the package was started
+    const QDateTime now = QDateTime::currentDateTime();
+    m_dosTime = quint16((now.time().hour() << 11) | (now.time().minute() << 5) |
+                        (now.time().second() / 2));
+    m_dosDate = quint16(((qMax(now.date().year(), 1980) - 1980) << 9) |
+                        (now.date().month() << 5) | now.date().day());
 }
 
 bool ZipWriter::error() const
 {
-    return m_writer->status() != QZipWriter::NoError;
+    return m_error;
+}
+
+bool ZipWriter::writeBytes(const char *data, qint64 size)
+{
+    if (m_error)
+        return false;
+    if (m_device->write(data, size) != size) {
+        m_error = true;
+        return false;
+    }
+    m_offset += quint64(size);
+    return true;
+}
+
+bool ZipWriter::writeLocalHeader(const Entry &entry)
+{
+    const bool zip64 = entry.zip64 || entry.compressedSize >= MaxField32 ||
+                       entry.uncompressedSize >= MaxField32;
+
+    QByteArray header;
+    appendLE(header, LocalHeaderSignature, 4);
+    appendLE(header, zip64 ? VersionZip64 : VersionNeeded, 2);
+    appendLE(header, entry.flags, 2);
+    appendLE(header, entry.method, 2);
+    appendLE(header, m_dosTime, 2);
+    appendLE(header, m_dosDate, 2);
+    appendLE(header, entry.crc, 4);
+    appendLE(header, zip64 ? MaxField32 : entry.compressedSize, 4);
+    appendLE(header, zip64 ? MaxField32 : entry.uncompressedSize, 4);
+    appendLE(header, quint64(entry.name.size()), 2);
+    appendLE(header, zip64 ? 20 : 0, 2); // extra field length
+    header.append(entry.name);
+    if (zip64) {
+        // The local ZIP64 field always holds both sizes
+        appendLE(header, Zip64ExtraField, 2);
+        appendLE(header, 16, 2);
+        appendLE(header, entry.uncompressedSize, 8);
+        appendLE(header, entry.compressedSize, 8);
+    }
+    return writeBytes(header.constData(), header.size());
 }
 
 void ZipWriter::addFile(const QString &filePath, QIODevice *device)
 {
-    m_writer->addFile(filePath, device);
+    const bool opened = !device->isOpen();
+    if (opened && !device->open(QIODevice::ReadOnly)) {
+        m_error = true;
+        return;
+    }
+    addFile(filePath, device->readAll());
+    if (opened)
+        device->close();
 }
 
 void ZipWriter::addFile(const QString &filePath, const QByteArray &data)
 {
-    m_writer->addFile(filePath, data);
+    if (m_error || m_deflater)
+        return;
+    addPart(deflatePart(filePath, data));
+}
+
+ZipWriter::Part ZipWriter::deflatePart(const QString &filePath, const QByteArray &data, int level)
+{
+    Part part;
+    part.filePath         = filePath;
+    part.crc              = updateCrc(quint32(crc32(0, Z_NULL, 0)), data.constData(), data.size());
+    part.uncompressedSize = quint64(data.size());
+
+    // Stored when asked to or when deflate does not make the entry smaller
+    if (level != 0)
+        part.payload = deflateData(data, level);
+    if (!part.payload.isEmpty() && part.payload.size() < data.size()) {
+        part.method = MethodDeflated;
+    } else {
+        part.method  = MethodStored;
+        part.payload = data;
+    }
+    return part;
+}
+
+void ZipWriter::addPart(const Part &part)
+{
+    if (m_error || m_deflater)
+        return;
+
+    Entry entry;
+    entry.name             = part.filePath.toUtf8();
+    entry.flags            = FlagUtf8Name;
+    entry.method           = part.method;
+    entry.crc              = part.crc;
+    entry.compressedSize   = quint64(part.payload.size());
+    entry.uncompressedSize = part.uncompressedSize;
+    entry.offset           = m_offset;
+
+    if (writeLocalHeader(entry) && writeBytes(part.payload.constData(), part.payload.size()))
+        m_entries.append(entry);
+}
+
+bool ZipWriter::openFile(const QString &filePath, int level)
+{
+    if (m_error || m_deflater)
+        return false;
+
+    m_current        = Entry();
+    m_current.name   = filePath.toUtf8();
+    m_current.flags  = FlagUtf8Name | FlagDataDescriptor;
+    m_current.method = MethodDeflated;
+    m_current.crc    = quint32(crc32(0, Z_NULL, 0));
+    m_current.offset = m_offset;
+    m_current.zip64  = true;
+
+    // Level 0 still goes through deflate, as stored blocks: a stored entry
+    // followed by a data descriptor is not understood by every reader
+    std::unique_ptr<Deflater> deflater(new Deflater);
+    memset(&deflater->stream, 0, sizeof(deflater->stream));
+    if (deflateInit2(&deflater->stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) !=
+        Z_OK) {
+        m_error = true;
+        return false;
+    }
+    deflater->buffer.resize(ChunkSize);
+    m_deflater = std::move(deflater);
+
+    // CRC and sizes are zero here; the data descriptor carries them. The
+    // ZIP64 extra field tells streaming readers the descriptor sizes take
+    // 8 bytes, whatever the entry turns out to be.
+    return writeLocalHeader(m_current);
+}
+
+bool ZipWriter::deflateChunk(const char *data, qint64 size, int flush)
+{
+    z_stream &stream = m_deflater->stream;
+    stream.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    stream.avail_in  = uInt(size);
+
+    int ret;
+    do {
+        stream.next_out  = reinterpret_cast<Bytef *>(m_deflater->buffer.data());
+        stream.avail_out = uInt(m_deflater->buffer.size());
+        ret              = deflate(&stream, flush);
+        if (ret == Z_STREAM_ERROR) {
+            m_error = true;
+            return false;
+        }
+        const qint64 produced = m_deflater->buffer.size() - qint64(stream.avail_out);
+        if (produced > 0 && !writeBytes(m_deflater->buffer.constData(), produced))
+            return false;
+        m_current.compressedSize += quint64(produced);
+    } while (stream.avail_out == 0 || (flush == Z_FINISH && ret != Z_STREAM_END));
+    return true;
+}
+
+bool ZipWriter::writeData(const char *data, qint64 size)
+{
+    if (m_error || !m_deflater)
+        return false;
+
+    m_current.crc = updateCrc(m_current.crc, data, size);
+    m_current.uncompressedSize += quint64(size);
+    while (size > 0) {
+        const qint64 n = qMin<qint64>(size, ChunkSize);
+        if (!deflateChunk(data, n, Z_NO_FLUSH))
+            return false;
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool ZipWriter::closeFile()
+{
+    if (!m_deflater)
+        return false;
+
+    const bool finished = !m_error && deflateChunk(nullptr, 0, Z_FINISH);
+    deflateEnd(&m_deflater->stream);
+    m_deflater.reset();
+    if (!finished)
+        return false;
+
+    // ZIP64 descriptor, as announced by the local header; past 4 GiB the
+    // central directory has the sizes in its ZIP64 field too
+    QByteArray descriptor;
+    appendLE(descriptor, DataDescriptorSignature, 4);
+    appendLE(descriptor, m_current.crc, 4);
+    appendLE(descriptor, m_current.compressedSize, 8);
+    appendLE(descriptor, m_current.uncompressedSize, 8);
+    if (!writeBytes(descriptor.constData(), descriptor.size()))
+        return false;
+
+    m_entries.append(m_current);
+    return true;
 }
 
 void ZipWriter::close()
 {
-    m_writer->close();
+    if (m_deflater)
+        closeFile();
+
+    if (!m_error) {
+        const quint64 directoryOffset = m_offset;
+        QByteArray directory;
+        for (const Entry &entry : qAsConst(m_entries)) {
+            // Saturated fields follow, in this order, in the ZIP64 extra field
+            QByteArray extra;
+            if (entry.uncompressedSize >= MaxField32)
+                appendLE(extra, entry.uncompressedSize, 8);
+            if (entry.compressedSize >= MaxField32)
+                appendLE(extra, entry.compressedSize, 8);
+            if (entry.offset >= MaxField32)
+                appendLE(extra, entry.offset, 8);
+            const quint16 version =
+                extra.isEmpty() && !entry.zip64 ? VersionNeeded : VersionZip64;
+
+            appendLE(directory, CentralHeaderSignature, 4);
+            appendLE(directory, version, 2); // version made by: MS-DOS
+            appendLE(directory, version, 2);
+            appendLE(directory, entry.flags, 2);
+            appendLE(directory, entry.method, 2);
+            appendLE(directory, m_dosTime, 2);
+            appendLE(directory, m_dosDate, 2);
+            appendLE(directory, entry.crc, 4);
+            appendLE(directory, field32(entry.compressedSize), 4);
+            appendLE(directory, field32(entry.uncompressedSize), 4);
+            appendLE(directory, quint64(entry.name.size()), 2);
+            appendLE(directory, extra.isEmpty() ? 0 : 4 + extra.size(), 2); // extra field length
+            appendLE(directory, 0, 2); // comment length
+            appendLE(directory, 0, 2); // disk number
+            appendLE(directory, 0, 2); // internal attributes
+            appendLE(directory, 0, 4); // external attributes
+            appendLE(directory, field32(entry.offset), 4);
+            directory.append(entry.name);
+            if (!extra.isEmpty()) {
+                appendLE(directory, Zip64ExtraField, 2);
+                appendLE(directory, quint64(extra.size()), 2);
+                directory.append(extra);
+            }
+        }
+        if (writeBytes(directory.constData(), directory.size()))
+            writeEndOfCentralDirectory(directoryOffset, quint64(directory.size()));
+    }
+
+    m_device->close();
+}
+
+/*!
+ * \internal
+ * Ends the archive. The ZIP64 end record and its locator come first when
+ * the entry count, the directory size or its offset does not fit the
+ * classic record, which then only holds saturated values.
+ */
+void ZipWriter::writeEndOfCentralDirectory(quint64 directoryOffset, quint64 directorySize)
+{
+    const quint64 count = quint64(m_entries.size());
+    QByteArray end;
+    if (count >= MaxField16 || directorySize >= MaxField32 || directoryOffset >= MaxField32) {
+        const quint64 record = m_offset;
+        appendLE(end, Zip64EndOfCentralDirSignature, 4);
+        appendLE(end, 44, 8); // size of the rest of the record
+        appendLE(end, VersionZip64, 2);
+        appendLE(end, VersionZip64, 2);
+        appendLE(end, 0, 4); // this disk
+        appendLE(end, 0, 4); // disk with the central directory
+        appendLE(end, count, 8);
+        appendLE(end, count, 8);
+        appendLE(end, directorySize, 8);
+        appendLE(end, directoryOffset, 8);
+
+        appendLE(end, Zip64LocatorSignature, 4);
+        appendLE(end, 0, 4); // disk with the ZIP64 end record
+        appendLE(end, record, 8);
+        appendLE(end, 1, 4); // number of disks
+    }
+
+    appendLE(end, EndOfCentralDirSignature, 4);
+    appendLE(end, 0, 2); // this disk
+    appendLE(end, 0, 2); // disk with the central directory
+    appendLE(end, qMin(count, MaxField16), 2);
+    appendLE(end, qMin(count, MaxField16), 2);
+    appendLE(end, field32(directorySize), 4);
+    appendLE(end, field32(directoryOffset), 4);
+    appendLE(end, 0, 2); // comment length
+    writeBytes(end.constData(), end.size());
 }
 
 QT_END_NAMESPACE_XLSX
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QDataStream>
+#include <QIODevice>
+#include <QString>
+#include <QVector>
+#include <QtEndian>
+
+// Model kaydı kullanıcıdan gelebilir. QDataStream bir QVector veya QString
+// okurken önce kayıttaki uzunluk kadar yer ayırır; bu yardımcılar uzunluğa
+// onu tüketmeden bakar ve akışta o kadar veri kalmamışsa hiç ayırmadan
+// ReadCorruptData ile durur.
+
+// Sıradaki uzunluk alanı (quint32) elementSize baytlık öğelerle kalan veriye sığıyor mu
+inline bool nextLengthFits(QDataStream &stream, int elementSize) {
+    QIODevice *device = stream.device();
+    QByteArray head = device ? device->peek(sizeof(quint32)) : QByteArray();
+    if (head.size() != int(sizeof(quint32)))
+        return false;
+    quint32 length = stream.byteOrder() == QDataStream::BigEndian
+        ? qFromBigEndian<quint32>(head.constData())
+        : qFromLittleEndian<quint32>(head.constData());
+    if (length == 0xFFFFFFFFu)   // boş (null) QString
+        return true;
+    return quint64(device->bytesAvailable() - head.size()) / quint64(elementSize) >= length;
+}
+
+template <typename T>
+QDataStream &readVector(QDataStream &stream, QVector<T> &vector) {
+    if (stream.status() != QDataStream::Ok)
+        return stream;
+    if (!nextLengthFits(stream, sizeof(T))) {
+        vector.clear();
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return stream;
+    }
+    return stream >> vector;
+}
+
+// QString uzunluğu UTF-16 bayt sayısıdır
+inline QDataStream &readString(QDataStream &stream, QString &string) {
+    if (stream.status() != QDataStream::Ok)
+        return stream;
+    if (!nextLengthFits(stream, 1)) {
+        string.clear();
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return stream;
+    }
+    return stream >> string;
+}
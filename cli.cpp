@@ -0,0 +1,296 @@
+#include "cli.h"
+#include "MapParser.h"
+#include "elfreader.h"
+#include "modelcache.h"
+#include "linkerscript.h"
+#include "demangler.h"
+#include "symbolfilter.h"
+#include "sizebudget.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <cstdio>
+
+static QString csvField(const QString &text) {
+    if (!text.contains(',') && !text.contains('"') && !text.contains('\n'))
+        return text;
+    QString quoted = text;
+    quoted.replace("\"", "\"\"");
+    return "\"" + quoted + "\"";
+}
+
+static void printRegions(QTextStream &out, const MemoryStats &stats) {
+    out << QString("%1 %2 %3 %4 %5\n")
+           .arg(QString("Bölge"), -16)
+           .arg(QString("Başlangıç"), 12)
+           .arg(QString("Toplam"), 12)
+           .arg(QString("Kullanılan"), 12)
+           .arg(QString("Kullanım"), 9);
+    for (const MemoryRegion &region : stats.regions) {
+        double percent = region.length > 0 ? region.used * 100.0 / region.length : 0.0;
+        out << QString("%1 %2 %3 %4 %5%\n")
+               .arg(region.name, -16)
+               .arg(QString("0x%1").arg(region.origin, 8, 16, QChar('0')), 12)
+               .arg(region.length, 12)
+               .arg(region.used, 12)
+               .arg(percent, 8, 'f', 2);
+    }
+}
+
+// Kural başına tek satır; aşılanlar en sonda kısa bir özetle sayılır
+static int printBudgetReport(QTextStream &out, const QVector<BudgetRule> &rules,
+                             const QVector<BudgetResult> &results) {
+    out << QString("%1 %2 %3 %4 %5  %6\n")
+           .arg(QString("Durum"), -9)
+           .arg(QString("Kapsam"), -32)
+           .arg(QString("Taban"), 12)
+           .arg(QString("Aday"), 12)
+           .arg(QString("Fark"), 10)
+           .arg(QString("Sınırlar"));
+
+    int failed = 0;
+    for (const BudgetResult &result : results) {
+        const BudgetRule &rule = rules[result.rule];
+        QString status = !result.found ? "YOK" : result.passed() ? "tamam" : "AŞILDI";
+        QString delta;
+        if (result.hasBaseline) {
+            qint64 diff = qint64(result.current) - qint64(result.baseline);
+            delta = (diff > 0 ? "+" : "") + QString::number(diff);
+        }
+        out << QString("%1 %2 %3 %4 %5  %6\n")
+               .arg(status, -9)
+               .arg(rule.scopeText(), -32)
+               .arg(result.hasBaseline ? QString::number(result.baseline) : QString("-"), 12)
+               .arg(result.found ? QString::number(result.current) : QString("-"), 12)
+               .arg(delta, 10)
+               .arg(rule.limits);
+        if (!result.found)
+            out << "    bölge bulunamadı (" << rule.line << ". satır)\n";
+        for (const QString &violation : result.violations)
+            out << "    " << violation << "\n";
+        if (!result.passed())
+            ++failed;
+    }
+    return failed;
+}
+
+static bool readInput(const QString &input, MemoryStats &stats, MapModel &model) {
+    // FIFO'dan imza okumak veriyi tüketir; yalnızca normal dosyalarda ELF/model denetlenir
+    bool regularFile = QFileInfo(input).isFile();
+    if (regularFile && isElfFile(input))
+        return readElfFile(input, stats, model);
+    if (regularFile && isModelFile(input))
+        return loadModel(input, stats, model);
+    return parseMapPipe(input, stats, model);
+}
+
+static bool writeSymbolsCsv(const QString &path, const MapModel &model, const MemoryStats &stats,
+                            const QVector<int> &rows, bool demangle) {
+    QFile file;
+    bool opened;
+    if (path == "-") {
+        opened = file.open(stdout, QIODevice::WriteOnly);
+    } else {
+        file.setFileName(path);
+        opened = file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+    if (!opened)
+        return false;
+
+    const SymbolColumns &symbols = model.symbols;
+    QVector<QString> names;
+    if (demangle) {
+        // Yalnızca yazılacak satırların adları çözülür
+        QVector<quint32> ids;
+        ids.reserve(rows.size());
+        for (int row : rows)
+            ids.append(symbols.name[row]);
+        Demangler demangler(model.strings);
+        names = demangler.names(ids);
+    }
+
+    auto text = [&model](quint32 id) {
+        return id == StringPool::npos ? QString() : model.strings.at(id);
+    };
+
+    QTextStream out(&file);
+    out.setCodec("UTF-8");
+    out << "symbol,address,size,section,object,region\n";
+    for (int n = 0; n < rows.size(); ++n) {
+        int i = rows[n];
+        int region = symbols.region[i];
+        out << csvField(demangle ? names[n] : text(symbols.name[i])) << ','
+            << QString("0x%1").arg(symbols.address[i], 8, 16, QChar('0')) << ','
+            << symbols.size[i] << ','
+            << csvField(text(symbols.section[i])) << ','
+            << csvField(text(symbols.object[i])) << ','
+            << (region >= 0 && region < stats.regions.size() ? stats.regions[region].name : QString()) << '\n';
+    }
+    return out.status() == QTextStream::Ok;
+}
+
+int runCli(const QStringList &arguments) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Map Analyzer komut satırı modu");
+    parser.addHelpOption();
+
+    QCommandLineOption cliOption("cli", "Grafik arayüz olmadan çalıştır.");
+    QCommandLineOption symbolsOption("symbols", "Sembol tablosunu CSV olarak yaz (\"-\": stdout).", "csv");
+    QCommandLineOption filterOption("filter", "Yalnızca ifadeye uyan semboller, örn. "
+                                    "'region==RAM && section=~\"\\.bss\" && size>1K'.", "ifade");
+    QCommandLineOption noDemangleOption("no-demangle", "C++ sembol adlarını çözme.");
+    QCommandLineOption saveModelOption("save-model", "Ayrıştırılan modeli ikili olarak kaydet "
+                                       "(sonraki çalıştırmalarda girdi olarak verilebilir).", "dosya");
+    parser.addOption(cliOption);
+    parser.addOption(symbolsOption);
+    parser.addOption(filterOption);
+    QCommandLineOption ldOption("ld", "Bölgeleri GNU linker betiğinden al ve map ile karşılaştır. "
+                                "Girdi verilmezse yalnızca betik özetlenir.", "betik");
+    parser.addOption(saveModelOption);
+    parser.addOption(ldOption);
+    parser.addOption(noDemangleOption);
+    QCommandLineOption baselineOption("baseline", "Taban olarak karşılaştırılacak kayıtlı model, map veya ELF "
+                                      "(bkz. --save-model).", "model");
+    QCommandLineOption budgetOption("budget", "Bölge, arşiv ve sembol bütçelerini denetle; aşılırsa "
+                                    "çıkış kodu 1 olur.", "dosya");
+    parser.addOption(baselineOption);
+    parser.addOption(budgetOption);
+    parser.addPositionalArgument("girdi", "Map, ELF veya kayıtlı model dosyası, FIFO yolu ya da stdin için \"-\".");
+    parser.process(arguments);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    out.setCodec("UTF-8");
+    err.setCodec("UTF-8");
+
+    LinkerScript script;
+    if (parser.isSet(ldOption)) {
+        QString error;
+        if (!parseLinkerScript(parser.value(ldOption), script, &error)) {
+            err << "Linker betiği işlenemedi: " << error << "\n";
+            return 2;
+        }
+        // Bağlama öncesi bütçe: map olmadan betikteki bölge ve bölümler
+        if (parser.positionalArguments().isEmpty()) {
+            MemoryStats scriptStats;
+            scriptStats.regions = script.regions;
+            printRegions(out, scriptStats);
+            for (const ScriptSection &section : script.sections) {
+                out << QString("%1 %2%3\n").arg(section.name, -24)
+                       .arg(section.region.isEmpty() ? QString() : ">" + section.region)
+                       .arg(section.loadRegion.isEmpty() ? QString() : " AT>" + section.loadRegion);
+            }
+            return 0;
+        }
+    }
+
+    QString input = parser.positionalArguments().value(0, "-");
+
+    // İfade, girdi okunmadan önce derlenir: hatalı filtre uzun bir okumayı boşa harcamasın
+    SymbolFilter filter;
+    if (parser.isSet(filterOption)) {
+        filter = SymbolFilter::compile(parser.value(filterOption));
+        if (!filter.isValid()) {
+            err << "Geçersiz filtre: " << filter.errorString() << "\n";
+            return 2;
+        }
+    }
+
+    QVector<BudgetRule> rules;
+    if (parser.isSet(budgetOption)) {
+        QString error;
+        if (!parseBudgetFile(parser.value(budgetOption), rules, &error)) {
+            err << "Bütçe dosyası işlenemedi: " << error << "\n";
+            return 2;
+        }
+        for (const BudgetRule &rule : rules) {
+            if (rule.needsBaseline() && !parser.isSet(baselineOption)) {
+                err << "Bütçe " << rule.line << ". satır: growth= sınırı için --baseline gerekli\n";
+                return 2;
+            }
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    MemoryStats stats;
+    MapModel model;
+    if (!readInput(input, stats, model)) {
+        err << "Girdi okunamadı: " << input << "\n";
+        return 2;
+    }
+
+    MemoryStats baseStats;
+    MapModel baseModel;
+    if (parser.isSet(baselineOption) && !readInput(parser.value(baselineOption), baseStats, baseModel)) {
+        err << "Taban okunamadı: " << parser.value(baselineOption) << "\n";
+        return 2;
+    }
+
+    QStringList findings;
+    if (parser.isSet(ldOption)) {
+        findings = crossCheckScript(script, stats.regions, model);
+        applyScriptRegions(script, stats, model);
+        // Taban aynı bölgelerle ölçülmeli, yoksa farklar betikten kaynaklanır
+        if (parser.isSet(baselineOption))
+            applyScriptRegions(script, baseStats, baseModel);
+    }
+
+    if (parser.isSet(saveModelOption) && !saveModel(parser.value(saveModelOption), stats, model)) {
+        err << "Model kaydedilemedi: " << parser.value(saveModelOption) << "\n";
+        return 2;
+    }
+
+    QString symbolsPath = parser.value(symbolsOption);
+    if (symbolsPath != "-") {
+        printRegions(out, stats);
+        for (const QString &finding : findings)
+            out << "uyarı: " << finding << "\n";
+    }
+
+    // Bütçe verilmezse taban yalnızca bölge bölge karşılaştırılır
+    int exitCode = 0;
+    if (parser.isSet(budgetOption) || parser.isSet(baselineOption)) {
+        if (!parser.isSet(budgetOption)) {
+            for (const MemoryRegion &region : stats.regions) {
+                BudgetRule rule;
+                rule.pattern = region.name;
+                rules.append(rule);
+            }
+        }
+        QVector<BudgetResult> results = evaluateBudget(rules, stats, model,
+                                                       parser.isSet(baselineOption) ? &baseStats : nullptr,
+                                                       parser.isSet(baselineOption) ? &baseModel : nullptr);
+
+        // CSV stdout'a yazılıyorsa rapor stderr'e gider
+        QTextStream &report = symbolsPath == "-" ? err : out;
+        report << "\n";
+        int failed = printBudgetReport(report, rules, results);
+        report << QString("bütçe: %1/%2 kural aşıldı (%3 ms)\n").arg(failed).arg(results.size()).arg(timer.elapsed());
+        if (failed > 0)
+            exitCode = 1;
+    }
+    out.flush();
+    err.flush();
+
+    if (symbolsPath.isEmpty())
+        return exitCode;
+
+    QVector<int> rows;
+    if (filter.isValid()) {
+        rows = filter.apply(model, stats.regions);
+    } else {
+        rows.reserve(model.symbols.count());
+        for (int i = 0; i < model.symbols.count(); ++i)
+            rows.append(i);
+    }
+
+    if (!writeSymbolsCsv(symbolsPath, model, stats, rows, !parser.isSet(noDemangleOption))) {
+        err << "Sembol tablosu yazılamadı: " << symbolsPath << "\n";
+        return 2;
+    }
+    return exitCode;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <QStringList>
+
+// Grafik arayüz açmadan analiz:
+//   MapAnalyzer --cli [seçenekler] <map | elf | fifo | ->
+// Dönüş değeri işlemin çıkış kodudur: 0 başarılı, 1 bütçe aşıldı, 2 hata.
+//   MapAnalyzer --cli --baseline taban.mapmodel --budget bütçe.txt yeni.map
+int runCli(const QStringList &arguments);
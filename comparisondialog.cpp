@@ -0,0 +1,76 @@
+#include "comparisondialog.h"
+#include <QVBoxLayout>
+#include <QLabel>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QFileInfo>
+#include <QColor>
+
+ComparisonDialog::ComparisonDialog(const QVector<ComparedMap> &maps, int threshold, QWidget *parent)
+    : QDialog(parent)
+{
+    setWindowTitle("Map Karşılaştırma");
+    setMinimumSize(800, 400);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+
+    QLabel *infoLabel = new QLabel(QString("%1 map dosyası karşılaştırılıyor (Kullanılan / Toplam KB)").arg(maps.size()), this);
+    layout->addWidget(infoLabel);
+
+    // Tüm dosyalardaki bölge adlarını ilk görüldükleri sırayla topla
+    QStringList regionNames;
+    for (const ComparedMap &map : maps) {
+        for (const MemoryRegion &region : map.stats.regions) {
+            if (!regionNames.contains(region.name))
+                regionNames.append(region.name);
+        }
+    }
+
+    QTableWidget *table = new QTableWidget(regionNames.size(), maps.size(), this);
+    table->setVerticalHeaderLabels(regionNames);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setStyleSheet("QTableWidget { background-color: #f8f9fa; border: 1px solid #ddd; }"
+                         "QHeaderView::section { background-color: #3498db; color: white; padding: 5px; }");
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    for (int col = 0; col < maps.size(); ++col) {
+        const ComparedMap &map = maps[col];
+        QTableWidgetItem *header = new QTableWidgetItem(QFileInfo(map.filePath).completeBaseName());
+        header->setToolTip(map.filePath);
+        table->setHorizontalHeaderItem(col, header);
+
+        for (int row = 0; row < regionNames.size(); ++row) {
+            QTableWidgetItem *item = new QTableWidgetItem();
+            table->setItem(row, col, item);
+
+            if (!map.ok) {
+                item->setText("okunamadı");
+                continue;
+            }
+
+            const MemoryRegion *region = nullptr;
+            for (const MemoryRegion &r : map.stats.regions) {
+                if (r.name == regionNames[row]) {
+                    region = &r;
+                    break;
+                }
+            }
+            if (!region) {
+                item->setText("-");
+                continue;
+            }
+
+            double used  = region->used / 1024.0;
+            double total = region->length / 1024.0;
+            double percent = (total > 0) ? (used * 100.0 / total) : 0.0;
+
+            item->setText(QString("%1 / %2 (%3%)")
+                          .arg(used, 0, 'f', 2)
+                          .arg(total, 0, 'f', 2)
+                          .arg(percent, 0, 'f', 1));
+            item->setBackground(percent >= threshold ? QColor("#06d6a0") : QColor("#ff6b6b"));
+        }
+    }
+
+    layout->addWidget(table);
+}
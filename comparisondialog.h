@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QDialog>
+#include <QStringList>
+#include <QVector>
+#include "MapParser.h"
+
+// Birden fazla map dosyasının bölge kullanımını yan yana gösterir.
+// Her sütun bir build varyantı, her satır bir bellek bölgesidir.
+struct ComparedMap {
+    QString filePath;
+    bool ok = false;
+    MemoryStats stats;
+};
+
+class ComparisonDialog : public QDialog {
+    Q_OBJECT
+public:
+    explicit ComparisonDialog(const QVector<ComparedMap> &maps, int threshold, QWidget *parent = nullptr);
+};
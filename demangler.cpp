@@ -0,0 +1,96 @@
+#include "demangler.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+#include <cstdlib>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+static const int BatchSize = 4096;
+
+Demangler::Demangler(const StringPool &strings)
+    : m_strings(strings)
+{
+}
+
+Demangler::~Demangler() {
+    // Gruplar iptali her kimlikte denetler; başlamamış olanlar hemen çıkar
+    cancel();
+    m_batches.waitForFinished();
+}
+
+QString Demangler::demangle(const QString &mangled) {
+#ifdef __GNUG__
+    if (!isMangled(mangled))
+        return mangled;
+
+    QByteArray raw = mangled.toLatin1();
+    int status = 0;
+    char *out = abi::__cxa_demangle(raw.constData(), nullptr, nullptr, &status);
+    if (status == 0 && out) {
+        QString result = QString::fromUtf8(out);
+        std::free(out);
+        return result;
+    }
+    std::free(out);
+#endif
+    return mangled;
+}
+
+QString Demangler::name(quint32 id) const {
+    const QString &raw = m_strings.at(id);
+    if (!isMangled(raw))
+        return raw;
+
+    Shard &shard = m_shards[id % ShardCount];
+    {
+        QReadLocker locker(&shard.lock);
+        auto it = shard.names.constFind(id);
+        if (it != shard.names.constEnd())
+            return it.value();
+    }
+
+    QString demangled = demangle(raw);
+    QWriteLocker locker(&shard.lock);
+    shard.names.insert(id, demangled);
+    return demangled;
+}
+
+QString Demangler::cachedName(quint32 id) const {
+    const QString &raw = m_strings.at(id);
+    if (!isMangled(raw))
+        return raw;
+
+    Shard &shard = m_shards[id % ShardCount];
+    QReadLocker locker(&shard.lock);
+    return shard.names.value(id, raw);
+}
+
+QVector<QString> Demangler::names(const QVector<quint32> &ids) const {
+    QVector<QString> result(ids.size());
+    QVector<int> batches;
+    for (int begin = 0; begin < ids.size(); begin += BatchSize)
+        batches.append(begin);
+
+    QString *out = result.data();
+    QtConcurrent::blockingMap(batches, [this, &ids, out](int begin) {
+        int end = qMin(begin + BatchSize, ids.size());
+        for (int i = begin; i < end; ++i)
+            out[i] = name(ids[i]);
+    });
+    return result;
+}
+
+void Demangler::prewarm(const QVector<quint32> &ids) {
+    for (int begin = 0; begin < ids.size(); begin += BatchSize) {
+        m_batches.addFuture(QtConcurrent::run([this, ids, begin]() {
+            int end = qMin(begin + BatchSize, ids.size());
+            for (int i = begin; i < end && !m_cancelled.loadAcquire(); ++i)
+                name(ids[i]);
+        }));
+    }
+}
+
+void Demangler::cancel() {
+    m_cancelled.storeRelease(1);
+}
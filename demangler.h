@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QFutureSynchronizer>
+#include <QReadWriteLock>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include "mapmodel.h"
+
+// C++ sembol adlarını (Itanium ABI, _Z...) çözer ve sonucu interned kimliğe
+// göre saklar. Görünen satırlar name() ile tembel olarak çözülür; prewarm()
+// ayrıştırmadan sonra önbelleği arka planda doldurur.
+class Demangler {
+public:
+    // StringPool örtük paylaşımlı kopyalanır; model değişse de güvenlidir
+    explicit Demangler(const StringPool &strings);
+    ~Demangler();
+
+    QString name(quint32 id) const;
+    // Önbellekte varsa çözülmüş adı, yoksa ham adı döndürür (çözmez)
+    QString cachedName(quint32 id) const;
+
+    // Kimlikleri paralel gruplar hâlinde çözer; sonuç sırası girişle aynıdır
+    QVector<QString> names(const QVector<quint32> &ids) const;
+
+    // Önbelleği QThreadPool üzerinde doldurur; yıkıcı veya cancel() durdurur
+    void prewarm(const QVector<quint32> &ids);
+    void cancel();
+
+    static QString demangle(const QString &mangled);
+    static bool isMangled(const QString &name) { return name.startsWith("_Z"); }
+
+private:
+    // Kilit çekişmesini azaltmak için önbellek kimliğe göre parçalara bölünür
+    static const int ShardCount = 16;
+    struct Shard {
+        QReadWriteLock lock;
+        QHash<quint32, QString> names;
+    };
+
+    StringPool m_strings;
+    mutable Shard m_shards[ShardCount];
+    QAtomicInt m_cancelled;
+    QFutureSynchronizer<void> m_batches; // prewarm() grupları; yıkıcı bunları bekler
+};
@@ -0,0 +1,65 @@
+#include "dependencygraph.h"
+
+void DependencyGraph::build(const MapModel &model) {
+    const CrossReference &cref = model.cref;
+    const int n = model.strings.size();
+
+    m_offsets.fill(0, n + 1);
+    m_isSymbol.fill(false, n);
+
+    // Ters kenarlar: tanımlayan nesne ← sembol, sembol ← referans veren nesne
+    for (int i = 0; i < cref.count(); ++i) {
+        m_isSymbol[int(cref.symbol[i])] = true;
+        if (cref.definer[i] != StringPool::npos)
+            ++m_offsets[int(cref.definer[i]) + 1];
+        m_offsets[int(cref.symbol[i]) + 1] += cref.refOffset[i + 1] - cref.refOffset[i];
+    }
+    for (int i = 0; i < n; ++i)
+        m_offsets[i + 1] += m_offsets[i];
+
+    m_dependents.resize(m_offsets[n]);
+    QVector<int> fill = m_offsets;
+    for (int i = 0; i < cref.count(); ++i) {
+        quint32 symbol = cref.symbol[i];
+        if (cref.definer[i] != StringPool::npos)
+            m_dependents[fill[int(cref.definer[i])]++] = symbol;
+        for (int r = cref.refOffset[i]; r < cref.refOffset[i + 1]; ++r)
+            m_dependents[fill[int(symbol)]++] = cref.referrers[r];
+    }
+}
+
+QVector<quint32> DependencyGraph::whyLinked(quint32 entry, const QVector<quint32> &targets) const {
+    const int n = m_offsets.size() - 1;
+    if (int(entry) >= n)
+        return QVector<quint32>();
+
+    // Hedeflerden geriye doğru çok kaynaklı BFS; entry'ye ilk ulaşılan yol en kısadır
+    QVector<quint32> parent(n, StringPool::npos);
+    QVector<bool> visited(n, false);
+    QVector<quint32> queue;
+    for (quint32 target : targets) {
+        if (int(target) < n && !visited[int(target)]) {
+            visited[int(target)] = true;
+            queue.append(target);
+        }
+    }
+
+    for (int head = 0; head < queue.size() && !visited[int(entry)]; ++head) {
+        int u = int(queue[head]);
+        for (int e = m_offsets[u]; e < m_offsets[u + 1]; ++e) {
+            int v = int(m_dependents[e]);
+            if (visited[v])
+                continue;
+            visited[v] = true;
+            parent[v] = quint32(u);
+            queue.append(quint32(v));
+        }
+    }
+
+    QVector<quint32> chain;
+    if (!visited[int(entry)])
+        return chain;
+    for (quint32 id = entry; id != StringPool::npos; id = parent[int(id)])
+        chain.append(id);
+    return chain;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QVector>
+#include "mapmodel.h"
+
+// --cref tablosundan kurulan ters bağımlılık grafiği. Düğümler StringPool
+// kimlikleridir (sembol veya nesne). İleri yön "bağlanmaya sebep olur"
+// anlamındadır: nesne → referans verdiği sembol → sembolü tanımlayan nesne.
+// Grafik bu kenarların tersini CSR olarak saklar.
+class DependencyGraph {
+public:
+    void build(const MapModel &model);
+
+    bool isEmpty() const { return m_dependents.isEmpty(); }
+    bool isSymbol(quint32 id) const { return int(id) < m_isSymbol.size() && m_isSymbol[int(id)]; }
+
+    // entry'den hedeflerden herhangi birine giden en kısa zincir (entry ... hedef).
+    // Zincir yoksa boş döner.
+    QVector<quint32> whyLinked(quint32 entry, const QVector<quint32> &targets) const;
+
+private:
+    QVector<int> m_offsets;          // düğüm → m_dependents aralığı
+    QVector<quint32> m_dependents;   // bu düğüme ihtiyaç duyan düğümler
+    QVector<bool> m_isSymbol;
+};
@@ -0,0 +1,96 @@
+#include "discardreport.h"
+#include <QHash>
+#include <algorithm>
+
+static void sortByDiscarded(QVector<DiscardSummary> &rows) {
+    std::sort(rows.begin(), rows.end(), [](const DiscardSummary &a, const DiscardSummary &b) {
+        return a.discarded > b.discarded;
+    });
+}
+
+QVector<DiscardSummary> discardedByObject(const MapModel &model) {
+    QVector<DiscardSummary> rows;
+    QHash<quint32, int> rowOf;
+
+    auto rowFor = [&](quint32 object) -> DiscardSummary & {
+        auto it = rowOf.constFind(object);
+        if (it != rowOf.constEnd())
+            return rows[it.value()];
+
+        DiscardSummary summary;
+        summary.name = model.strings.at(object);
+        summary.archive = archiveOf(summary.name);
+        rowOf.insert(object, rows.size());
+        rows.append(summary);
+        return rows.last();
+    };
+
+    const SymbolColumns &discarded = model.discarded;
+    for (int i = 0; i < discarded.count(); ++i) {
+        if (discarded.object[i] == StringPool::npos || isDebugSection(model.strings.at(discarded.name[i])))
+            continue;
+        DiscardSummary &row = rowFor(discarded.object[i]);
+        row.discarded += discarded.size[i];
+        ++row.discardedSections;
+    }
+
+    // Yalnızca en az bir bölümü atılmış nesnelerin kalan boyutu ilgi çekicidir
+    const SymbolColumns &sections = model.sections;
+    for (int i = 0; i < sections.count(); ++i) {
+        quint32 object = sections.object[i];
+        if (object == StringPool::npos || !rowOf.contains(object))
+            continue;
+        if (sections.section[i] != StringPool::npos && isDebugSection(model.strings.at(sections.section[i])))
+            continue;
+        rowFor(object).kept += sections.size[i];
+    }
+
+    sortByDiscarded(rows);
+    return rows;
+}
+
+QVector<DiscardSummary> discardedByArchive(const MapModel &model) {
+    QVector<DiscardSummary> rows;
+    QHash<QString, int> rowOf;
+
+    for (const DiscardSummary &object : discardedByObject(model)) {
+        if (object.archive.isEmpty())
+            continue;
+
+        int index = rowOf.value(object.archive, -1);
+        if (index < 0) {
+            index = rows.size();
+            rowOf.insert(object.archive, index);
+            DiscardSummary summary;
+            summary.name = object.archive;
+            rows.append(summary);
+        }
+
+        DiscardSummary &row = rows[index];
+        row.discarded += object.discarded;
+        row.discardedSections += object.discardedSections;
+    }
+
+    // Kalan boyut arşivin tüm üyelerinden toplanır; hiç bölümü atılmamış
+    // üyeler de arşivin bağlanan kısmıdır
+    QHash<quint32, int> rowOfObject;
+    const SymbolColumns &sections = model.sections;
+    for (int i = 0; i < sections.count(); ++i) {
+        quint32 object = sections.object[i];
+        if (object == StringPool::npos)
+            continue;
+        if (sections.section[i] != StringPool::npos && isDebugSection(model.strings.at(sections.section[i])))
+            continue;
+
+        int index = rowOfObject.value(object, -2);
+        if (index == -2) {
+            index = rowOf.value(archiveOf(model.strings.at(object)), -1);
+            rowOfObject.insert(object, index);
+        }
+        if (index >= 0)
+            rows[index].kept += sections.size[i];
+    }
+
+    sortByDiscarded(rows);
+    return rows;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include "mapmodel.h"
+
+// --gc-sections ile atılan ve bağlanan bayt miktarları (nesne veya arşiv başına)
+struct DiscardSummary {
+    QString name;
+    QString archive;        // nesne satırlarında ait olduğu arşiv, yoksa boş
+    quint64 discarded = 0;
+    quint64 kept = 0;
+    int discardedSections = 0;
+
+    double discardedPercent() const {
+        quint64 total = discarded + kept;
+        return total > 0 ? discarded * 100.0 / total : 0.0;
+    }
+    // Büyük kısmı atılan nesneler daha küçük dosyalara bölünmeye adaydır
+    bool mostlyDead() const { return discarded >= 64 && discardedPercent() >= 50.0; }
+};
+
+// Atılan bayta göre büyükten küçüğe sıralı
+QVector<DiscardSummary> discardedByObject(const MapModel &model);
+QVector<DiscardSummary> discardedByArchive(const MapModel &model);
@@ -0,0 +1,310 @@
+#include "elfreader.h"
+#include <QFile>
+#include <QHash>
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+
+enum {
+    SHT_SYMTAB = 2,
+    SHT_NOBITS = 8,
+    SHF_WRITE = 0x1,
+    SHF_ALLOC = 0x2,
+    SHN_UNDEF = 0,
+    SHN_LORESERVE = 0xff00,
+    PT_LOAD = 1,
+    PF_W = 0x2,
+    STT_OBJECT = 1,
+    STT_FUNC = 2,
+    STT_FILE = 4,
+    STT_COMMON = 5,
+    STT_TLS = 6,
+    STB_LOCAL = 0,
+    EM_ARM = 40,
+};
+
+// ELF32 ve ELF64 alan konumları; okuma kodu iki sınıf için ortaktır
+struct ElfLayout {
+    int phoff, shoff, phentsize, phnum, shentsize, shnum, shstrndx;
+    int shName, shType, shFlags, shAddr, shOffset, shSize, shLink;
+    int pType, pFlags, pVaddr, pPaddr, pFilesz, pMemsz;
+    int stName, stInfo, stShndx, stValue, stSize, symSize;
+    int shEntrySize, phEntrySize; // okunan alanları kapsayan en küçük girdi boyları
+};
+
+const ElfLayout elf32 = {
+    28, 32, 42, 44, 46, 48, 50,
+    0, 4, 8, 12, 16, 20, 24,
+    0, 24, 8, 12, 16, 20,
+    0, 12, 14, 4, 8, 16,
+    40, 32,
+};
+
+const ElfLayout elf64 = {
+    32, 40, 54, 56, 58, 60, 62,
+    0, 4, 8, 16, 24, 32, 40,
+    0, 4, 16, 24, 32, 40,
+    0, 4, 6, 8, 16, 24,
+    64, 56,
+};
+
+class ElfImage {
+public:
+    ElfImage(const uchar *data, quint64 size)
+        : m_data(data), m_size(size)
+    {
+        m_is64 = data[4] == 2;
+        m_bigEndian = data[5] == 2;
+        m_layout = m_is64 ? &elf64 : &elf32;
+    }
+
+    const ElfLayout &layout() const { return *m_layout; }
+    bool contains(quint64 offset, quint64 length) const {
+        return offset <= m_size && length <= m_size - offset;
+    }
+    const char *at(quint64 offset) const { return reinterpret_cast<const char *>(m_data + offset); }
+
+    quint8 u8(quint64 offset) const { return m_data[offset]; }
+    quint16 u16(quint64 offset) const {
+        return m_bigEndian ? qFromBigEndian<quint16>(m_data + offset) : qFromLittleEndian<quint16>(m_data + offset);
+    }
+    quint32 u32(quint64 offset) const {
+        return m_bigEndian ? qFromBigEndian<quint32>(m_data + offset) : qFromLittleEndian<quint32>(m_data + offset);
+    }
+    quint64 u64(quint64 offset) const {
+        return m_bigEndian ? qFromBigEndian<quint64>(m_data + offset) : qFromLittleEndian<quint64>(m_data + offset);
+    }
+    // Adres/boyut alanları ELF32'de 4, ELF64'te 8 bayttır
+    quint64 word(quint64 offset) const { return m_is64 ? u64(offset) : u32(offset); }
+
+private:
+    const uchar *m_data;
+    quint64 m_size;
+    bool m_is64;
+    bool m_bigEndian;
+    const ElfLayout *m_layout;
+};
+
+struct ElfSection {
+    quint32 nameId = StringPool::npos;
+    quint32 type = 0;
+    quint64 flags = 0, addr = 0, offset = 0, size = 0;
+    quint32 link = 0;
+};
+
+struct ElfSegment {
+    quint32 flags = 0;
+    quint64 vaddr = 0, paddr = 0, filesz = 0, memsz = 0;
+};
+
+// String tablosundaki bir girdiyi kopyalamadan okur; aynı ofset yalnızca bir
+// kez QString'e çevrilip havuza eklenir.
+class StringTableView {
+public:
+    StringTableView(const ElfImage &image, quint64 offset, quint64 size, StringPool &pool)
+        : m_image(image), m_offset(offset), m_size(size), m_pool(pool) {}
+
+    quint32 intern(quint32 index) {
+        if (index >= m_size)
+            return StringPool::npos;
+
+        auto it = m_ids.constFind(index);
+        if (it != m_ids.constEnd())
+            return it.value();
+
+        const char *text = m_image.at(m_offset + index);
+        int length = int(qstrnlen(text, uint(m_size - index)));
+        quint32 id = m_pool.intern(QString::fromUtf8(text, length));
+        m_ids.insert(index, id);
+        return id;
+    }
+
+private:
+    const ElfImage &m_image;
+    quint64 m_offset, m_size;
+    StringPool &m_pool;
+    QHash<quint32, quint32> m_ids;
+};
+
+void addSpan(QVector<MemoryRegion> &regions, const QString &name, quint64 start, quint64 length) {
+    if (length == 0)
+        return;
+
+    for (MemoryRegion &region : regions) {
+        if (region.name != name)
+            continue;
+        quint64 end = qMax(region.origin + region.length, start + length);
+        region.origin = qMin(region.origin, start);
+        region.length = end - region.origin;
+        return;
+    }
+
+    MemoryRegion region;
+    region.name = name;
+    region.origin = start;
+    region.length = length;
+    regions.append(region);
+}
+
+} // namespace
+
+bool isElfFile(const QString &filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    return file.read(4) == QByteArray("\x7f" "ELF", 4);
+}
+
+bool readElfFile(const QString &filePath, MemoryStats &stats, MapModel &model) {
+    QFile file(filePath);
+    // e_ident 16 bayttır; başlığın geri kalanının boyu sınıfa bağlıdır
+    if (!file.open(QIODevice::ReadOnly) || file.size() < 16)
+        return false;
+
+    const uchar *data = file.map(0, file.size());
+    if (!data || std::memcmp(data, "\x7f" "ELF", 4) != 0)
+        return false;
+    const quint8 elfClass = data[4], elfData = data[5];
+    if ((elfClass != 1 && elfClass != 2) || (elfData != 1 && elfData != 2))
+        return false;
+    if (file.size() < (elfClass == 2 ? 64 : 52))
+        return false;
+
+    ElfImage image(data, quint64(file.size()));
+    const ElfLayout &l = image.layout();
+    bool thumb = image.u16(18) == EM_ARM;
+
+    model.clear();
+
+    // Program başlıkları: VMA/LMA eşlemesi ve bölge türetme
+    QVector<ElfSegment> segments;
+    quint64 phoff = image.word(l.phoff);
+    quint16 phentsize = image.u16(l.phentsize);
+    quint16 phnum = image.u16(l.phnum);
+    if (phentsize >= l.phEntrySize && image.contains(phoff, quint64(phentsize) * phnum)) {
+        for (int i = 0; i < phnum; ++i) {
+            quint64 ph = phoff + quint64(i) * phentsize;
+            if (image.u32(ph + l.pType) != PT_LOAD)
+                continue;
+            ElfSegment segment;
+            segment.flags  = image.u32(ph + l.pFlags);
+            segment.vaddr  = image.word(ph + l.pVaddr);
+            segment.paddr  = image.word(ph + l.pPaddr);
+            segment.filesz = image.word(ph + l.pFilesz);
+            segment.memsz  = image.word(ph + l.pMemsz);
+            segments.append(segment);
+        }
+    }
+
+    if (stats.regions.isEmpty()) {
+        for (const ElfSegment &segment : segments) {
+            if (segment.flags & PF_W) {
+                addSpan(stats.regions, "RAM", segment.vaddr, segment.memsz);
+                if (segment.paddr != segment.vaddr)
+                    addSpan(stats.regions, "FLASH", segment.paddr, segment.filesz);
+            } else {
+                addSpan(stats.regions, "FLASH", segment.paddr, segment.memsz);
+            }
+        }
+    }
+    for (MemoryRegion &region : stats.regions)
+        region.used = 0;
+
+    // Bölüm başlıkları
+    quint64 shoff = image.word(l.shoff);
+    quint16 shentsize = image.u16(l.shentsize);
+    quint16 shnum = image.u16(l.shnum);
+    quint16 shstrndx = image.u16(l.shstrndx);
+    if (shnum == 0 || shentsize < l.shEntrySize
+        || !image.contains(shoff, quint64(shentsize) * shnum))
+        return false;
+
+    QVector<ElfSection> sections(shnum);
+    for (int i = 0; i < shnum; ++i) {
+        quint64 sh = shoff + quint64(i) * shentsize;
+        ElfSection &section = sections[i];
+        section.type   = image.u32(sh + l.shType);
+        section.flags  = image.word(sh + l.shFlags);
+        section.addr   = image.word(sh + l.shAddr);
+        section.offset = image.word(sh + l.shOffset);
+        section.size   = image.word(sh + l.shSize);
+        section.link   = image.u32(sh + l.shLink);
+    }
+
+    if (shstrndx < shnum && image.contains(sections[shstrndx].offset, sections[shstrndx].size)) {
+        StringTableView names(image, sections[shstrndx].offset, sections[shstrndx].size, model.strings);
+        for (int i = 0; i < shnum; ++i)
+            sections[i].nameId = names.intern(image.u32(shoff + quint64(i) * shentsize + l.shName));
+    }
+
+    for (const ElfSection &section : sections) {
+        if (!(section.flags & SHF_ALLOC) || section.size == 0 || section.nameId == StringPool::npos)
+            continue;
+
+        int region = regionIndexOf(stats.regions, section.addr);
+        model.outputs.append(section.nameId, section.nameId, StringPool::npos, region, section.addr, section.size);
+        if (region >= 0)
+            stats.regions[region].used += section.size;
+
+        // İlk değeri flash'ta saklanan bölümler (ör. .data) LMA bölgesinde de yer kaplar
+        if (section.type == SHT_NOBITS)
+            continue;
+        for (const ElfSegment &segment : segments) {
+            if (segment.paddr == segment.vaddr || section.addr < segment.vaddr
+                || section.addr - segment.vaddr >= segment.memsz)
+                continue;
+            int loadRegion = regionIndexOf(stats.regions, segment.paddr + (section.addr - segment.vaddr));
+            if (loadRegion >= 0 && loadRegion != region)
+                stats.regions[loadRegion].used += section.size;
+            break;
+        }
+    }
+
+    // .symtab: yalnızca tanımlı fonksiyon ve veri sembolleri
+    for (const ElfSection &symtab : sections) {
+        if (symtab.type != SHT_SYMTAB || symtab.link >= shnum)
+            continue;
+        const ElfSection &strtab = sections[int(symtab.link)];
+        if (!image.contains(symtab.offset, symtab.size) || !image.contains(strtab.offset, strtab.size))
+            continue;
+
+        StringTableView names(image, strtab.offset, strtab.size, model.strings);
+        quint32 sourceFile = StringPool::npos;
+        quint64 count = symtab.size / quint64(l.symSize);
+        model.symbols.reserve(model.symbols.count() + int(count));
+
+        for (quint64 i = 1; i < count; ++i) {
+            quint64 sym = symtab.offset + i * quint64(l.symSize);
+            quint8 info = image.u8(sym + l.stInfo);
+            quint8 type = info & 0x0f;
+            quint8 bind = info >> 4;
+            quint16 shndx = image.u16(sym + l.stShndx);
+
+            // STT_FILE'dan sonraki yerel semboller o kaynak dosyaya aittir
+            if (type == STT_FILE) {
+                sourceFile = names.intern(image.u32(sym + l.stName));
+                continue;
+            }
+            if (type != STT_FUNC && type != STT_OBJECT && type != STT_COMMON && type != STT_TLS)
+                continue;
+            if (shndx == SHN_UNDEF || shndx >= SHN_LORESERVE || shndx >= shnum)
+                continue;
+
+            quint64 address = image.word(sym + l.stValue);
+            if (thumb && type == STT_FUNC)
+                address &= ~quint64(1);   // Thumb bit
+
+            model.symbols.append(names.intern(image.u32(sym + l.stName)),
+                                 sections[shndx].nameId,
+                                 bind == STB_LOCAL ? sourceFile : StringPool::npos,
+                                 regionIndexOf(stats.regions, address),
+                                 address,
+                                 image.word(sym + l.stSize));
+        }
+    }
+    model.exactSymbolSizes = true;
+
+    applyRegionSummary(stats);
+    return true;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QString>
+#include "MapParser.h"
+
+// Bağlanmış ELF32/ELF64 imajından map ayrıştırıcısıyla aynı modeli üretir.
+// Dosya belleğe eşlenir (mmap); string tabloları kopyalanmadan okunur ve
+// sembol boyutları .symtab'taki kesin değerlerdir.
+//
+// stats.regions önceden doluysa (ör. linker script'ten) bölgeler korunur ve
+// yalnızca doluluk hesaplanır; boşsa PT_LOAD segmentlerinden FLASH/RAM
+// bölgeleri türetilir.
+bool readElfFile(const QString &filePath, MemoryStats &stats, MapModel &model);
+
+bool isElfFile(const QString &filePath);
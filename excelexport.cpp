@@ -0,0 +1,300 @@
+#include "excelexport.h"
+#include "demangler.h"
+#include "xlsxstreamwriter.h"
+#include "xlsxworksheet.h"
+#include <QFile>
+#include <QHash>
+#include <algorithm>
+
+// Excel sayfası en fazla 1 048 576 satırdır; biri başlık satırı
+static const int MaxDataRows = 1048575;
+// İlerleme ve iptal bu kadar satırda bir kontrol edilir
+static const int ProgressStep = 4096;
+
+// Bölge sayfasındaki tabloların ilk sütunları; aralarında bir boş sütun kalır
+enum { SymbolColumn = 1, SectionColumn = 8, ArchiveColumn = 14 };
+
+int ExcelExportProgress::percent() const {
+    if (saving.loadAcquire())
+        return 99;
+    int all = total.loadAcquire();
+    if (all <= 0)
+        return 0;
+    // Satırlar %90'a kadar sayılır, kalanı paketin diske yazılmasıdır
+    return int(qint64(done.loadAcquire()) * 90 / all);
+}
+
+namespace {
+
+struct Rollup {
+    QString name;
+    int count = 0;
+    quint64 bytes = 0;
+};
+
+// Her bölgenin adres sırasıyla satırları ve arşiv toplamları
+struct RegionRows {
+    QVector<int> symbols;
+    QVector<int> sections;
+    QVector<Rollup> archives;   // bayta göre büyükten küçüğe
+};
+
+} // namespace
+
+static QString hex(quint64 value) {
+    return QString("0x%1").arg(value, 8, 16, QChar('0'));
+}
+
+// Excel sayfa adları büyük/küçük harf duyarsız benzersiz ve en fazla 31 karakterdir
+static QString uniqueSheetName(const QString &proposal, const QStringList &used) {
+    QString base = proposal.isEmpty() ? QString("Bölge") : proposal.left(31);
+    QString name = base;
+    for (int n = 2; used.contains(name, Qt::CaseInsensitive); ++n) {
+        QString suffix = QString(" (%1)").arg(n);
+        name = base.left(31 - suffix.size()) + suffix;
+    }
+    return name;
+}
+
+bool writeDetailedExcel(const QString &path, const MemoryStats &stats, const MapModel &model,
+                        int threshold, const Demangler *demangler,
+                        ExcelExportProgress *progress, QString *error) {
+    const QVector<MemoryRegion> &regions = stats.regions;
+    const int regionCount = regions.size();
+    // Giriş bölümleri yoksa (ELF) çıkış bölümleri yazılır, arşivler sembollerden toplanır
+    const SymbolColumns &sections = model.sections.count() > 0 ? model.sections : model.outputs;
+    const SymbolColumns &owners = model.sections.count() > 0 ? model.sections : model.symbols;
+
+    auto text = [&model](quint32 id) {
+        return id == StringPool::npos ? QString() : model.strings.at(id);
+    };
+
+    // Satırlar bölgelere tek geçişte dağıtılır
+    QVector<RegionRows> rows(regionCount);
+    for (int i = 0; i < model.symbols.count(); ++i) {
+        int r = model.symbols.region[i];
+        if (r >= 0 && r < regionCount)
+            rows[r].symbols.append(i);
+    }
+    for (int i = 0; i < sections.count(); ++i) {
+        int r = sections.region[i];
+        if (r >= 0 && r < regionCount)
+            rows[r].sections.append(i);
+    }
+
+    // Nesne başına arşiv adı bir kez çıkarılır; arşiv üyesi değilse boş
+    QHash<quint32, QString> archiveNames;
+    auto archiveName = [&](quint32 object) -> QString {
+        auto it = archiveNames.constFind(object);
+        if (it != archiveNames.constEnd())
+            return *it;
+        return *archiveNames.insert(object, archiveOf(text(object)));
+    };
+
+    // Arşiv üyesi olmayan nesneler kendi adlarıyla, *fill* satırları tek grupta toplanır
+    QVector<QHash<QString, int>> rollupIndex(regionCount);
+    for (int i = 0; i < owners.count(); ++i) {
+        int r = owners.region[i];
+        if (r < 0 || r >= regionCount)
+            continue;
+        QString key;
+        if (text(owners.name[i]) == "*fill*")
+            key = "*fill*";
+        else if (owners.object[i] == StringPool::npos)
+            key = "(nesne yok)";
+        else if ((key = archiveName(owners.object[i])).isEmpty())
+            key = text(owners.object[i]);
+
+        QVector<Rollup> &archives = rows[r].archives;
+        auto it = rollupIndex[r].constFind(key);
+        int k = it != rollupIndex[r].constEnd() ? *it : -1;
+        if (k < 0) {
+            k = archives.size();
+            rollupIndex[r].insert(key, k);
+            Rollup rollup;
+            rollup.name = key;
+            archives.append(rollup);
+        }
+        archives[k].count++;
+        archives[k].bytes += owners.size[i];
+    }
+
+    int totalRows = regionCount;
+    for (int r = 0; r < regionCount; ++r) {
+        RegionRows &region = rows[r];
+        std::sort(region.symbols.begin(), region.symbols.end(), [&model](int a, int b) {
+            return model.symbols.address[a] < model.symbols.address[b];
+        });
+        std::sort(region.sections.begin(), region.sections.end(), [&sections](int a, int b) {
+            return sections.address[a] < sections.address[b];
+        });
+        std::sort(region.archives.begin(), region.archives.end(), [](const Rollup &a, const Rollup &b) {
+            return a.bytes > b.bytes;
+        });
+
+        totalRows += qMin(region.symbols.size(), MaxDataRows) + qMin(region.sections.size(), MaxDataRows)
+                     + region.archives.size();
+    }
+    if (progress)
+        progress->total.storeRelease(totalRows);
+
+    int pending = 0;
+    auto canceled = [progress]() {
+        return progress && progress->canceled.loadAcquire();
+    };
+    // Satır sayacını toplu ilerletir; iptal edildiyse false
+    auto tick = [&](int count) -> bool {
+        pending += count;
+        if (pending < ProgressStep)
+            return true;
+        if (progress)
+            progress->done.fetchAndAddRelaxed(pending);
+        pending = 0;
+        return !canceled();
+    };
+    auto fail = [error](const QString &message) -> bool {
+        if (error)
+            *error = message;
+        return false;
+    };
+
+    // Satırlar eklendikçe pakete sıkıştırılır; bellek satır sayısıyla büyümez
+    QXlsx::StreamWriter xlsx(path);
+    // Yarım dosya bırakılmaz
+    auto discard = [&](const QString &message) -> bool {
+        xlsx.close();
+        QFile::remove(path);
+        return fail(message);
+    };
+    auto abort = [&]() -> bool {
+        return discard("İptal edildi.");
+    };
+    // Yinelenen veya geçersiz adla sayfa açılamazsa yazılacak sayfa yoktur
+    auto addSheet = [&](const QString &name) -> bool {
+        return xlsx.addSheet(name) && xlsx.currentWorksheet();
+    };
+
+    QXlsx::Format headerFormat;
+    headerFormat.setFontBold(true);
+    headerFormat.setFontSize(12);
+    headerFormat.setFillPattern(QXlsx::Format::PatternSolid);
+    headerFormat.setPatternBackgroundColor(QColor("#3498db"));
+    headerFormat.setFontColor(Qt::white);
+    headerFormat.setHorizontalAlignment(QXlsx::Format::AlignHCenter);
+
+    // Özet: bölge başına doluluk, eşik renklendirmesi tek sayfalık dışa aktarmayla aynı
+    QStringList sheetNames;
+    sheetNames << "Özet";
+    if (!addSheet(sheetNames.last()))
+        return discard(QString("Excel sayfası oluşturulamadı: %1").arg(sheetNames.last()));
+    xlsx.currentWorksheet()->setColumnWidth(1, 1, 20);
+    xlsx.currentWorksheet()->setColumnWidth(2, 8, 16);
+    xlsx.writeRow({ "Bölge", "Başlangıç", "Uzunluk (byte)", "Kullanılan (byte)", "Boş (byte)",
+                    "Kullanım %", "Sembol", "Bölüm" }, headerFormat);
+
+    for (int r = 0; r < regionCount; ++r) {
+        const MemoryRegion &region = regions[r];
+        double percent = region.length > 0 ? region.used * 100.0 / region.length : 0.0;
+
+        QXlsx::Format rowFormat;
+        rowFormat.setPatternBackgroundColor(QColor(percent >= threshold ? "#06d6a0" : "#ff6b6b"));
+        xlsx.writeRow({ region.name, hex(region.origin), region.length, region.used,
+                        region.length > region.used ? region.length - region.used : 0,
+                        qRound(percent * 100) / 100.0, rows[r].symbols.size(),
+                        rows[r].sections.size() }, rowFormat);
+        tick(1);
+    }
+
+    for (int r = 0; r < regionCount; ++r) {
+        if (canceled())
+            return abort();
+
+        const MemoryRegion &region = regions[r];
+        const RegionRows &regionRows = rows[r];
+        sheetNames << uniqueSheetName(region.name, sheetNames);
+        if (!addSheet(sheetNames.last()))
+            return discard(QString("Excel sayfası oluşturulamadı: %1").arg(sheetNames.last()));
+
+        QXlsx::Worksheet *sheet = xlsx.currentWorksheet();
+        sheet->setColumnWidth(SymbolColumn, SymbolColumn, 40);
+        sheet->setColumnWidth(SymbolColumn + 1, SymbolColumn + 2, 14);
+        sheet->setColumnWidth(SymbolColumn + 3, SymbolColumn + 5, 28);
+        sheet->setColumnWidth(SectionColumn, SectionColumn + 1, 28);
+        sheet->setColumnWidth(SectionColumn + 2, SectionColumn + 3, 14);
+        sheet->setColumnWidth(SectionColumn + 4, SectionColumn + 4, 28);
+        sheet->setColumnWidth(ArchiveColumn, ArchiveColumn, 32);
+        sheet->setColumnWidth(ArchiveColumn + 1, ArchiveColumn + 3, 14);
+
+        // Üç tablo satır satır akıtılır: her sayfa satırı üç tablonun k. satırlarını taşır,
+        // biten tablonun ve aradaki boş sütunların hücreleri yazılmaz
+        QVariantList values;
+        for (int c = SymbolColumn; c < ArchiveColumn + 4; ++c)
+            values << QVariant();
+        auto put = [&values](int column, const QVariantList &cells) {
+            for (int c = 0; c < cells.size(); ++c)
+                values[column - SymbolColumn + c] = cells[c];
+        };
+
+        put(SymbolColumn, { "Sembol", "Adres", "Boyut (byte)", "Giriş Bölümü", "Nesne", "Arşiv" });
+        put(SectionColumn, { "Giriş Bölümü", "Çıkış Bölümü", "Adres", "Boyut (byte)", "Nesne" });
+        put(ArchiveColumn, { "Arşiv / Nesne", "Bölüm", "Boyut (byte)", "Bölgedeki Pay %" });
+        xlsx.writeRow(SymbolColumn, values, headerFormat);
+
+        const int symbolCount = qMin(regionRows.symbols.size(), MaxDataRows);
+        const int sectionCount = qMin(regionRows.sections.size(), MaxDataRows);
+        const int archiveCount = qMin(regionRows.archives.size(), MaxDataRows);
+        const int rowCount = qMax(symbolCount, qMax(sectionCount, archiveCount));
+
+        QVector<QString> names;
+        if (demangler) {
+            QVector<quint32> ids(symbolCount);
+            for (int k = 0; k < symbolCount; ++k)
+                ids[k] = model.symbols.name[regionRows.symbols[k]];
+            names = demangler->names(ids);
+        }
+
+        for (int k = 0; k < rowCount; ++k) {
+            for (QVariant &value : values)
+                value = QVariant();
+
+            if (k < symbolCount) {
+                int i = regionRows.symbols[k];
+                put(SymbolColumn, {
+                    demangler ? names[k] : text(model.symbols.name[i]),
+                    hex(model.symbols.address[i]),
+                    model.symbols.size[i],
+                    text(model.symbols.section[i]),
+                    text(model.symbols.object[i]),
+                    archiveName(model.symbols.object[i]) });
+            }
+            if (k < sectionCount) {
+                int i = regionRows.sections[k];
+                put(SectionColumn, {
+                    text(sections.name[i]),
+                    text(sections.section[i]),
+                    hex(sections.address[i]),
+                    sections.size[i],
+                    text(sections.object[i]) });
+            }
+            if (k < archiveCount) {
+                const Rollup &rollup = regionRows.archives[k];
+                double share = region.length > 0 ? rollup.bytes * 100.0 / region.length : 0.0;
+                put(ArchiveColumn, { rollup.name, rollup.count, rollup.bytes,
+                                     qRound(share * 100) / 100.0 });
+            }
+
+            xlsx.writeRow(SymbolColumn, values);
+            if (!tick(int(k < symbolCount) + int(k < sectionCount) + int(k < archiveCount)))
+                return abort();
+        }
+    }
+
+    if (canceled())
+        return abort();
+    if (progress)
+        progress->saving.storeRelease(1);
+
+    if (!xlsx.close())
+        return fail("Excel kaydedilemedi!");
+    return true;
+}
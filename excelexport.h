@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QString>
+#include "MapParser.h"
+
+class Demangler;
+
+// Dışa aktarma iş parçacığı yazar, GUI bir zamanlayıcıyla yoklar
+struct ExcelExportProgress {
+    QAtomicInt done;        // yazılan satır
+    QAtomicInt total;
+    QAtomicInt saving;      // 1: satırlar bitti, paket kapatılıyor
+    QAtomicInt canceled;    // GUI 1 yapar, iş parçacığı ilk fırsatta durur
+
+    int percent() const;
+};
+
+// Özet sayfası ve her bölge için bir sayfa: semboller, giriş bölümleri ve
+// arşiv toplamları yan yana üç tablo olarak, adres sırasıyla. Satırlar
+// QXlsx::StreamWriter ile doğrudan pakete akıtılır. GUI'ye dokunmaz,
+// QtConcurrent::run içinden çağrılabilir. demangler verilirse sembol adları
+// çözülür. İptal edilirse yarım dosya silinir.
+bool writeDetailedExcel(const QString &path, const MemoryStats &stats, const MapModel &model,
+                        int threshold, const Demangler *demangler = nullptr,
+                        ExcelExportProgress *progress = nullptr, QString *error = nullptr);
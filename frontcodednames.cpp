@@ -0,0 +1,214 @@
+#include "frontcodednames.h"
+#include "checkedstream.h"
+#include <QBitArray>
+#include <QDataStream>
+#include <algorithm>
+#include <numeric>
+
+static void appendVarint(QByteArray &out, quint32 value) {
+    while (value >= 0x80) {
+        out.append(char((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.append(char(value));
+}
+
+static int sharedPrefix(const QByteArray &a, const QByteArray &b) {
+    int limit = qMin(a.size(), b.size());
+    int n = 0;
+    while (n < limit && a[n] == b[n])
+        ++n;
+    return n;
+}
+
+bool FrontCodedNames::readVarint(const QByteArray &data, int &pos, quint32 &value) {
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (pos >= data.size())
+            return false;
+        quint8 byte = quint8(data[pos++]);
+        value |= quint32(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;   // 32 bite sığmayan değer
+}
+
+bool FrontCodedNames::readEntry(const QByteArray &data, int &pos, QByteArray &current) {
+    quint32 shared, length;
+    if (!readVarint(data, pos, shared) || !readVarint(data, pos, length)
+        || shared > quint32(current.size()) || length > quint32(data.size() - pos))
+        return false;
+    current.truncate(int(shared));
+    current.append(data.constData() + pos, int(length));
+    pos += int(length);
+    return true;
+}
+
+void FrontCodedNames::build(const QVector<QByteArray> &sortedNames) {
+    clear();
+    m_count = sortedNames.size();
+    m_restarts.reserve((m_count + RestartInterval - 1) / RestartInterval);
+
+    for (int i = 0; i < m_count; ++i) {
+        const QByteArray &name = sortedNames[i];
+        int shared = 0;
+        if (i % RestartInterval == 0)
+            m_restarts.append(quint32(m_data.size()));
+        else
+            shared = sharedPrefix(sortedNames[i - 1], name);
+
+        appendVarint(m_data, quint32(shared));
+        appendVarint(m_data, quint32(name.size() - shared));
+        m_data.append(name.constData() + shared, name.size() - shared);
+    }
+    m_data.squeeze();
+}
+
+void FrontCodedNames::clear() {
+    m_data.clear();
+    m_restarts.clear();
+    m_count = 0;
+}
+
+QByteArray FrontCodedNames::restartName(int block) const {
+    int pos = int(m_restarts[block]);
+    QByteArray name;
+    readEntry(m_data, pos, name);   // ortak ön ek: yeniden başlama noktasında her zaman 0
+    return name;
+}
+
+QByteArray FrontCodedNames::at(int index) const {
+    int pos = int(m_restarts[index / RestartInterval]);
+    QByteArray current;
+    for (int i = 0; i <= index % RestartInterval; ++i) {
+        if (!readEntry(m_data, pos, current))
+            return QByteArray();
+    }
+    return current;
+}
+
+int FrontCodedNames::lowerBound(const QByteArray &name) const {
+    if (m_count == 0)
+        return 0;
+
+    // İlk adı name'den büyük olan bloktan önceki blok adayı içerir
+    int low = 0, high = m_restarts.size();
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (restartName(mid) <= name)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    int block = qMax(0, low - 1);
+
+    int pos = int(m_restarts[block]);
+    int index = block * RestartInterval;
+    int end = qMin(index + RestartInterval, m_count);
+    QByteArray current;
+    for (; index < end; ++index) {
+        if (!readEntry(m_data, pos, current))
+            break;
+        if (!(current < name))
+            return index;
+    }
+    return end;
+}
+
+int FrontCodedNames::indexOf(const QByteArray &name) const {
+    int index = lowerBound(name);
+    return index < m_count && at(index) == name ? index : -1;
+}
+
+QDataStream &operator<<(QDataStream &stream, const FrontCodedNames &names) {
+    return stream << qint32(names.m_count) << names.m_restarts << names.m_data;
+}
+
+QDataStream &operator>>(QDataStream &stream, FrontCodedNames &names) {
+    qint32 count;
+    stream >> count;
+    readVector(stream, names.m_restarts);
+    stream >> names.m_data;
+    names.m_count = count;
+    // Her girdi en az iki varint baytıdır; blok başlangıçları forEach ile doğrulanır
+    if (count < 0 || qint64(count) * 2 > names.m_data.size()
+        || names.m_restarts.size() != (count + FrontCodedNames::RestartInterval - 1) / FrontCodedNames::RestartInterval) {
+        names.clear();
+        stream.setStatus(QDataStream::ReadCorruptData);
+    }
+    return stream;
+}
+
+
+void NameIndex::build(const StringPool &strings) {
+    QVector<QByteArray> utf8(strings.size());
+    for (int id = 0; id < strings.size(); ++id)
+        utf8[id] = strings.at(quint32(id)).toUtf8();
+
+    m_ids.resize(strings.size());
+    std::iota(m_ids.begin(), m_ids.end(), 0u);
+    std::sort(m_ids.begin(), m_ids.end(), [&utf8](quint32 a, quint32 b) {
+        return utf8[int(a)] < utf8[int(b)];
+    });
+
+    QVector<QByteArray> sorted;
+    sorted.reserve(m_ids.size());
+    for (quint32 id : m_ids)
+        sorted.append(utf8[int(id)]);
+    m_names.build(sorted);
+}
+
+void NameIndex::clear() {
+    m_names.clear();
+    m_ids.clear();
+}
+
+quint32 NameIndex::find(const QString &name) const {
+    int index = m_names.indexOf(name.toUtf8());
+    return index >= 0 ? m_ids[index] : StringPool::npos;
+}
+
+QVector<quint32> NameIndex::withPrefix(const QString &prefix) const {
+    QVector<quint32> ids;
+    QByteArray key = prefix.toUtf8();
+    for (int i = m_names.lowerBound(key); i < m_names.count(); ++i) {
+        if (!m_names.at(i).startsWith(key))
+            break;
+        ids.append(m_ids[i]);
+    }
+    return ids;
+}
+
+bool NameIndex::decode(QVector<QString> &byId) const {
+    // Her kimlik tam bir kez geçmeli; aksi hâlde byId dışına yazılırdı
+    const int count = m_ids.size();
+    QBitArray seen(count);
+    for (quint32 id : m_ids) {
+        if (id >= quint32(count) || seen.testBit(int(id)))
+            return false;
+        seen.setBit(int(id));
+    }
+
+    byId.resize(count);
+    bool intact = m_names.forEach([this, &byId](int index, const QByteArray &name) {
+        byId[int(m_ids[index])] = QString::fromUtf8(name);
+    });
+    if (!intact)
+        byId.clear();
+    return intact;
+}
+
+QDataStream &operator<<(QDataStream &stream, const NameIndex &index) {
+    return stream << index.m_names << index.m_ids;
+}
+
+QDataStream &operator>>(QDataStream &stream, NameIndex &index) {
+    stream >> index.m_names;
+    readVector(stream, index.m_ids);
+    if (index.m_ids.size() != index.m_names.count()) {
+        index.clear();
+        stream.setStatus(QDataStream::ReadCorruptData);
+    }
+    return stream;
+}
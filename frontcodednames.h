@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QByteArray>
+#include <QVector>
+#include "mapmodel.h"
+
+class QDataStream;
+
+// Sıralı ad listesi için ön ek sıkıştırmalı (front-coded) depolama.
+// Mangled C++ adları uzun ön ekleri paylaşır (_ZN4core3hal...): her girdi
+// yalnızca bir öncekiyle ortak ön ekin uzunluğunu ve kalan son eki tutar.
+// Her RestartInterval girdide bir tam ad yazılır; ikili arama bu yeniden
+// başlama noktaları üzerinde yapılır, ardından tek bir blok çözülür.
+class FrontCodedNames {
+public:
+    static const int RestartInterval = 16;
+
+    // Adlar UTF-8 bayt sırasına göre sıralı olmalı
+    void build(const QVector<QByteArray> &sortedNames);
+    void clear();
+
+    int count() const { return m_count; }
+    QByteArray at(int index) const;
+    // name'den küçük olmayan ilk girdinin indeksi (yoksa count())
+    int lowerBound(const QByteArray &name) const;
+    // Tam eşleşmenin indeksi, yoksa -1
+    int indexOf(const QByteArray &name) const;
+    // Tüm adları sırayla tek geçişte çözer. Veri veya yeniden başlama
+    // noktaları bozuksa false döner; diskten okunan liste bununla doğrulanır.
+    template <typename Visitor> bool forEach(Visitor visit) const;
+
+    // Sıkıştırılmış verinin bellekteki boyutu
+    qint64 byteSize() const { return m_data.size() + qint64(m_restarts.size()) * sizeof(quint32); }
+
+    friend QDataStream &operator<<(QDataStream &stream, const FrontCodedNames &names);
+    friend QDataStream &operator>>(QDataStream &stream, FrontCodedNames &names);
+
+private:
+    static bool readVarint(const QByteArray &data, int &pos, quint32 &value);
+    // Girdiyi current üzerine uygular; veri bozuksa false
+    static bool readEntry(const QByteArray &data, int &pos, QByteArray &current);
+    QByteArray restartName(int block) const;
+
+    QByteArray m_data;
+    QVector<quint32> m_restarts;   // her bloğun m_data içindeki başlangıcı
+    int m_count = 0;
+};
+
+template <typename Visitor>
+bool FrontCodedNames::forEach(Visitor visit) const {
+    int pos = 0;
+    QByteArray current;
+    for (int i = 0; i < m_count; ++i) {
+        if (i % RestartInterval == 0) {
+            if (m_restarts[i / RestartInterval] != quint32(pos))
+                return false;
+            current.clear();   // yeniden başlama noktasında ortak ön ek 0 olmalı
+        }
+        if (!readEntry(m_data, pos, current))
+            return false;
+        visit(i, current);
+    }
+    return pos == m_data.size();
+}
+
+// StringPool'un sıralı, ön ek sıkıştırmalı dizini. Model kaydının ad bölümü
+// de bu biçimde yazılır; kayıttan yüklenen havuz aramaları bunun üzerinden yapar.
+class NameIndex {
+public:
+    void build(const StringPool &strings);
+    void clear();
+
+    int count() const { return m_names.count(); }
+    // Adın string kimliği, yoksa StringPool::npos
+    quint32 find(const QString &name) const;
+    // Ön eki taşıyan tüm adların kimlikleri (sıralı ad düzeninde)
+    QVector<quint32> withPrefix(const QString &prefix) const;
+
+    // Adları kimlik sırasıyla çözer. Kimlikler [0, count()) aralığının bir
+    // permütasyonu değilse veya adlar bozuksa false döner.
+    bool decode(QVector<QString> &byId) const;
+
+    const FrontCodedNames &names() const { return m_names; }
+
+    friend QDataStream &operator<<(QDataStream &stream, const NameIndex &index);
+    friend QDataStream &operator>>(QDataStream &stream, NameIndex &index);
+
+private:
+    FrontCodedNames m_names;
+    QVector<quint32> m_ids;   // sıralı konum → string kimliği
+};
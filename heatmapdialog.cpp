@@ -0,0 +1,72 @@
+#include "heatmapdialog.h"
+#include "heatmapview.h"
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+HeatmapDialog::HeatmapDialog(const MapModel &model, const QVector<MemoryRegion> &regions, QWidget *parent)
+    : QDialog(parent), m_model(model), m_regions(regions)
+{
+    setWindowTitle("Adres Alanı Isı Haritası");
+    setMinimumSize(900, 650);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    QHBoxLayout *controls = new QHBoxLayout();
+
+    regionCombo = new QComboBox(this);
+    for (const MemoryRegion &region : m_regions)
+        regionCombo->addItem(QString("%1 (%2 KB)").arg(region.name).arg(region.length / 1024));
+    modeCombo = new QComboBox(this);
+    modeCombo->addItem("Bölüm türüne göre");
+    modeCombo->addItem("Arşive göre");
+    QPushButton *fitButton = new QPushButton("Sığdır", this);
+
+    controls->addWidget(new QLabel("Bölge:", this));
+    controls->addWidget(regionCombo);
+    controls->addWidget(new QLabel("Renk:", this));
+    controls->addWidget(modeCombo);
+    controls->addStretch();
+    controls->addWidget(fitButton);
+    layout->addLayout(controls);
+
+    legendLabel = new QLabel(this);
+    legendLabel->setWordWrap(true);
+    layout->addWidget(legendLabel);
+
+    view = new HeatmapView(this);
+    layout->addWidget(view, 1);
+
+    statusLabel = new QLabel("Tekerlek: yakınlaştır, sürükle: kaydır", this);
+    statusLabel->setStyleSheet("font-family: monospace;");
+    layout->addWidget(statusLabel);
+
+    connect(regionCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &HeatmapDialog::rebuild);
+    connect(modeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &HeatmapDialog::rebuild);
+    connect(fitButton, &QPushButton::clicked, view, &HeatmapView::fitToView);
+    connect(view, &HeatmapView::hovered, this, [this](const QString &description) {
+        if (!description.isEmpty())
+            statusLabel->setText(description);
+    });
+
+    rebuild();
+}
+
+void HeatmapDialog::rebuild() {
+    int region = regionCombo->currentIndex();
+    if (region < 0 || region >= m_regions.size())
+        return;
+
+    OccupancyMap::ColorMode mode = modeCombo->currentIndex() == 1 ? OccupancyMap::ByArchive
+                                                                  : OccupancyMap::BySectionType;
+    QSharedPointer<const OccupancyMap> map(new OccupancyMap(m_model, m_regions[region], mode));
+
+    QStringList legend;
+    for (int i = 0; i < map->categoryNames().size(); ++i) {
+        legend << QString("<span style='color:%1'>&#9632;</span> %2")
+                  .arg(map->categoryColors()[i].name(), map->categoryNames()[i].toHtmlEscaped());
+    }
+    legendLabel->setText(legend.join("&nbsp;&nbsp; "));
+    view->setMap(map);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QDialog>
+#include <QVector>
+#include "mapmodel.h"
+
+class QComboBox;
+class QLabel;
+class HeatmapView;
+
+// Bölge bölge adres alanı doluluk haritası; bölüm türüne veya arşive göre renklenir
+class HeatmapDialog : public QDialog {
+    Q_OBJECT
+public:
+    HeatmapDialog(const MapModel &model, const QVector<MemoryRegion> &regions, QWidget *parent = nullptr);
+
+private:
+    void rebuild();
+
+    const MapModel &m_model;
+    QVector<MemoryRegion> m_regions;
+    QComboBox *regionCombo;
+    QComboBox *modeCombo;
+    QLabel *legendLabel;
+    QLabel *statusLabel;
+    HeatmapView *view;
+};
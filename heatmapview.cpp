@@ -0,0 +1,193 @@
+#include "heatmapview.h"
+#include <QFutureWatcher>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QResizeEvent>
+#include <QWheelEvent>
+#include <QtConcurrent/QtConcurrentRun>
+#include <cmath>
+
+// 256 x 256 ARGB döşeme 256 KB; önbellek ~64 MB ile sınırlı
+static const int MaxCachedTiles = 256;
+// Bu sayıdan az döşemeli seviyeler harita yüklenince hemen üretilir
+static const int PrecomputeTileLimit = 64;
+static const double MaxScale = 32.0;
+
+HeatmapView::HeatmapView(QWidget *parent)
+    : QWidget(parent), m_tiles(MaxCachedTiles)
+{
+    setMouseTracking(true);
+    setMinimumSize(400, 300);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+quint64 HeatmapView::tileKey(int level, int tileX, int tileY) {
+    return (quint64(level) << 56) | (quint64(tileY) << 28) | quint64(tileX);
+}
+
+void HeatmapView::setMap(QSharedPointer<const OccupancyMap> map) {
+    m_map = map;
+    m_tiles.clear();
+    m_pending.clear();
+    ++m_generation;
+
+    if (m_map) {
+        // Kaba seviyeler baştan hazır olsun: her yakınlaştırmada gösterilecek bir yedek bulunur
+        for (int level = m_map->maxLevel(); level >= 0; --level) {
+            if (m_map->tilesX(level) * m_map->tilesY(level) > PrecomputeTileLimit)
+                break;
+            for (int ty = 0; ty < m_map->tilesY(level); ++ty) {
+                for (int tx = 0; tx < m_map->tilesX(level); ++tx)
+                    requestTile(level, tx, ty);
+            }
+        }
+    }
+    fitToView();
+}
+
+void HeatmapView::fitToView() {
+    if (!m_map) {
+        update();
+        return;
+    }
+    m_scale = qMin(width() / double(m_map->gridWidth()), height() / double(m_map->gridHeight()));
+    m_origin = QPointF(0, 0);
+    m_userMoved = false;
+    update();
+}
+
+int HeatmapView::currentLevel() const {
+    // Döşeme pikseli ekranda en az 1 piksel olacak şekilde en ince seviye
+    int level = m_scale >= 1.0 ? 0 : int(std::floor(std::log2(1.0 / m_scale)));
+    return qBound(0, level, m_map->maxLevel());
+}
+
+const QImage *HeatmapView::cachedTile(int level, int tileX, int tileY) const {
+    return m_tiles.object(tileKey(level, tileX, tileY));
+}
+
+void HeatmapView::requestTile(int level, int tileX, int tileY) {
+    quint64 key = tileKey(level, tileX, tileY);
+    if (m_pending.contains(key) || m_tiles.contains(key))
+        return;
+    m_pending.insert(key);
+
+    QSharedPointer<const OccupancyMap> map = m_map;
+    int generation = m_generation;
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, key, generation]() {
+        watcher->deleteLater();
+        if (generation != m_generation)
+            return;
+        m_pending.remove(key);
+        m_tiles.insert(key, new QImage(watcher->result()));
+        update();
+    });
+    watcher->setFuture(QtConcurrent::run([map, level, tileX, tileY]() {
+        return map->renderTile(level, tileX, tileY);
+    }));
+}
+
+void HeatmapView::drawFallback(QPainter &painter, const QRectF &target, int level, int tileX, int tileY) {
+    // Hazır olan ilk üst seviye döşemenin ilgili çeyreği büyütülür
+    for (int parent = level + 1; parent <= m_map->maxLevel(); ++parent) {
+        int shift = parent - level;
+        const QImage *image = cachedTile(parent, tileX >> shift, tileY >> shift);
+        if (!image)
+            continue;
+        double size = double(OccupancyMap::TileSize) / double(1 << shift);
+        QRectF source((tileX & ((1 << shift) - 1)) * size, (tileY & ((1 << shift) - 1)) * size, size, size);
+        painter.drawImage(target, *image, source);
+        return;
+    }
+}
+
+void HeatmapView::paintEvent(QPaintEvent *) {
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(44, 62, 80));
+    if (!m_map)
+        return;
+
+    int level = currentLevel();
+    double tileCells = double(quint64(OccupancyMap::TileSize) << level);
+    double tileOnScreen = tileCells * m_scale;
+
+    int firstX = qMax(0, int(std::floor(m_origin.x() / tileCells)));
+    int firstY = qMax(0, int(std::floor(m_origin.y() / tileCells)));
+    int lastX = qMin(m_map->tilesX(level) - 1, int(std::floor((m_origin.x() + width() / m_scale) / tileCells)));
+    int lastY = qMin(m_map->tilesY(level) - 1, int(std::floor((m_origin.y() + height() / m_scale) / tileCells)));
+
+    for (int ty = firstY; ty <= lastY; ++ty) {
+        for (int tx = firstX; tx <= lastX; ++tx) {
+            QRectF target((tx * tileCells - m_origin.x()) * m_scale, (ty * tileCells - m_origin.y()) * m_scale,
+                          tileOnScreen, tileOnScreen);
+            if (const QImage *image = cachedTile(level, tx, ty)) {
+                painter.drawImage(target, *image);
+            } else {
+                requestTile(level, tx, ty);
+                drawFallback(painter, target, level, tx, ty);
+            }
+        }
+    }
+
+    // Bölge sınırı
+    painter.setPen(QColor(189, 195, 199));
+    painter.drawRect(QRectF(-m_origin.x() * m_scale, -m_origin.y() * m_scale,
+                            m_map->gridWidth() * m_scale, m_map->gridHeight() * m_scale));
+}
+
+void HeatmapView::wheelEvent(QWheelEvent *event) {
+    if (!m_map)
+        return;
+
+    // İmlecin altındaki hücre yerinde kalır
+    QPointF cursor = event->posF();
+    QPointF anchor = m_origin + cursor / m_scale;
+    double factor = std::pow(1.25, event->angleDelta().y() / 120.0);
+    double minScale = 0.5 * qMin(width() / double(m_map->gridWidth()), height() / double(m_map->gridHeight()));
+    m_scale = qBound(minScale, m_scale * factor, MaxScale);
+    m_origin = anchor - cursor / m_scale;
+    m_userMoved = true;
+    update();
+    event->accept();
+}
+
+void HeatmapView::mousePressEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        m_dragging = true;
+        m_dragStart = event->pos();
+        setCursor(Qt::ClosedHandCursor);
+    }
+}
+
+void HeatmapView::mouseMoveEvent(QMouseEvent *event) {
+    if (!m_map)
+        return;
+
+    if (m_dragging) {
+        m_origin -= QPointF(event->pos() - m_dragStart) / m_scale;
+        m_dragStart = event->pos();
+        m_userMoved = true;
+        update();
+    }
+
+    QPointF cell = m_origin + QPointF(event->pos()) / m_scale;
+    quint64 address;
+    if (cell.x() >= 0 && cell.y() >= 0 && m_map->addressAt(quint64(cell.x()), quint64(cell.y()), &address))
+        emit hovered(m_map->describe(address));
+    else
+        emit hovered(QString());
+}
+
+void HeatmapView::mouseReleaseEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        m_dragging = false;
+        unsetCursor();
+    }
+}
+
+void HeatmapView::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    if (!m_userMoved)
+        fitToView();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QCache>
+#include <QImage>
+#include <QSet>
+#include <QSharedPointer>
+#include <QWidget>
+#include "occupancymap.h"
+
+// OccupancyMap döşemelerini QImage önbelleğinden çizer. Görünür döşemeler ve
+// kaba seviyeler iş parçacıklarında üretilir; hazır olmayan döşemenin yerine
+// üst seviyedeki döşeme büyütülerek gösterilir. Tekerlek: yakınlaştır, sürükle: kaydır.
+class HeatmapView : public QWidget {
+    Q_OBJECT
+public:
+    explicit HeatmapView(QWidget *parent = nullptr);
+
+    void setMap(QSharedPointer<const OccupancyMap> map);
+    void fitToView();
+
+signals:
+    void hovered(const QString &description);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    static quint64 tileKey(int level, int tileX, int tileY);
+    int currentLevel() const;
+    const QImage *cachedTile(int level, int tileX, int tileY) const;
+    void requestTile(int level, int tileX, int tileY);
+    void drawFallback(QPainter &painter, const QRectF &target, int level, int tileX, int tileY);
+
+    QSharedPointer<const OccupancyMap> m_map;
+    QCache<quint64, QImage> m_tiles;
+    QSet<quint64> m_pending;
+    int m_generation = 0;       // harita değişince eski iş sonuçları atılır
+
+    double m_scale = 1.0;       // ekran pikseli / ızgara hücresi
+    QPointF m_origin;           // sol üst köşedeki ızgara koordinatı
+    QPoint m_dragStart;
+    bool m_dragging = false;
+    bool m_userMoved = false;   // kullanıcı yakınlaştırmadıysa boyut değişince yeniden sığdırılır
+};
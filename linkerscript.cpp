@@ -0,0 +1,928 @@
+#include "linkerscript.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QTextStream>
+
+namespace {
+
+// Sabit katlama sonucu; bağlamadan önce bilinemeyen değerler known = false taşır
+struct Value {
+    quint64 v = 0;
+    bool known = false;
+};
+
+Value knownValue(quint64 v) {
+    Value value;
+    value.v = v;
+    value.known = true;
+    return value;
+}
+
+quint64 alignUp(quint64 value, quint64 alignment) {
+    return alignment > 0 ? (value + alignment - 1) / alignment * alignment : value;
+}
+
+struct BinaryOp {
+    const char *text;
+    int level;
+};
+
+// Uzun işleçler önce: "<<" "<" ile, "||" "|" ile karışmasın
+const BinaryOp binaryOps[] = {
+    { "||", 0 }, { "&&", 1 }, { "<<", 7 }, { ">>", 7 }, { "<=", 6 }, { ">=", 6 },
+    { "==", 5 }, { "!=", 5 }, { "|", 2 }, { "^", 3 }, { "&", 4 }, { "<", 6 }, { ">", 6 },
+    { "+", 8 }, { "-", 8 }, { "*", 9 }, { "/", 9 }, { "%", 9 },
+};
+
+const char *const assignOps[] = { "<<=", ">>=", "+=", "-=", "*=", "/=", "&=", "|=", "=" };
+
+const int MaxIncludeDepth = 16;
+
+class ScriptParser {
+public:
+    ScriptParser(const QString &text, const QString &dir, LinkerScript &script, int depth)
+        : m_text(text), m_dir(dir), m_script(script), m_depth(depth) {}
+
+    bool parseTopLevel() {
+        while (m_error.isEmpty()) {
+            skipSpace();
+            if (atEnd())
+                break;
+            if (accept(';'))
+                continue;
+            parseTopStatement();
+        }
+        return m_error.isEmpty();
+    }
+
+    // INCLUDE ile SECTIONS içine eklenen dosya: süslü parantez olmadan bölüm listesi
+    bool parseSectionList() {
+        while (m_error.isEmpty()) {
+            skipSpace();
+            if (atEnd())
+                break;
+            parseSectionsStatement();
+        }
+        return m_error.isEmpty();
+    }
+
+    QString error() const { return m_error; }
+
+private:
+    // --- sözcük düzeyi ---
+
+    bool atEnd() const { return m_pos >= m_text.size(); }
+    QChar peek(int offset = 0) const {
+        return m_pos + offset < m_text.size() ? m_text[m_pos + offset] : QChar();
+    }
+
+    void skipSpace() {
+        while (!atEnd()) {
+            if (m_text[m_pos].isSpace()) {
+                ++m_pos;
+            } else if (peek() == '/' && peek(1) == '*') {
+                int end = m_text.indexOf("*/", m_pos + 2);
+                m_pos = end < 0 ? m_text.size() : end + 2;
+            } else {
+                break;
+            }
+        }
+    }
+
+    bool accept(QChar c) {
+        skipSpace();
+        if (peek() != c)
+            return false;
+        ++m_pos;
+        return true;
+    }
+
+    bool lookingAt(const char *text) {
+        skipSpace();
+        return m_text.midRef(m_pos).startsWith(QLatin1String(text));
+    }
+
+    bool expect(QChar c) {
+        if (accept(c))
+            return true;
+        fail(QString("'%1' bekleniyor").arg(c));
+        return false;
+    }
+
+    static bool isIdentifierStart(QChar c) { return c.isLetter() || c == '_' || c == '.' || c == '$'; }
+    static bool isIdentifierChar(QChar c) { return c.isLetterOrNumber() || c == '_' || c == '.' || c == '$'; }
+
+    QString readIdentifier() {
+        skipSpace();
+        int start = m_pos;
+        if (!atEnd() && isIdentifierStart(m_text[m_pos])) {
+            while (!atEnd() && isIdentifierChar(m_text[m_pos]))
+                ++m_pos;
+        }
+        return m_text.mid(start, m_pos - start);
+    }
+
+    // Çıkış bölümü adları ("/DISCARD/", ".ARM.exidx") ve dosya adları
+    QString readName() {
+        skipSpace();
+        if (peek() == '"') {
+            int end = m_text.indexOf('"', m_pos + 1);
+            if (end < 0) {
+                fail("Kapanmamış tırnak");
+                return QString();
+            }
+            QString name = m_text.mid(m_pos + 1, end - m_pos - 1);
+            m_pos = end + 1;
+            return name;
+        }
+        int start = m_pos;
+        static const QString stops = QStringLiteral("(){};:,=");
+        while (!atEnd() && !m_text[m_pos].isSpace() && !stops.contains(m_text[m_pos]))
+            ++m_pos;
+        return m_text.mid(start, m_pos - start);
+    }
+
+    // '(' üzerindeyken eşleşen ')' sonrasına geçer
+    void skipBalanced() {
+        if (!expect('('))
+            return;
+        int depth = 1;
+        while (!atEnd() && depth > 0) {
+            QChar c = m_text[m_pos++];
+            if (c == '(')
+                ++depth;
+            else if (c == ')')
+                --depth;
+        }
+        if (depth > 0)
+            fail("')' bekleniyor");
+    }
+
+    void fail(const QString &message) {
+        if (m_error.isEmpty())
+            m_error = QString("satır %1: %2").arg(m_text.leftRef(m_pos).count('\n') + 1).arg(message);
+    }
+
+    // --- ifadeler ---
+
+    Value parseExpression() {
+        Value condition = parseBinary(0);
+        if (!accept('?'))
+            return condition;
+        Value whenTrue = parseExpression();
+        expect(':');
+        Value whenFalse = parseExpression();
+        if (!condition.known)
+            return Value();
+        return condition.v ? whenTrue : whenFalse;
+    }
+
+    int peekBinary() {
+        skipSpace();
+        QStringRef rest = m_text.midRef(m_pos);
+        for (int i = 0; i < int(sizeof(binaryOps) / sizeof(binaryOps[0])); ++i) {
+            QLatin1String op(binaryOps[i].text);
+            if (!rest.startsWith(op))
+                continue;
+            // "+=" ve "<<=" atamadır, ikili işleç değil
+            bool comparison = op == QLatin1String("==") || op == QLatin1String("!=")
+                              || op == QLatin1String("<=") || op == QLatin1String(">=");
+            if (!comparison && rest.size() > op.size() && rest.at(op.size()) == '=')
+                return -1;
+            return i;
+        }
+        return -1;
+    }
+
+    Value parseBinary(int minLevel) {
+        Value left = parseUnary();
+        while (m_error.isEmpty()) {
+            int index = peekBinary();
+            if (index < 0 || binaryOps[index].level < minLevel)
+                break;
+            const char *op = binaryOps[index].text;
+            m_pos += int(qstrlen(op));
+            Value right = parseBinary(binaryOps[index].level + 1);
+            left = applyBinary(op, left, right);
+        }
+        return left;
+    }
+
+    static Value applyBinary(const char *text, Value a, Value b) {
+        if (!a.known || !b.known)
+            return Value();
+        QLatin1String op(text);
+        quint64 x = a.v, y = b.v;
+        if (op == QLatin1String("+"))  return knownValue(x + y);
+        if (op == QLatin1String("-"))  return knownValue(x - y);
+        if (op == QLatin1String("*"))  return knownValue(x * y);
+        if (op == QLatin1String("/"))  return y ? knownValue(x / y) : Value();
+        if (op == QLatin1String("%"))  return y ? knownValue(x % y) : Value();
+        if (op == QLatin1String("<<")) return knownValue(y < 64 ? x << y : 0);
+        if (op == QLatin1String(">>")) return knownValue(y < 64 ? x >> y : 0);
+        if (op == QLatin1String("&"))  return knownValue(x & y);
+        if (op == QLatin1String("|"))  return knownValue(x | y);
+        if (op == QLatin1String("^"))  return knownValue(x ^ y);
+        if (op == QLatin1String("&&")) return knownValue(x && y);
+        if (op == QLatin1String("||")) return knownValue(x || y);
+        if (op == QLatin1String("==")) return knownValue(x == y);
+        if (op == QLatin1String("!=")) return knownValue(x != y);
+        if (op == QLatin1String("<"))  return knownValue(x < y);
+        if (op == QLatin1String("<=")) return knownValue(x <= y);
+        if (op == QLatin1String(">"))  return knownValue(x > y);
+        if (op == QLatin1String(">=")) return knownValue(x >= y);
+        return Value();
+    }
+
+    Value parseUnary() {
+        skipSpace();
+        QChar c = peek();
+        if ((c == '-' || c == '~' || c == '!' || c == '+') && peek(1) != '=') {
+            ++m_pos;
+            Value operand = parseUnary();
+            if (!operand.known)
+                return operand;
+            if (c == '-')
+                return knownValue(quint64(0) - operand.v);
+            if (c == '~')
+                return knownValue(~operand.v);
+            if (c == '!')
+                return knownValue(!operand.v);
+            return operand;
+        }
+        return parsePrimary();
+    }
+
+    Value parseNumber() {
+        int start = m_pos;
+        while (!atEnd() && m_text[m_pos].isLetterOrNumber())
+            ++m_pos;
+        QString token = m_text.mid(start, m_pos - start).toLower();
+
+        // k/m onaltılık rakam değildir: 0x10K de geçerlidir
+        quint64 scale = 1;
+        bool hex = token.startsWith("0x");
+        if (token.endsWith('k') || token.endsWith('m')) {
+            scale = token.endsWith('k') ? 1024 : 1024 * 1024;
+            token.chop(1);
+        }
+
+        bool ok;
+        quint64 value;
+        if (hex)
+            value = token.mid(2).toULongLong(&ok, 16);
+        else if (token.size() > 1 && token.startsWith('0'))
+            value = token.mid(1).toULongLong(&ok, 8);   // ld: baştaki 0 sekizlik taban
+        else
+            value = token.toULongLong(&ok, 10);
+
+        if (!ok) {
+            fail(QString("Geçersiz sayı: %1").arg(token));
+            return Value();
+        }
+        return knownValue(value * scale);
+    }
+
+    Value parsePrimary() {
+        skipSpace();
+        if (accept('(')) {
+            Value inner = parseExpression();
+            expect(')');
+            return inner;
+        }
+        if (peek().isDigit())
+            return parseNumber();
+
+        QString name = readIdentifier();
+        if (name.isEmpty()) {
+            fail(atEnd() ? QString("İfade bekleniyor") : QString("Beklenmeyen karakter: '%1'").arg(peek()));
+            return Value();
+        }
+        if (name == ".")
+            return m_dot;
+        if (accept('('))
+            return callFunction(name);
+
+        auto it = m_script.symbols.constFind(name);
+        return it != m_script.symbols.constEnd() ? knownValue(it.value()) : Value();
+    }
+
+    // '(' okunmuş durumda çağrılır, ')' dahil tüketir
+    Value callFunction(const QString &name) {
+        QString upper = name.toUpper();
+
+        if (upper == "ORIGIN" || upper == "ORG" || upper == "LENGTH" || upper == "LEN") {
+            QString region = readIdentifier();
+            expect(')');
+            int index = m_script.regionIndex(region);
+            if (index < 0)
+                return Value();
+            const MemoryRegion &r = m_script.regions[index];
+            return knownValue(upper.startsWith("OR") ? r.origin : r.length);
+        }
+        if (upper == "DEFINED") {
+            QString symbol = readIdentifier();
+            expect(')');
+            return knownValue(m_defined.contains(symbol));
+        }
+        if (upper == "ADDR") {
+            QString section = readName();
+            expect(')');
+            const ScriptSection *s = m_script.section(section);
+            return s && s->hasAddress ? knownValue(s->address) : Value();
+        }
+        if (upper == "CONSTANT") {
+            QString constant = readIdentifier().toUpper();
+            expect(')');
+            if (constant == "MAXPAGESIZE" || constant == "COMMONPAGESIZE")
+                return knownValue(0x1000);
+            return Value();
+        }
+
+        QVector<Value> args;
+        if (!accept(')')) {
+            do {
+                args.append(parseExpression());
+            } while (m_error.isEmpty() && accept(','));
+            expect(')');
+        }
+
+        auto allKnown = [&args]() {
+            for (const Value &arg : args) {
+                if (!arg.known)
+                    return false;
+            }
+            return true;
+        };
+
+        if ((upper == "ALIGN" || upper == "NEXT") && args.size() == 1) {
+            if (!m_dot.known || !args[0].known)
+                return Value();
+            return knownValue(alignUp(m_dot.v, args[0].v));
+        }
+        if (upper == "ALIGN" && args.size() == 2)
+            return allKnown() ? knownValue(alignUp(args[0].v, args[1].v)) : Value();
+        if ((upper == "MAX" || upper == "MIN") && args.size() == 2 && allKnown())
+            return knownValue(upper == "MAX" ? qMax(args[0].v, args[1].v) : qMin(args[0].v, args[1].v));
+        if (upper == "ABSOLUTE" && args.size() == 1)
+            return args[0];
+        if (upper == "SEGMENT_START" && args.size() == 2)
+            return args[1];
+        if (upper == "LOG2CEIL" && args.size() == 1 && args[0].known) {
+            quint64 result = 0;
+            while ((quint64(1) << result) < args[0].v && result < 63)
+                ++result;
+            return knownValue(result);
+        }
+        // SIZEOF, LOADADDR, ALIGNOF ...: bağlamadan önce bilinemez
+        return Value();
+    }
+
+    // --- atamalar ---
+
+    const char *peekAssignment() {
+        skipSpace();
+        QStringRef rest = m_text.midRef(m_pos);
+        for (const char *op : assignOps) {
+            if (!rest.startsWith(QLatin1String(op)))
+                continue;
+            if (qstrcmp(op, "=") == 0 && rest.startsWith(QLatin1String("==")))
+                return nullptr;
+            return op;
+        }
+        return nullptr;
+    }
+
+    void parseAssignment(const QString &symbol, const char *op, bool provide) {
+        m_pos += int(qstrlen(op));
+        Value value = parseExpression();
+        if (!m_error.isEmpty())
+            return;
+
+        // PROVIDE yalnızca başka yerde tanımlanmamış sembolü tanımlar
+        if (provide && m_defined.contains(symbol))
+            return;
+
+        if (qstrcmp(op, "=") != 0) {
+            Value current = symbol == "." ? m_dot : Value();
+            if (symbol != ".") {
+                auto it = m_script.symbols.constFind(symbol);
+                if (it != m_script.symbols.constEnd())
+                    current = knownValue(it.value());
+            }
+            QByteArray binary(op);
+            binary.chop(1);
+            value = applyBinary(binary.constData(), current, value);
+        }
+
+        if (symbol == ".") {
+            m_dot = value;
+            return;
+        }
+        m_defined.insert(symbol);
+        if (value.known)
+            m_script.symbols.insert(symbol, value.v);
+        else
+            m_script.symbols.remove(symbol);
+    }
+
+    // PROVIDE(sym = expr) / PROVIDE_HIDDEN / HIDDEN
+    void parseProvide(bool provide) {
+        if (!expect('('))
+            return;
+        QString symbol = readIdentifier();
+        const char *op = peekAssignment();
+        if (symbol.isEmpty() || !op) {
+            fail("Atama bekleniyor");
+            return;
+        }
+        parseAssignment(symbol, op, provide);
+        expect(')');
+        accept(';');
+    }
+
+    bool isProvide(const QString &word) const {
+        return word == "PROVIDE" || word == "PROVIDE_HIDDEN" || word == "HIDDEN";
+    }
+
+    // --- komutlar ---
+
+    void parseTopStatement() {
+        QString word = readIdentifier();
+        if (word.isEmpty()) {
+            fail(QString("Beklenmeyen karakter: '%1'").arg(peek()));
+            return;
+        }
+
+        if (const char *op = peekAssignment()) {
+            parseAssignment(word, op, false);
+            accept(';');
+        } else if (word == "MEMORY") {
+            parseMemory();
+        } else if (word == "SECTIONS") {
+            if (!expect('{'))
+                return;
+            while (m_error.isEmpty() && !accept('}')) {
+                if (atEnd()) {
+                    fail("SECTIONS için '}' bekleniyor");
+                    return;
+                }
+                parseSectionsStatement();
+            }
+        } else if (word == "ENTRY") {
+            expect('(');
+            m_script.entry = readIdentifier();
+            expect(')');
+        } else if (word == "REGION_ALIAS") {
+            expect('(');
+            QString alias = readName();
+            expect(',');
+            QString region = readIdentifier();
+            expect(')');
+            m_script.regionAliases.insert(alias, region);
+        } else if (word == "INCLUDE") {
+            include(false);
+        } else if (isProvide(word)) {
+            parseProvide(word == "PROVIDE");
+        } else if (lookingAt("(")) {
+            // OUTPUT_FORMAT, OUTPUT_ARCH, SEARCH_DIR, GROUP, ASSERT ...: bölge hesabını etkilemez
+            skipBalanced();
+        }
+        // FORCE_COMMON_ALLOCATION gibi parametresiz komutlar yok sayılır
+    }
+
+    void parseMemory() {
+        if (!expect('{'))
+            return;
+        while (m_error.isEmpty() && !accept('}')) {
+            MemoryRegion region;
+            region.name = readIdentifier();
+            if (region.name.isEmpty()) {
+                fail("Bölge adı bekleniyor");
+                return;
+            }
+            if (lookingAt("("))
+                skipBalanced();     // (rx), (xrw), (!w)
+            if (!expect(':'))
+                return;
+
+            QString key = readIdentifier().toUpper();
+            if ((key != "ORIGIN" && key != "ORG" && key != "O") || !expect('=')) {
+                fail("ORIGIN bekleniyor");
+                return;
+            }
+            Value origin = parseExpression();
+            accept(',');
+            key = readIdentifier().toUpper();
+            if ((key != "LENGTH" && key != "LEN" && key != "L") || !expect('=')) {
+                fail("LENGTH bekleniyor");
+                return;
+            }
+            Value length = parseExpression();
+            if (!m_error.isEmpty())
+                return;
+            if (!origin.known || !length.known) {
+                fail(QString("%1 bölgesinin sınırları çözülemedi").arg(region.name));
+                return;
+            }
+
+            region.origin = origin.v;
+            region.length = length.v;
+            m_script.regions.append(region);
+        }
+    }
+
+    void parseSectionsStatement() {
+        if (accept(';'))
+            return;
+
+        int start = m_pos;
+        QString word = readIdentifier();
+        if (!word.isEmpty()) {
+            if (const char *op = peekAssignment()) {
+                parseAssignment(word, op, false);
+                accept(';');
+                return;
+            }
+            if (isProvide(word)) {
+                parseProvide(word == "PROVIDE");
+                return;
+            }
+            if (word == "ENTRY") {
+                expect('(');
+                m_script.entry = readIdentifier();
+                expect(')');
+                return;
+            }
+            if (word == "ASSERT") {
+                skipBalanced();
+                accept(';');
+                return;
+            }
+            if (word == "INCLUDE") {
+                include(true);
+                return;
+            }
+            if (word == "OVERLAY") {
+                skipOverlay();
+                return;
+            }
+        }
+
+        m_pos = start;
+        QString name = readName();
+        if (name.isEmpty()) {
+            fail(QString("Beklenmeyen karakter: '%1'").arg(peek()));
+            return;
+        }
+        parseOutputSection(name);
+    }
+
+    bool acceptSectionType(ScriptSection &section) {
+        int start = m_pos;
+        if (!accept('('))
+            return false;
+        QString type = readIdentifier().toUpper();
+        if ((type == "NOLOAD" || type == "DSECT" || type == "COPY" || type == "INFO"
+             || type == "OVERLAY" || type == "READONLY") && accept(')')) {
+            section.noLoad = type != "READONLY";
+            return true;
+        }
+        m_pos = start;
+        return false;
+    }
+
+    // name [address] [(type)] : [AT(lma)] [ALIGN(a)] { ... } [>region] [AT>lma] [:phdr] [=fill] [,]
+    void parseOutputSection(const QString &name) {
+        ScriptSection section;
+        section.name = name;
+
+        skipSpace();
+        if (peek() != ':' && !acceptSectionType(section)) {
+            Value address = parseExpression();
+            section.hasAddress = address.known;
+            section.address = address.v;
+            skipSpace();
+            acceptSectionType(section);
+        }
+        if (!expect(':'))
+            return;
+
+        while (m_error.isEmpty() && !lookingAt("{")) {
+            QString keyword = readIdentifier().toUpper();
+            if (keyword == "AT") {
+                expect('(');
+                Value lma = parseExpression();
+                expect(')');
+                section.hasLoadAddress = lma.known;
+                section.loadAddress = lma.v;
+            } else if (keyword == "ALIGN" || keyword == "SUBALIGN") {
+                expect('(');
+                parseExpression();
+                expect(')');
+            } else if (keyword != "ALIGN_WITH_INPUT" && keyword != "ONLY_IF_RO" && keyword != "ONLY_IF_RW") {
+                fail(QString("%1 bölümü için '{' bekleniyor").arg(name));
+                return;
+            }
+        }
+
+        // Bölüm içinde "." yalnızca sabit adresli bölümün başında bilinir
+        m_dot = section.hasAddress ? knownValue(section.address) : Value();
+        expect('{');
+        parseSectionContents();
+        m_dot = Value();
+        if (!m_error.isEmpty())
+            return;
+
+        while (m_error.isEmpty()) {
+            int start = m_pos;
+            if (accept('>')) {
+                section.region = readIdentifier();
+            } else if (readIdentifier() == "AT" && accept('>')) {
+                section.loadRegion = readIdentifier();
+            } else {
+                m_pos = start;
+                skipSpace();
+                if (peek() == ':' ) {
+                    ++m_pos;
+                    readIdentifier();       // program başlığı
+                } else if (peek() == '=' && peek(1) != '=') {
+                    ++m_pos;
+                    parseExpression();      // dolgu deseni
+                } else {
+                    accept(',');
+                    break;
+                }
+            }
+        }
+
+        if (section.region.isEmpty() && section.hasAddress) {
+            int index = regionIndexOf(m_script.regions, section.address);
+            if (index >= 0)
+                section.region = m_script.regions[index].name;
+        }
+        m_script.sections.append(section);
+    }
+
+    void parseSectionContents() {
+        while (m_error.isEmpty()) {
+            skipSpace();
+            if (atEnd()) {
+                fail("'}' bekleniyor");
+                return;
+            }
+            if (accept('}'))
+                return;
+            if (accept(';'))
+                continue;
+
+            int start = m_pos;
+            QString word = readIdentifier();
+            if (!word.isEmpty()) {
+                if (const char *op = peekAssignment()) {
+                    parseAssignment(word, op, false);
+                    accept(';');
+                    continue;
+                }
+                if (isProvide(word)) {
+                    parseProvide(word == "PROVIDE");
+                    continue;
+                }
+                static const QStringList dataCommands = { "BYTE", "SHORT", "LONG", "QUAD", "SQUAD" };
+                int data = dataCommands.indexOf(word);
+                if (data >= 0) {
+                    static const int widths[] = { 1, 2, 4, 8, 8 };
+                    skipBalanced();
+                    if (m_dot.known)
+                        m_dot.v += quint64(widths[data]);
+                    accept(';');
+                    continue;
+                }
+                if (word == "ASSERT" || word == "FILL") {
+                    skipBalanced();
+                    accept(';');
+                    continue;
+                }
+                if (word == "CREATE_OBJECT_SYMBOLS" || word == "CONSTRUCTORS") {
+                    accept(';');
+                    continue;
+                }
+            }
+
+            // Giriş bölümü deseni: *(.text*), KEEP(*(.isr_vector)), libc.a:*(.data)
+            m_pos = start;
+            skipPattern();
+            m_dot = Value();
+        }
+    }
+
+    // "KEEP (*(.init))" gibi boşluklu desenler iki parçada tüketilir
+    void skipPattern() {
+        int depth = 0;
+        int start = m_pos;
+        while (!atEnd()) {
+            QChar c = m_text[m_pos];
+            if (depth == 0 && (c.isSpace() || c == ';' || c == '}'))
+                break;
+            if (c == '(')
+                ++depth;
+            else if (c == ')')
+                --depth;
+            ++m_pos;
+        }
+        if (m_pos == start) {
+            fail(QString("Beklenmeyen karakter: '%1'").arg(peek()));
+            ++m_pos;
+        }
+    }
+
+    // OVERLAY [adres] : [...] { bölümler } [>region] ...: ayrıntısı bölge hesabına girmez
+    void skipOverlay() {
+        int open = m_text.indexOf('{', m_pos);
+        if (open < 0) {
+            fail("OVERLAY için '{' bekleniyor");
+            return;
+        }
+        int depth = 0;
+        m_pos = open;
+        while (!atEnd()) {
+            QChar c = m_text[m_pos++];
+            if (c == '{')
+                ++depth;
+            else if (c == '}' && --depth == 0)
+                break;
+        }
+        while (m_error.isEmpty()) {
+            int start = m_pos;
+            if (accept('>') || (readIdentifier() == "AT" && accept('>'))) {
+                readIdentifier();
+                continue;
+            }
+            m_pos = start;
+            accept(',');
+            break;
+        }
+    }
+
+    void include(bool sectionList) {
+        QString name = readName();
+        if (m_depth >= MaxIncludeDepth) {
+            fail("INCLUDE çok derin");
+            return;
+        }
+        QString path = QFileInfo(name).isAbsolute() ? name : QDir(m_dir).filePath(name);
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            fail(QString("INCLUDE dosyası açılamadı: %1").arg(name));
+            return;
+        }
+
+        ScriptParser nested(QTextStream(&file).readAll(), QFileInfo(path).absolutePath(), m_script, m_depth + 1);
+        nested.m_defined = m_defined;
+        bool ok = sectionList ? nested.parseSectionList() : nested.parseTopLevel();
+        m_defined = nested.m_defined;
+        if (!ok)
+            fail(QString("%1: %2").arg(name, nested.error()));
+    }
+
+    QString m_text;
+    QString m_dir;
+    LinkerScript &m_script;
+    int m_depth;
+    int m_pos = 0;
+    Value m_dot;
+    QSet<QString> m_defined;
+    QString m_error;
+};
+
+} // namespace
+
+int LinkerScript::regionIndex(const QString &name) const {
+    QString resolved = regionAliases.value(name, name);
+    for (int i = 0; i < regions.size(); ++i) {
+        if (regions[i].name == resolved)
+            return i;
+    }
+    return -1;
+}
+
+const ScriptSection *LinkerScript::section(const QString &name) const {
+    for (const ScriptSection &s : sections) {
+        if (s.name == name)
+            return &s;
+    }
+    return nullptr;
+}
+
+bool parseLinkerScript(const QString &path, LinkerScript &script, QString *error) {
+    script = LinkerScript();
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (error)
+            *error = QString("%1 açılamadı").arg(path);
+        return false;
+    }
+
+    ScriptParser parser(QTextStream(&file).readAll(), QFileInfo(path).absolutePath(), script, 0);
+    if (!parser.parseTopLevel()) {
+        if (error)
+            *error = parser.error();
+        return false;
+    }
+    return true;
+}
+
+static void reassignRegions(SymbolColumns &columns, const QVector<MemoryRegion> &regions) {
+    for (int i = 0; i < columns.count(); ++i)
+        columns.region[i] = regionIndexOf(regions, columns.address[i]);
+}
+
+void applyScriptRegions(const LinkerScript &script, MemoryStats &stats, MapModel &model) {
+    stats = MemoryStats();
+    stats.regions = script.regions;
+
+    reassignRegions(model.outputs, stats.regions);
+    reassignRegions(model.sections, stats.regions);
+    reassignRegions(model.symbols, stats.regions);
+
+    const SymbolColumns &outputs = model.outputs;
+    for (int i = 0; i < outputs.count(); ++i) {
+        const QString &name = model.strings.at(outputs.name[i]);
+        if (outputs.size[i] == 0 || isDebugSection(name))
+            continue;
+
+        int region = outputs.region[i];
+        if (region >= 0)
+            stats.regions[region].used += outputs.size[i];
+
+        // İlk değeri yükleme bölgesinde saklanan bölümler (.data) orada da yer kaplar
+        const ScriptSection *section = script.section(name);
+        if (!section || section->noLoad)
+            continue;
+        int loadRegion = -1;
+        if (!section->loadRegion.isEmpty())
+            loadRegion = script.regionIndex(section->loadRegion);
+        else if (section->hasLoadAddress)
+            loadRegion = regionIndexOf(stats.regions, section->loadAddress);
+        if (loadRegion >= 0 && loadRegion != region)
+            stats.regions[loadRegion].used += outputs.size[i];
+    }
+
+    applyRegionSummary(stats);
+}
+
+QStringList crossCheckScript(const LinkerScript &script, const QVector<MemoryRegion> &mapRegions,
+                             const MapModel &model) {
+    QStringList findings;
+
+    for (const MemoryRegion &region : script.regions) {
+        const MemoryRegion *mapped = nullptr;
+        for (const MemoryRegion &candidate : mapRegions) {
+            if (candidate.name == region.name)
+                mapped = &candidate;
+        }
+        if (!mapped) {
+            findings << QString("%1: map dosyasında yok").arg(region.name);
+        } else if (mapped->origin != region.origin || mapped->length != region.length) {
+            findings << QString("%1: betikte 0x%2 / %3 byte, map'te 0x%4 / %5 byte")
+                        .arg(region.name)
+                        .arg(region.origin, 8, 16, QChar('0')).arg(region.length)
+                        .arg(mapped->origin, 8, 16, QChar('0')).arg(mapped->length);
+        }
+    }
+    for (const MemoryRegion &region : mapRegions) {
+        if (region.name != "*default*" && script.regionIndex(region.name) < 0)
+            findings << QString("%1: betikte tanımlı değil").arg(region.name);
+    }
+
+    const SymbolColumns &outputs = model.outputs;
+    for (int i = 0; i < outputs.count(); ++i) {
+        const QString &name = model.strings.at(outputs.name[i]);
+        if (outputs.size[i] == 0 || isDebugSection(name))
+            continue;
+
+        int actual = regionIndexOf(script.regions, outputs.address[i]);
+        const ScriptSection *section = script.section(name);
+        if (!section) {
+            // Yetim bölümü ld uygun gördüğü yere koyar
+            if (actual >= 0)
+                findings << QString("%1: betikte yok (yetim bölüm, %2 içine yerleşti)")
+                            .arg(name, script.regions[actual].name);
+            continue;
+        }
+        if (section->region.isEmpty())
+            continue;
+
+        int expected = script.regionIndex(section->region);
+        if (expected >= 0 && actual != expected) {
+            findings << QString("%1: betikte >%2, map'te 0x%3 (%4)")
+                        .arg(name, section->region)
+                        .arg(outputs.address[i], 8, 16, QChar('0'))
+                        .arg(actual >= 0 ? script.regions[actual].name : QString("bölge dışı"));
+        }
+    }
+    return findings;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "MapParser.h"
+
+// SECTIONS { .data : AT(...) { ... } >RAM AT>FLASH } içindeki bir çıkış bölümü
+struct ScriptSection {
+    QString name;
+    QString region;         // >RAM
+    QString loadRegion;     // AT>FLASH
+    quint64 address = 0;    // ".text 0x08000000 :" gibi sabit adres, varsa
+    bool hasAddress = false;
+    quint64 loadAddress = 0;    // AT(...) çözülebildiyse
+    bool hasLoadAddress = false;
+    bool noLoad = false;        // (NOLOAD): yalnızca yer ayırır, imajda yok
+};
+
+// GNU ld betiğinin MEMORY ve SECTIONS komutları. Sembolik ifadeler
+// (ORIGIN(RAM) + LENGTH(RAM) - _Min_Stack_Size) sabit katlanarak çözülür;
+// bağlama öncesi bilinemeyen değerler (SIZEOF, bölüm içindeki ".") çözülmemiş kalır.
+struct LinkerScript {
+    QVector<MemoryRegion> regions;      // used = 0
+    QVector<ScriptSection> sections;
+    QHash<QString, quint64> symbols;    // çözülebilen atamalar (_estack, _Min_Stack_Size, ...)
+    QHash<QString, QString> regionAliases;  // REGION_ALIAS("REGION_TEXT", FLASH)
+    QString entry;
+
+    int regionIndex(const QString &name) const;
+    const ScriptSection *section(const QString &name) const;
+};
+
+// INCLUDE komutları betiğin klasörüne göre çözülür
+bool parseLinkerScript(const QString &path, LinkerScript &script, QString *error = nullptr);
+
+// Bölgeleri betiktekilerle değiştirir, modeldeki bölge sütunlarını yeniden
+// hesaplar ve kullanımı çıkış bölümlerinden (VMA + AT> yükleme bölgesi) toplar
+void applyScriptRegions(const LinkerScript &script, MemoryStats &stats, MapModel &model);
+
+// Map ile betik arasındaki farklar: bölge başlangıç/uzunluğu, bölümün betikte
+// istenenden başka bir bölgeye yerleşmesi. mapRegions betik uygulanmadan önceki bölgelerdir.
+QStringList crossCheckScript(const LinkerScript &script, const QVector<MemoryRegion> &mapRegions,
+                             const MapModel &model);
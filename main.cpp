@@ -1,15 +1,59 @@
 #include <QApplication>
 #include "mainwindow.h"
-#include <QIcon>
-#include <QMainWindow>
+#include "cli.h"
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QTimer>
+#include <cstdio>
+
+// --startup-time: pencerenin ilk boyanmasına kadar geçen süreyi yazar ve çıkar
+class FirstPaintProbe : public QObject {
+public:
+    FirstPaintProbe(const QElapsedTimer &timer, qint64 constructed)
+        : m_timer(timer), m_constructed(constructed) {}
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override {
+        if (event->type() == QEvent::Paint && !m_reported) {
+            m_reported = true;
+            // Boyama bu olay işlendikten sonra tamamlanır; ölçüm bir sonraki turda alınır
+            QTimer::singleShot(0, this, [this]() {
+                std::fprintf(stderr, "pencere kurulumu: %lld ms, ilk boyama: %lld ms\n",
+                             m_constructed, m_timer.elapsed());
+                QCoreApplication::quit();
+            });
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+private:
+    const QElapsedTimer &m_timer;
+    qint64 m_constructed;
+    bool m_reported = false;
+};
+
 int main(int argc, char *argv[]) {
+    QElapsedTimer startup;
+    startup.start();
+
+    bool measureStartup = false;
+    // --cli: pencere açmadan analiz (derleme sonrası adımlar, ld -Map=/dev/stdout | MapAnalyzer --cli -)
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--cli") == 0) {
+            QCoreApplication app(argc, argv);
+            return runCli(app.arguments());
+        }
+        if (qstrcmp(argv[i], "--startup-time") == 0)
+            measureStartup = true;
+    }
+
     QApplication app(argc, argv);
     MainWindow w;
-    //QIcon appIcon(":/images/TEI_Logo.png");
-    QIcon icon;
-    icon.addFile(":/images/TEI_Logo.ico", QSize(256, 256));
-    //w.setWindowIcon(appIcon);
-    w.setWindowIcon(icon);
+
+    FirstPaintProbe probe(startup, startup.elapsed());
+    if (measureStartup)
+        w.installEventFilter(&probe);
+
     w.show();
     return app.exec();
 }
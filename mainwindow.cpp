@@ -20,13 +20,31 @@
 #include <QToolButton>
 #include <QStandardPaths>
 #include <QDir>
+#include <QProgressDialog>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+#include <functional>
+#include "comparisondialog.h"
+#include "reportdialog.h"
+#include "stackusage.h"
+#include "dependencygraph.h"
+#include "discardreport.h"
+#include "paddinganalysis.h"
+#include "linkerscript.h"
+#include "elfreader.h"
+#include "modelcache.h"
+#include "symboltabledialog.h"
+#include "heatmapdialog.h"
+#include "excelexport.h"
+#include <QInputDialog>
+#include <QApplication>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),chartRow(nullptr) {
 
 
-    QIcon icon(":/images/TEI_logo2.ico");
-    setWindowIcon(icon);
+    setWindowIcon(QIcon(":/images/TEI_Logo.ico"));
 
     setAcceptDrops(true);
     resize(1000, 600);
@@ -40,6 +58,7 @@ MainWindow::MainWindow(QWidget *parent)
 
     QMenu *fileMenu = new QMenu(this);
     fileMenu->addAction(QIcon(":/icons/open.png"), "Dosya Aç", this, &MainWindow::openFileDialog);
+    fileMenu->addAction(QIcon(":/icons/open.png"), "Borudan Oku (FIFO / stdin)", this, &MainWindow::openPipeDialog);
     fileMenu->addAction(QIcon(":/icons/fullscreen.png"), "Map Dosyasını Göster", this, &MainWindow::openMapFullScreen);
 
     QToolButton *fileButton = new QToolButton(this);
@@ -67,6 +86,14 @@ MainWindow::MainWindow(QWidget *parent)
         MemoryDetailDialog dlg("RAM", lastStats.ramUsed, lastStats.ramTotal, this);
         dlg.exec();
     });
+    analysisMenu->addSeparator();
+    analysisMenu->addAction("Semboller", this, &MainWindow::showSymbols);
+    analysisMenu->addAction("Stack Derinliği (.su)", this, &MainWindow::showStackAnalysis);
+    analysisMenu->addAction("Neden Bağlandı? (--cref)", this, &MainWindow::showWhyLinked);
+    analysisMenu->addAction("Atılan Bölümler (--gc-sections)", this, &MainWindow::showDiscardedSections);
+    analysisMenu->addAction("Hizalama Boşlukları", this, &MainWindow::showPadding);
+    analysisMenu->addAction("Adres Alanı Isı Haritası", this, &MainWindow::showHeatmap);
+    analysisMenu->addAction("Linker Betiği (.ld)", this, &MainWindow::showLinkerScript);
 
     QToolButton *analysisButton = new QToolButton(this);
     analysisButton->setText("Analiz");
@@ -81,6 +108,7 @@ MainWindow::MainWindow(QWidget *parent)
     });
 
     toolBar->addAction(QIcon(":/icons/excel.png"), "Excel'e Kaydet", this, &MainWindow::exportToExcel);
+    toolBar->addAction(QIcon(":/icons/excel.png"), "Ayrıntılı Excel Raporu", this, &MainWindow::exportDetailedExcel);
     toolBar->addAction(QIcon(":/icons/help.png"), "Kullanım Kılavuzu", this, &MainWindow::openUserGuide);
 
 
@@ -150,25 +178,6 @@ MainWindow::MainWindow(QWidget *parent)
 
     initializeMemoryTable();
 
-    mapContentView = new QTextEdit(this);
-    mapContentView->setReadOnly(true);
-    mapContentView->setStyleSheet(
-        "QTextEdit {"
-        "   background: #f5f7fa;"
-        "   border: 1px solid #d3dce6;"
-        "   border-radius: 4px;"
-        "   font-family: 'Consolas', monospace;"
-        "   font-size: 16px;"
-        "   color: #2d3748;"
-        "   padding: 6px;"
-        "   line-height: 1.3;"
-        "}"
-        "QScrollBar:vertical { width: 10px; background: #edf2f7; }"
-        "QScrollBar::handle:vertical { background: #c1ccdb; min-height: 30px; }"
-    );
-    mapContentView->setFixedHeight(0);
-    mainLayout->addWidget(mapContentView);
-
     mainLayout->addLayout(thresholdLayout);
     QPushButton *showChartsButton = new QPushButton("Grafikler", this);
 
@@ -176,17 +185,8 @@ MainWindow::MainWindow(QWidget *parent)
                                    "QPushButton:hover { background-color: #2980b9; }");
     connect(showChartsButton, &QPushButton::clicked, this, &MainWindow::showCharts);
 
+    // Grafik görünümleri (QtCharts) ilk "Grafikler" tıklamasında oluşturulur
     chartRow = new QHBoxLayout();
-    stackChartView = new QtCharts::QChartView();
-    flashChartView = new QtCharts::QChartView();
-    ramChartView = new QtCharts::QChartView();
-    chartRow->addWidget(stackChartView);
-    chartRow->addWidget(flashChartView);
-    chartRow->addWidget(ramChartView);
-
-    stackChartView->setVisible(false);
-    flashChartView->setVisible(false);
-    ramChartView->setVisible(false);
 
     QHBoxLayout *buttonLayout = new QHBoxLayout();
     buttonLayout->addWidget(showChartsButton);
@@ -197,11 +197,13 @@ MainWindow::MainWindow(QWidget *parent)
     mainLayout->addLayout(chartRow);
     setCentralWidget(central);
 
-    // TEI logosu için QLabel oluştur
+    // TEI logosu için QLabel oluştur; görüntü ilk olay döngüsü turunda yüklenir
      teiLogoLabel = new QLabel(this);
-     QPixmap logo(":/images/TEI_logo2.ico"); // Yol doğruysa bu şekilde
-     teiLogoLabel->setPixmap(logo.scaled(180,60, Qt::KeepAspectRatio, Qt::SmoothTransformation));
      teiLogoLabel->setAlignment(Qt::AlignRight | Qt::AlignTop);
+     QTimer::singleShot(0, teiLogoLabel, [this]() {
+         QPixmap logo(":/images/TEI_logo2.ico");
+         teiLogoLabel->setPixmap(logo.scaled(180,60, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+     });
 
      // Toolbar'ın sağına eklemek için boş bir widget ve layout
      QWidget *spacer = new QWidget();
@@ -219,7 +221,7 @@ void MainWindow::initializeMemoryTable() {
 }
 
 void MainWindow::openMapFullScreen() {
-    if (mapContentView->toPlainText().isEmpty()) {
+    if (mapContent.isEmpty()) {
         QMessageBox::information(this, "Uyarı", "Henüz yüklenmiş bir dosya yok.");
         return;
     }
@@ -235,8 +237,21 @@ void MainWindow::openMapFullScreen() {
 
     QTextEdit *textEdit = new QTextEdit(window);
     textEdit->setReadOnly(true);
-    textEdit->setPlainText(mapContentView->toPlainText());
-    textEdit->setStyleSheet(mapContentView->styleSheet());
+    textEdit->setPlainText(mapContent);
+    textEdit->setStyleSheet(
+        "QTextEdit {"
+        "   background: #f5f7fa;"
+        "   border: 1px solid #d3dce6;"
+        "   border-radius: 4px;"
+        "   font-family: 'Consolas', monospace;"
+        "   font-size: 16px;"
+        "   color: #2d3748;"
+        "   padding: 6px;"
+        "   line-height: 1.3;"
+        "}"
+        "QScrollBar:vertical { width: 10px; background: #edf2f7; }"
+        "QScrollBar::handle:vertical { background: #c1ccdb; min-height: 30px; }"
+    );
 
     QVBoxLayout *layout = new QVBoxLayout(window);
     layout->addWidget(textEdit);
@@ -307,6 +322,9 @@ void MainWindow::updateMemoryTable() {
 
 void MainWindow::showCharts()
 {
+    if (!stackChartView)
+        setupCharts();
+
     bool visible = !stackChartView->isVisible();
 
     stackChartView->setVisible(visible);
@@ -314,16 +332,21 @@ void MainWindow::showCharts()
     ramChartView->setVisible(visible);
 
     if (visible) {
-        setupCharts();
-
-        showPieChart(stackChartView, "STACK", lastStats.stackUsed, lastStats.stackTotal);
-        showPieChart(flashChartView, "FLASH", lastStats.flashUsed, lastStats.flashTotal);
-        showPieChart(ramChartView, "RAM", lastStats.ramUsed, lastStats.ramTotal);
-
+        refreshCharts();
         layout()->update();
     }
 }
 
+void MainWindow::refreshCharts()
+{
+    if (!stackChartView || !stackChartView->isVisible())
+        return;
+
+    showPieChart(stackChartView, "STACK", lastStats.stackUsed, lastStats.stackTotal);
+    showPieChart(flashChartView, "FLASH", lastStats.flashUsed, lastStats.flashTotal);
+    showPieChart(ramChartView, "RAM", lastStats.ramUsed, lastStats.ramTotal);
+}
+
 
 void MainWindow::setupCharts()
 {
@@ -333,15 +356,18 @@ void MainWindow::setupCharts()
     const int chartSize = 350;
     QSize chartDimensions(chartSize, chartSize);
 
-    auto setupChartView = [&](QtCharts::QChartView* view) {
+    auto setupChartView = [&]() -> QtCharts::QChartView * {
+        QtCharts::QChartView *view = new QtCharts::QChartView();
         view->setSizePolicy(chartSizePolicy);
         view->setMinimumSize(chartDimensions);
         view->setRenderHint(QPainter::Antialiasing);
+        chartRow->addWidget(view);
+        return view;
     };
 
-    setupChartView(stackChartView);
-    setupChartView(flashChartView);
-    setupChartView(ramChartView);
+    stackChartView = setupChartView();
+    flashChartView = setupChartView();
+    ramChartView = setupChartView();
 
     chartRow->setStretch(0, 1);
     chartRow->setStretch(1, 1);
@@ -349,13 +375,29 @@ void MainWindow::setupCharts()
 }
 
 
-MainWindow::~MainWindow() {}
+MainWindow::~MainWindow() {
+    // Bekleyen boru okuması en geç bir poll aralığında (100 ms) bırakır
+    if (pipeCanceled)
+        pipeCanceled->storeRelease(1);
+    pipePool.waitForDone();
+}
+
+static bool isSupportedFile(const QString &filePath) {
+    for (const char *suffix : { ".map", ".elf", ".axf", ".out" }) {
+        if (filePath.endsWith(suffix, Qt::CaseInsensitive))
+            return true;
+    }
+    return false;
+}
 
 void MainWindow::dragEnterEvent(QDragEnterEvent *event) {
     if (event->mimeData()->hasUrls()) {
         QList<QUrl> urls = event->mimeData()->urls();
-        if (!urls.isEmpty() && urls.first().toLocalFile().endsWith(".map")) {
-            event->acceptProposedAction();
+        for (const QUrl &url : urls) {
+            if (isSupportedFile(url.toLocalFile())) {
+                event->acceptProposedAction();
+                break;
+            }
         }
     }
 }
@@ -368,62 +410,517 @@ void MainWindow::dragMoveEvent(QDragMoveEvent *event) {
 
 void MainWindow::dropEvent(QDropEvent *event) {
     QList<QUrl> urls = event->mimeData()->urls();
-    if (!urls.isEmpty()) {
-        QString filePath = urls.first().toLocalFile();
-        if (filePath.endsWith(".map")) {
-            openFile(filePath);
+    QStringList filePaths;
+    for (const QUrl &url : urls) {
+        QString filePath = url.toLocalFile();
+        if (isSupportedFile(filePath)) {
+            filePaths.append(filePath);
         }
     }
+
+    if (filePaths.size() == 1) {
+        openFile(filePaths.first());
+    } else if (filePaths.size() > 1) {
+        compareFiles(filePaths);
+    }
 }
 
 void MainWindow::openFileDialog() {
     QSettings settings("", "MapAnalyzer");
     QString lastDir = settings.value("lastOpenDir", QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).toString();
-    QString filePath = QFileDialog::getOpenFileName(this, "Map Dosyası Seç", lastDir, "Map Dosyaları (*.map)");
-    if (!filePath.isEmpty()) {
-        settings.setValue("lastOpenDir", QFileInfo(filePath).absolutePath());
-        openFile(filePath);
+    QStringList filePaths = QFileDialog::getOpenFileNames(this, "Map Dosyası Seç", lastDir,
+                                                          "Map / ELF Dosyaları (*.map *.elf *.axf *.out);;Map Dosyaları (*.map);;ELF Dosyaları (*.elf *.axf *.out)");
+    if (filePaths.isEmpty())
+        return;
+
+    settings.setValue("lastOpenDir", QFileInfo(filePaths.first()).absolutePath());
+    if (filePaths.size() == 1) {
+        openFile(filePaths.first());
+    } else {
+        compareFiles(filePaths);
     }
 }
 
+void MainWindow::compareFiles(const QStringList &filePaths) {
+    // Her dosya ayrı bir iş parçacığında işlenir, sonuçlar giriş sırasıyla döner
+    std::function<ComparedMap(const QString &)> parse = [](const QString &filePath) {
+        ComparedMap map;
+        map.filePath = filePath;
+        if (isElfFile(filePath)) {
+            MapModel model;
+            map.ok = readElfFile(filePath, map.stats, model);
+        } else {
+            map.ok = parseMapFile(filePath, map.stats);
+        }
+        return map;
+    };
+
+    QProgressDialog *progress = new QProgressDialog("Map dosyaları işleniyor...", "İptal", 0, filePaths.size(), this);
+    progress->setWindowModality(Qt::WindowModal);
+
+    QFutureWatcher<ComparedMap> *watcher = new QFutureWatcher<ComparedMap>(this);
+    connect(watcher, &QFutureWatcher<ComparedMap>::progressValueChanged, progress, &QProgressDialog::setValue);
+    connect(progress, &QProgressDialog::canceled, watcher, &QFutureWatcher<ComparedMap>::cancel);
+    connect(watcher, &QFutureWatcher<ComparedMap>::finished, this, [this, watcher, progress]() {
+        progress->deleteLater();
+        watcher->deleteLater();
+        if (watcher->isCanceled())
+            return;
+
+        QVector<ComparedMap> maps = watcher->future().results().toVector();
+        ComparisonDialog dlg(maps, thresholdSpin->value(), this);
+        dlg.exec();
+    });
+
+    watcher->setFuture(QtConcurrent::mapped(filePaths, parse));
+    progress->show();
+}
+
 void MainWindow::openFile(const QString &filePath) {
     lastStats = {};
+    lastFilePath.clear();
 
+    bool elf = isElfFile(filePath);
     QFile file(filePath);
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QString fileContents = QTextStream(&file).readAll();
-        mapContentView->setPlainText(fileContents);
+    if (elf) {
+        mapContent.clear();
+    } else if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        mapContent = QTextStream(&file).readAll();
         file.close();
     } else {
-        mapContentView->setPlainText("Dosya okunamadı!");
+        mapContent = "Dosya okunamadı!";
     }
 
-    if (!parseMapFile(filePath, lastStats)) {
-        QMessageBox::warning(this, "Hata", "Map dosyası işlenemedi.");
+    // Dosya değişmediyse önceki ayrıştırmanın ikili kaydı kullanılır
+    bool ok = loadCachedModel(filePath, lastStats, lastModel);
+    if (!ok) {
+        ok = elf ? readElfFile(filePath, lastStats, lastModel)
+                 : parseMapFile(filePath, lastStats, lastModel);
+        if (ok)
+            storeCachedModel(filePath, lastStats, lastModel);
+    }
+    if (!ok) {
+        QMessageBox::warning(this, "Hata", elf ? "ELF dosyası işlenemedi." : "Map dosyası işlenemedi.");
         return;
     }
+    lastFilePath = filePath;
+
+    if (elf) {
+        // İkili dosya gösterilemez; bunun yerine bölüm özetini göster
+        QStringList lines;
+        lines << QString("ELF: %1").arg(QFileInfo(filePath).fileName()) << QString();
+        const SymbolColumns &outputs = lastModel.outputs;
+        for (int i = 0; i < outputs.count(); ++i) {
+            lines << QString("%1 0x%2 0x%3")
+                     .arg(lastModel.strings.at(outputs.name[i]), -24)
+                     .arg(outputs.address[i], 8, 16, QChar('0'))
+                     .arg(outputs.size[i], 8, 16, QChar('0'));
+        }
+        lines << QString() << QString("%1 sembol").arg(lastModel.symbols.count());
+        mapContent = lines.join('\n');
+    }
+
+    showLoadedStats(QFileInfo(filePath).fileName());
+}
+
+void MainWindow::openPipeDialog() {
+    bool ok;
+    QString source = QInputDialog::getText(this, "Borudan Oku",
+        "Linker map çıktısının yazıldığı FIFO yolu (stdin için \"-\"):", QLineEdit::Normal, "-", &ok).trimmed();
+    if (ok && !source.isEmpty())
+        openPipe(source);
+}
+
+struct PipeResult {
+    bool ok = false;
+    MemoryStats stats;
+    MapModel model;
+};
+
+void MainWindow::openPipe(const QString &source) {
+    // Okuma linker yazmayı bitirene (EOF) kadar sürer; arayüz donmasın diye iş parçacığında
+    QSharedPointer<QAtomicInt> canceled(new QAtomicInt);
+    pipeCanceled = canceled;
+
+    QProgressDialog *progress = new QProgressDialog("Linker çıktısı bekleniyor: " + source, "İptal", 0, 0, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setAutoReset(false);
+    progress->setMinimumDuration(0);
+    connect(progress, &QProgressDialog::canceled, this, [canceled]() {
+        canceled->storeRelease(1);
+    });
+
+    QFutureWatcher<PipeResult> *watcher = new QFutureWatcher<PipeResult>(this);
+    connect(watcher, &QFutureWatcher<PipeResult>::finished, this, [this, watcher, progress, canceled, source]() {
+        progress->deleteLater();
+        watcher->deleteLater();
+        if (canceled->loadAcquire())
+            return;
+
+        PipeResult result = watcher->result();
+        if (!result.ok) {
+            QMessageBox::warning(this, "Hata", QString("%1 okunamadı.").arg(source));
+            return;
+        }
+
+        lastStats = result.stats;
+        lastModel = result.model;
+        lastFilePath = source;
+        mapContent = QString("Map verisi %1 kaynağından akış olarak okundu; içerik saklanmadı.").arg(source);
+        showLoadedStats(source == "-" ? QString("stdin") : QFileInfo(source).fileName());
+    });
+
+    watcher->setFuture(QtConcurrent::run(&pipePool, [source, canceled]() {
+        PipeResult result;
+        result.ok = parseMapPipe(source, result.stats, result.model, canceled.data());
+        return result;
+    }));
+    progress->show();
+}
+
+// Özet tablosu ve grafikler KB gösterir; bölgeler byte kalır
+static void summaryToKB(MemoryStats &stats) {
+    stats.stackUsed /= 1024.0;
+    stats.stackTotal /= 1024.0;
+    stats.flashUsed /= 1024.0;
+    stats.flashTotal /= 1024.0;
+    stats.ramUsed /= 1024.0;
+    stats.ramTotal /= 1024.0;
+}
 
-    lastStats.stackUsed /= 1024.0;
-    lastStats.stackTotal /= 1024.0;
-    lastStats.flashUsed /= 1024.0;
-    lastStats.flashTotal /= 1024.0;
-    lastStats.ramUsed /= 1024.0;
-    lastStats.ramTotal /= 1024.0;
+void MainWindow::showLoadedStats(const QString &displayName) {
+    // Sembol adları arka planda önceden çözülür; tablo yalnızca görünen satırları ister
+    lastDemangler.reset(new Demangler(lastModel.strings));
+    lastDemangler->prewarm(lastModel.symbols.name);
+
+    summaryToKB(lastStats);
+    mapRegions = lastStats.regions;
 
     updateMemoryTable();
 
-    if (stackChartView->isVisible()) {
-        showPieChart(stackChartView, "STACK", lastStats.stackUsed, lastStats.stackTotal);
-        showPieChart(flashChartView, "FLASH", lastStats.flashUsed, lastStats.flashTotal);
-        showPieChart(ramChartView, "RAM", lastStats.ramUsed, lastStats.ramTotal);
-    }
+    refreshCharts();
 
-    QFileInfo fileInfo(filePath);
-    setWindowTitle("Map Analyzer - " + fileInfo.fileName());
+    setWindowTitle("Map Analyzer - " + displayName);
     QMessageBox::information(this, "Başarılı",
             QString("Dosya başarıyla yüklendi\n"));
 }
 
+void MainWindow::showStackAnalysis() {
+    if (lastFilePath.isEmpty()) {
+        QMessageBox::information(this, "Uyarı", "Henüz yüklenmiş bir dosya yok.");
+        return;
+    }
+
+    QString mapDir = QFileInfo(lastFilePath).absolutePath();
+    QStringList graphFiles = QFileDialog::getOpenFileNames(this,
+        "Çağrı Grafiği Seç (-fcallgraph-info .ci veya objdump -d çıktısı)", mapDir,
+        "Çağrı Grafiği (*.ci *.txt *.dis *.lst);;Tüm Dosyalar (*)");
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    StackAnalyzer analyzer;
+    int frameCount = analyzer.loadStackUsageForObjects(lastModel.objectFiles(), mapDir);
+    for (const QString &path : graphFiles)
+        analyzer.loadCallGraph(path);
+
+    QVector<StackEntryReport> reports = analyzer.analyze();
+    QApplication::restoreOverrideCursor();
+
+    if (reports.isEmpty()) {
+        QMessageBox::information(this, "Stack Derinliği",
+            "Stack bilgisi bulunamadı.\n.su dosyaları map'teki nesne dosyalarının yanında olmalıdır (-fstack-usage).");
+        return;
+    }
+
+    QVector<StackEntryReport> entryFirst;
+    for (const StackEntryReport &report : reports) {
+        if (lastModel.entry != StringPool::npos && report.function == lastModel.strings.at(lastModel.entry))
+            entryFirst.prepend(report);
+        else
+            entryFirst.append(report);
+    }
+
+    QVector<QStringList> rows;
+    for (const StackEntryReport &report : entryFirst) {
+        QStringList notes;
+        if (report.recursive)
+            notes << "döngü (alt sınır)";
+        if (report.indirect)
+            notes << "dolaylı çağrı (alt sınır)";
+        if (report.dynamic)
+            notes << "dinamik çerçeve";
+        if (report.unknownFrames > 0)
+            notes << QString("%1 fonksiyonun .su kaydı yok").arg(report.unknownFrames);
+
+        rows.append({ report.function,
+                      QString::number(report.worstBytes),
+                      report.path.join(" → "),
+                      notes.join(", ") });
+    }
+
+    QString info = QString("%1 fonksiyon, %2 çağrı kenarı, %3 .su kaydı.")
+                   .arg(analyzer.functionCount()).arg(analyzer.edgeCount()).arg(frameCount);
+    QStringList cycles = analyzer.cycles();
+    if (!cycles.isEmpty())
+        info += QString("\nÖzyinelemeli çağrılar: %1").arg(cycles.mid(0, 10).join(", "));
+
+    ReportDialog dlg("Stack Derinliği", info,
+                     { "Giriş Noktası", "En Kötü Durum (byte)", "Çağrı Zinciri", "Notlar" }, rows, this);
+    dlg.exec();
+}
+
+void MainWindow::showWhyLinked() {
+    if (lastFilePath.isEmpty()) {
+        QMessageBox::information(this, "Uyarı", "Henüz yüklenmiş bir dosya yok.");
+        return;
+    }
+    if (lastModel.cref.count() == 0) {
+        QMessageBox::information(this, "Neden Bağlandı?",
+            "Map dosyasında \"Cross Reference Table\" yok.\nLinker'a -Wl,--cref parametresini ekleyin.");
+        return;
+    }
+
+    bool ok;
+    QString target = QInputDialog::getText(this, "Neden Bağlandı?",
+        "Sembol, nesne veya arşiv adı:", QLineEdit::Normal, QString(), &ok).trimmed();
+    if (!ok || target.isEmpty())
+        return;
+
+    const StringPool &strings = lastModel.strings;
+    quint32 entry = lastModel.entry;
+    if (entry == StringPool::npos) {
+        for (const QString &name : { QString("Reset_Handler"), QString("_start"), QString("main") }) {
+            entry = strings.find(name);
+            if (entry != StringPool::npos)
+                break;
+        }
+    }
+    QString entryName = QInputDialog::getText(this, "Neden Bağlandı?", "Giriş noktası:", QLineEdit::Normal,
+        entry != StringPool::npos ? strings.at(entry) : QString(), &ok).trimmed();
+    if (!ok || entryName.isEmpty())
+        return;
+    entry = strings.find(entryName);
+
+    // Tam eşleşme yoksa adı içeren tüm düğümler hedef kabul edilir (ör. "libfoo.a")
+    QVector<quint32> targets;
+    quint32 exact = strings.find(target);
+    if (exact != StringPool::npos) {
+        targets.append(exact);
+    } else {
+        for (int id = 0; id < strings.size(); ++id) {
+            if (strings.at(quint32(id)).contains(target))
+                targets.append(quint32(id));
+        }
+    }
+
+    DependencyGraph graph;
+    graph.build(lastModel);
+    QVector<quint32> chain = entry != StringPool::npos ? graph.whyLinked(entry, targets) : QVector<quint32>();
+    if (chain.isEmpty()) {
+        QMessageBox::information(this, "Neden Bağlandı?",
+            QString("\"%1\" için \"%2\" giriş noktasından bir referans zinciri bulunamadı.").arg(target, entryName));
+        return;
+    }
+
+    QVector<QStringList> rows;
+    QStringList names;
+    for (int i = 0; i < chain.size(); ++i) {
+        quint32 id = chain[i];
+        bool symbol = graph.isSymbol(id);
+        QString relation;
+        if (i + 1 < chain.size())
+            relation = symbol ? "tanımlandığı nesne →" : "referans verir →";
+        rows.append({ QString::number(i + 1), strings.at(id), symbol ? "sembol" : "nesne", relation });
+        names.append(strings.at(id));
+    }
+
+    ReportDialog dlg("Neden Bağlandı?", names.join(" → "),
+                     { "Adım", "Ad", "Tür", "İlişki" }, rows, this);
+    dlg.exec();
+}
+
+void MainWindow::showDiscardedSections() {
+    if (lastFilePath.isEmpty()) {
+        QMessageBox::information(this, "Uyarı", "Henüz yüklenmiş bir dosya yok.");
+        return;
+    }
+    if (lastModel.discarded.count() == 0) {
+        QMessageBox::information(this, "Atılan Bölümler",
+            "Map dosyasında \"Discarded input sections\" bloğu yok veya boş.\n"
+            "-ffunction-sections -fdata-sections ve -Wl,--gc-sections ile derleyin.");
+        return;
+    }
+
+    QVector<DiscardSummary> archives = discardedByArchive(lastModel);
+    QVector<DiscardSummary> objects = discardedByObject(lastModel);
+
+    QVector<QStringList> rows;
+    quint64 totalDiscarded = 0;
+    int mostlyDead = 0;
+    auto addRow = [&rows](const QString &level, const DiscardSummary &summary) {
+        rows.append({ level,
+                      summary.name,
+                      QString::number(summary.discardedSections),
+                      QString::number(summary.discarded),
+                      QString::number(summary.kept),
+                      QString("%1%").arg(summary.discardedPercent(), 0, 'f', 1),
+                      summary.mostlyDead() ? "çoğunlukla ölü kod, bölünmeli" : QString() });
+    };
+
+    for (const DiscardSummary &archive : archives)
+        addRow("arşiv", archive);
+    for (const DiscardSummary &object : objects) {
+        addRow("nesne", object);
+        totalDiscarded += object.discarded;
+        if (object.mostlyDead())
+            ++mostlyDead;
+    }
+
+    QString info = QString("Linker toplam %1 KB kodu/veriyi attı. %2 nesnenin yarısından fazlası kullanılmıyor.")
+                   .arg(totalDiscarded / 1024.0, 0, 'f', 2).arg(mostlyDead);
+
+    ReportDialog dlg("Atılan Bölümler", info,
+                     { "Düzey", "Ad", "Atılan Bölüm", "Atılan (byte)", "Kalan (byte)", "Atılan %", "Not" },
+                     rows, this);
+    dlg.exec();
+}
+
+void MainWindow::showPadding() {
+    if (lastFilePath.isEmpty()) {
+        QMessageBox::information(this, "Uyarı", "Henüz yüklenmiş bir dosya yok.");
+        return;
+    }
+    if (lastStats.regions.isEmpty()) {
+        QMessageBox::information(this, "Hizalama Boşlukları", "Dosyada bellek bölgesi bilgisi yok.");
+        return;
+    }
+
+    PaddingReport report = analyzePadding(lastModel, lastStats.regions);
+    const StringPool &strings = lastModel.strings;
+    auto text = [&strings](quint32 id) {
+        return id == StringPool::npos ? QString() : strings.at(id);
+    };
+
+    QVector<QStringList> rows;
+    for (int region = 0; region < report.regionBytes.size(); ++region) {
+        for (int cause = 0; cause < int(PaddingCause::CauseCount); ++cause) {
+            quint64 bytes = report.regionBytes[region][cause];
+            if (bytes > 0)
+                rows.append({ "bölge", lastStats.regions[region].name, QString(),
+                              paddingCauseName(PaddingCause(cause)), QString::number(bytes), QString() });
+        }
+    }
+    for (const PaddingGap &gap : topOffenders(report, 100)) {
+        rows.append({ lastStats.regions[gap.region].name, text(gap.name), text(gap.object),
+                      paddingCauseName(gap.cause), QString::number(gap.bytes), QString::number(gap.count) });
+    }
+
+    quint64 total = 0;
+    for (int cause = 0; cause < int(PaddingCause::CauseCount); ++cause)
+        total += report.total(PaddingCause(cause));
+    QString info = QString("Hizalama toplam %1 KB boşluk bırakıyor.").arg(total / 1024.0, 0, 'f', 2);
+    if (!lastModel.exactSymbolSizes)
+        info += " Map dosyası sembol boyutu vermediği için sembol hizalaması yalnızca ELF'te ölçülür.";
+
+    ReportDialog dlg("Hizalama Boşlukları", info,
+                     { "Bölge", "Bölüm / Sembol", "Nesne", "Neden", "Boşluk (byte)", "Adet" },
+                     rows, this);
+    dlg.exec();
+}
+
+void MainWindow::showHeatmap() {
+    if (lastFilePath.isEmpty()) {
+        QMessageBox::information(this, "Uyarı", "Henüz yüklenmiş bir dosya yok.");
+        return;
+    }
+    if (lastStats.regions.isEmpty()) {
+        QMessageBox::information(this, "Adres Alanı Isı Haritası", "Dosyada bellek bölgesi bilgisi yok.");
+        return;
+    }
+
+    HeatmapDialog dlg(lastModel, lastStats.regions, this);
+    dlg.exec();
+}
+
+void MainWindow::showLinkerScript() {
+    QSettings settings("", "MapAnalyzer");
+    QString dir = lastFilePath.isEmpty() ? settings.value("lastOpenDir").toString()
+                                         : QFileInfo(lastFilePath).absolutePath();
+    QString scriptPath = QFileDialog::getOpenFileName(this, "Linker Betiği Seç", dir,
+                                                      "Linker Betikleri (*.ld *.lds *.x);;Tüm Dosyalar (*)");
+    if (scriptPath.isEmpty())
+        return;
+
+    LinkerScript script;
+    QString error;
+    if (!parseLinkerScript(scriptPath, script, &error)) {
+        QMessageBox::warning(this, "Hata", QString("Linker betiği işlenemedi:\n%1").arg(error));
+        return;
+    }
+
+    // Map yüklüyse betik bölgeleri esas alınır; yoksa yalnızca betik bütçesi gösterilir
+    QVector<QStringList> rows;
+    if (!lastFilePath.isEmpty()) {
+        // Karşılaştırma her zaman map'in bölgeleriyle; önceki betiğinkiyle değil
+        for (const QString &finding : crossCheckScript(script, mapRegions, lastModel))
+            rows.append({ "uyarı", QString(), QString(), QString(), QString(), QString(), finding });
+        applyScriptRegions(script, lastStats, lastModel);
+    }
+
+    const QVector<MemoryRegion> &regions = lastFilePath.isEmpty() ? script.regions : lastStats.regions;
+    for (const MemoryRegion &region : regions) {
+        double percent = region.length > 0 ? region.used * 100.0 / region.length : 0.0;
+        rows.append({ "bölge", region.name, QString("0x%1").arg(region.origin, 8, 16, QChar('0')), QString(),
+                      QString::number(region.length), QString("%1%").arg(percent, 0, 'f', 1),
+                      QString("%1 byte kullanılıyor").arg(region.used) });
+    }
+
+    for (const ScriptSection &section : script.sections) {
+        if (section.name == "/DISCARD/")
+            continue;
+        quint64 size = 0;
+        quint32 id = lastModel.strings.find(section.name);
+        for (int i = 0; id != StringPool::npos && i < lastModel.outputs.count(); ++i) {
+            if (lastModel.outputs.name[i] == id)
+                size += lastModel.outputs.size[i];
+        }
+        int region = script.regionIndex(section.region);
+        double percent = region >= 0 && script.regions[region].length > 0
+                         ? size * 100.0 / script.regions[region].length : 0.0;
+        rows.append({ "bölüm", section.name, section.region, section.loadRegion,
+                      lastFilePath.isEmpty() ? QString() : QString::number(size),
+                      lastFilePath.isEmpty() ? QString() : QString("%1%").arg(percent, 1, 'f', 1),
+                      section.noLoad ? "NOLOAD" : QString() });
+    }
+
+    QString info = QString("%1: %2 bölge, %3 çıkış bölümü.")
+                   .arg(QFileInfo(scriptPath).fileName()).arg(script.regions.size()).arg(script.sections.size());
+    if (!script.entry.isEmpty())
+        info += QString(" Giriş: %1.").arg(script.entry);
+
+    // Yalnızca bölgeler değişti: model aynı, yükleme mesajı ve ad çözücü gerekmez
+    if (!lastFilePath.isEmpty()) {
+        summaryToKB(lastStats);
+        updateMemoryTable();
+        refreshCharts();
+        setWindowTitle("Map Analyzer - " + QFileInfo(lastFilePath).fileName() + " + " + QFileInfo(scriptPath).fileName());
+    }
+
+    ReportDialog dlg("Linker Betiği", info,
+                     { "Tür", "Ad", "Bölge", "Yükleme Bölgesi", "Boyut (byte)", "Bölge %", "Not" },
+                     rows, this);
+    dlg.exec();
+}
+
+void MainWindow::showSymbols() {
+    if (lastFilePath.isEmpty()) {
+        QMessageBox::information(this, "Uyarı", "Henüz yüklenmiş bir dosya yok.");
+        return;
+    }
+
+    SymbolTableDialog dlg(lastModel, lastStats.regions, lastDemangler, this);
+    dlg.exec();
+}
+
 void MainWindow::updateCharts(const QVector<QString> &lines) {
 
     lastStats.stackUsed = 120.0;
@@ -434,11 +931,7 @@ void MainWindow::updateCharts(const QVector<QString> &lines) {
     lastStats.ramTotal = 256.0;
     updateMemoryTable();
 
-    if (stackChartView->isVisible()) {
-        showPieChart(stackChartView, "STACK", lastStats.stackUsed, lastStats.stackTotal);
-        showPieChart(flashChartView, "FLASH", lastStats.flashUsed, lastStats.flashTotal);
-        showPieChart(ramChartView, "RAM", lastStats.ramUsed, lastStats.ramTotal);
-    }
+    refreshCharts();
 }
 
 void MainWindow::showPieChart(QtCharts::QChartView *view, const QString &title, double used, double total) {
@@ -620,3 +1113,66 @@ void MainWindow::exportToExcel() {
           QMessageBox::warning(this, "Hata", "Excel kaydedilemedi!");
       }
 }
+
+void MainWindow::exportDetailedExcel() {
+    if (lastFilePath.isEmpty()) {
+        QMessageBox::information(this, "Uyarı", "Henüz yüklenmiş bir dosya yok.");
+        return;
+    }
+
+    QString path = QFileDialog::getSaveFileName(this,
+        "Ayrıntılı Excel Raporunu Kaydet",
+        QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + "/memory_details.xlsx",
+        "Excel Files (*.xlsx)");
+    if (path.isEmpty())
+        return;
+
+    // Model ve istatistikler örtük paylaşımlı kopyalanır; yeni dosya açılsa da iş güvenlidir
+    MemoryStats stats = lastStats;
+    MapModel model = lastModel;
+    QSharedPointer<Demangler> demangler = lastDemangler;
+    QSharedPointer<ExcelExportProgress> state(new ExcelExportProgress);
+    int threshold = thresholdSpin->value();
+
+    QProgressDialog *progress = new QProgressDialog("Excel raporu hazırlanıyor...", "İptal", 0, 100, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setAutoReset(false);
+
+    // İş parçacığı yalnızca sayaçları yazar; pencere zamanlayıcıyla yoklar
+    QTimer *timer = new QTimer(progress);
+    connect(timer, &QTimer::timeout, progress, [progress, state]() {
+        progress->setValue(state->percent());
+        if (state->saving.loadAcquire())
+            progress->setLabelText("Excel dosyası yazılıyor...");
+    });
+    timer->start(100);
+
+    connect(progress, &QProgressDialog::canceled, this, [state]() {
+        state->canceled.storeRelease(1);
+    });
+
+    QSharedPointer<QString> error(new QString);
+    QFutureWatcher<bool> *watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, progress, state, error, path]() {
+        progress->deleteLater();
+        watcher->deleteLater();
+        if (state->canceled.loadAcquire())
+            return;
+
+        if (!watcher->result()) {
+            QMessageBox::warning(this, "Hata", *error);
+            return;
+        }
+#ifdef Q_OS_WIN
+        QMessageBox::information(this, "Başarılı", "Excel dosyası başarıyla kaydedildi ve açılıyor\n");
+        QDesktopServices::openUrl(QUrl::fromLocalFile(path));
+#else
+        QMessageBox::information(this, "Başarılı", QString("Excel raporu kaydedildi:\n%1").arg(path));
+#endif
+    });
+
+    watcher->setFuture(QtConcurrent::run([path, stats, model, threshold, demangler, state, error]() {
+        return writeDetailedExcel(path, stats, model, threshold, demangler.data(), state.data(), error.data());
+    }));
+    progress->show();
+}
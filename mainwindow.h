@@ -15,6 +15,9 @@
 #include <QTextEdit>
 #include <QSpinBox>
 #include "MemoryDetailDialog.h"
+#include "demangler.h"
+#include <QSharedPointer>
+#include <QThreadPool>
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -32,12 +35,13 @@ protected:
 
 private:
     QVBoxLayout *mainLayout;
-    QtCharts::QChartView *stackChartView, *flashChartView, *ramChartView;
+    QtCharts::QChartView *stackChartView = nullptr, *flashChartView = nullptr, *ramChartView = nullptr;
     QTableWidget *memoryTable;
     QPushButton *showChartsButton;
     void setupCharts();
+    void refreshCharts();
     QHBoxLayout *chartRow;
-    QTextEdit *mapContentView;
+    QString mapContent;     // "Map Dosyasını Göster" penceresi açılınca kullanılır
     QSpinBox *greenMinSpin;
     QSpinBox *yellowMinSpin;
     QSpinBox *thresholdSpin;
@@ -49,17 +53,36 @@ private:
     void showCharts();
     void openUserGuide();
     void openMapFullScreen();
+    void showStackAnalysis();
+    void showWhyLinked();
+    void showDiscardedSections();
+    void showPadding();
+    void showHeatmap();
+    void showLinkerScript();
+    void showSymbols();
 
     QLabel* teiLogoLabel; // TEI logosu için QLabel
 
 
     MemoryStats lastStats;
+    QVector<MemoryRegion> mapRegions;   // map'in kendi bölgeleri; betik uygulansa da değişmez
+    MapModel lastModel;
+    QSharedPointer<Demangler> lastDemangler;
+    QString lastFilePath;
     ClickableLabel *dropLabel;
+    // Boru okuması yazıcıyı süresiz bekleyebilir; ortak havuzu tutmasın diye ayrı havuz
+    QThreadPool pipePool;
+    QSharedPointer<QAtomicInt> pipeCanceled;
 
     void openFile(const QString &filePath);
+    void openPipeDialog();
+    void openPipe(const QString &source);
+    void showLoadedStats(const QString &displayName);
+    void compareFiles(const QStringList &filePaths);
     void updateCharts(const QVector<QString> &lines);
 
 private slots:
     void openFileDialog();
     void exportToExcel();
+    void exportDetailedExcel();
 };
@@ -0,0 +1,159 @@
+#include "mapmodel.h"
+#include "frontcodednames.h"
+#include <QSet>
+
+quint32 StringPool::intern(const QString &text) {
+    if (m_index) {
+        // Yüklenen havuza ekleme: dizin eskir, hash'e geçilir
+        for (int id = 0; id < m_strings.size(); ++id)
+            m_ids.insert(m_strings[id], quint32(id));
+        m_index.reset();
+    }
+
+    auto it = m_ids.constFind(text);
+    if (it != m_ids.constEnd())
+        return it.value();
+
+    quint32 id = quint32(m_strings.size());
+    m_strings.append(text);
+    m_ids.insert(text, id);
+    return id;
+}
+
+quint32 StringPool::find(const QString &text) const {
+    return m_index ? m_index->find(text) : m_ids.value(text, npos);
+}
+
+QVector<quint32> StringPool::withPrefix(const QString &prefix) const {
+    if (m_index)
+        return m_index->withPrefix(prefix);
+
+    QVector<quint32> ids;
+    for (int id = 0; id < m_strings.size(); ++id) {
+        if (m_strings[id].startsWith(prefix))
+            ids.append(quint32(id));
+    }
+    return ids;
+}
+
+void StringPool::clear() {
+    m_strings.clear();
+    m_ids.clear();
+    m_index.reset();
+}
+
+void StringPool::assign(const QVector<QString> &strings, QSharedPointer<const NameIndex> index) {
+    m_strings = strings;
+    m_ids.clear();
+    m_index = index;
+}
+
+
+void SymbolColumns::reserve(int rows) {
+    name.reserve(rows);
+    section.reserve(rows);
+    object.reserve(rows);
+    region.reserve(rows);
+    address.reserve(rows);
+    size.reserve(rows);
+}
+
+void SymbolColumns::append(quint32 nameId, quint32 sectionId, quint32 objectId, qint32 regionIndex,
+                           quint64 addr, quint64 bytes) {
+    name.append(nameId);
+    section.append(sectionId);
+    object.append(objectId);
+    region.append(regionIndex);
+    address.append(addr);
+    size.append(bytes);
+}
+
+void SymbolColumns::clear() {
+    name.clear();
+    section.clear();
+    object.clear();
+    region.clear();
+    address.clear();
+    size.clear();
+}
+
+
+void CrossReference::addSymbol(quint32 symbolId) {
+    symbol.append(symbolId);
+    definer.append(StringPool::npos);
+    refOffset.append(referrers.size());
+}
+
+void CrossReference::addFile(quint32 objectId) {
+    if (symbol.isEmpty())
+        return;
+
+    // İlk dosya tanımlayan nesnedir, sonrakiler referans verenlerdir
+    if (definer.last() == StringPool::npos) {
+        definer.last() = objectId;
+    } else {
+        referrers.append(objectId);
+        refOffset.last() = referrers.size();
+    }
+}
+
+void CrossReference::clear() {
+    symbol.clear();
+    definer.clear();
+    refOffset = { 0 };
+    referrers.clear();
+}
+
+
+QStringList MapModel::objectFiles() const {
+    QStringList files;
+    QSet<quint32> seen;
+    for (quint32 id : sections.object) {
+        if (id == StringPool::npos || seen.contains(id))
+            continue;
+        seen.insert(id);
+        files.append(strings.at(id));
+    }
+    return files;
+}
+
+void MapModel::clear() {
+    strings.clear();
+    outputs.clear();
+    sections.clear();
+    symbols.clear();
+    discarded.clear();
+    cref.clear();
+    entry = StringPool::npos;
+    exactSymbolSizes = false;
+}
+
+
+bool isDebugSection(const QString &name) {
+    return name.startsWith(".debug") || name.startsWith(".comment") || name.startsWith(".stab")
+        || name.startsWith(".ARM.attributes");
+}
+
+QString archiveOf(const QString &object) {
+    int open = object.lastIndexOf('(');
+    if (open <= 0 || !object.endsWith(')'))
+        return QString();
+
+    QString archive = object.left(open);
+    int slash = qMax(archive.lastIndexOf('/'), archive.lastIndexOf('\\'));
+    return archive.mid(slash + 1);
+}
+
+
+int regionIndexOf(const QVector<MemoryRegion> &regions, quint64 address) {
+    // Bölgeler iç içe olabilir (ör. RAM içinde STACK); en dar olan seçilir
+    int best = -1;
+    for (int i = 0; i < regions.size(); ++i) {
+        const MemoryRegion &region = regions[i];
+        if (address >= region.origin && address - region.origin < region.length) {
+            if (best < 0 || region.length < regions[best].length)
+                best = i;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+struct MemoryRegion {
+    QString name;
+    quint64 origin = 0, length = 0, used = 0;
+};
+
+class NameIndex;
+
+// Sembol, nesne ve bölüm adlarını bir kez saklar; tablolar yalnızca kimlik tutar.
+// Ayrıştırma sırasında arama QHash ile yapılır. Model kaydından yüklenen
+// havuzda hash kurulmaz; aramalar sıralı, ön ek sıkıştırmalı NameIndex
+// üzerinde ikili aramadır.
+class StringPool {
+public:
+    static const quint32 npos = 0xFFFFFFFFu;
+
+    quint32 intern(const QString &text);
+    quint32 find(const QString &text) const;
+    // prefix ile başlayan tüm metinlerin kimlikleri (büyük/küçük harf duyarlı)
+    QVector<quint32> withPrefix(const QString &prefix) const;
+    const QString &at(quint32 id) const { return m_strings.at(int(id)); }
+    int size() const { return m_strings.size(); }
+    void clear();
+
+    // Kayıttan çözülen metinleri ve sıralı dizinlerini alır (kimlik = indeks)
+    void assign(const QVector<QString> &strings, QSharedPointer<const NameIndex> index);
+    // Yüklenen havuzun sıralı dizini; ayrıştırılan havuzda nullptr
+    const NameIndex *sortedIndex() const { return m_index.data(); }
+
+private:
+    QVector<QString> m_strings;
+    QHash<QString, quint32> m_ids;
+    QSharedPointer<const NameIndex> m_index;
+};
+
+// Struct-of-arrays tablo: her sütun ayrı bir vektördür ve satır indeksiyle hizalıdır.
+struct SymbolColumns {
+    QVector<quint32> name;
+    QVector<quint32> section;
+    QVector<quint32> object;
+    QVector<qint32>  region;
+    QVector<quint64> address;
+    QVector<quint64> size;
+
+    int count() const { return name.size(); }
+    void reserve(int rows);
+    void append(quint32 nameId, quint32 sectionId, quint32 objectId, qint32 regionIndex,
+                quint64 addr, quint64 bytes);
+    void clear();
+};
+
+// --cref "Cross Reference Table": her sembolün tanımlandığı nesne ve ona
+// referans veren nesneler. Referanslar CSR düzenindedir:
+// referrers[refOffset[i] .. refOffset[i + 1]) i. sembole aittir.
+struct CrossReference {
+    QVector<quint32> symbol;
+    QVector<quint32> definer;
+    QVector<int> refOffset { 0 };
+    QVector<quint32> referrers;
+
+    int count() const { return symbol.size(); }
+    void addSymbol(quint32 symbolId);
+    void addFile(quint32 objectId);
+    void clear();
+};
+
+struct MapModel {
+    StringPool strings;
+
+    SymbolColumns outputs;   // çıkış bölümleri; section = kendi adı
+    SymbolColumns sections;  // giriş bölümleri ve *fill* satırları; section = çıkış bölümü
+    SymbolColumns symbols;   // section = giriş bölümü
+    SymbolColumns discarded; // --gc-sections ile atılan giriş bölümleri; section = npos
+
+    CrossReference cref;
+
+    quint32 entry = StringPool::npos;   // ENTRY(...) sembolü
+    bool exactSymbolSizes = false;       // ELF'ten okunduysa boyutlar kesindir
+
+    // Map dosyasının referans verdiği nesne dosyaları, ilk görülme sırasıyla
+    QStringList objectFiles() const;
+    void clear();
+};
+
+// .debug_*, .comment gibi belleğe yüklenmeyen bölümler
+bool isDebugSection(const QString &name);
+
+// "lib/libfoo.a(bar.o)" → "libfoo.a"; arşiv üyesi değilse boş
+QString archiveOf(const QString &object);
+
+// Adresi içeren (en dar) bölgenin indeksi, yoksa -1
+int regionIndexOf(const QVector<MemoryRegion> &regions, quint64 address);
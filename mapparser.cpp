@@ -1,6 +1,15 @@
 #include "MapParser.h"
 #include <QFile>
 #include <QTextStream>
+#include <QAtomicInt>
+#include <cstdio>
+#include <algorithm>
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
 
 static int hexToInt(const QString &hexStr) {
     bool ok;
@@ -19,29 +28,285 @@ static int hexToByte(const QString &hexStr) {
     return clean.toUInt(&ok, 16);
 }
 
+static quint64 hexToU64(const QString &hexStr) {
+    QString clean = hexStr.trimmed().remove("0x");
+    bool ok;
+    return clean.toULongLong(&ok, 16);
+}
 
-bool parseMapFile(const QString &filePath, MemoryStats &stats) {
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly)) return false;
 
-    QTextStream stream(&file);
+static bool isHex(const QString &token) {
+    return token.startsWith("0x");
+}
+
+// "Linker script and memory map" bloğunun satır satır çözümlenmesi
+struct MemoryMapState {
+    MapModel *model = nullptr;
+    const QVector<MemoryRegion> *regions = nullptr;
+    QVector<quint64> vmaUsed, lmaUsed;
+
+    QString pendingOutput;          // adı tek satıra sığmayan çıkış bölümü
+    QString pendingInput;           // adı tek satıra sığmayan giriş bölümü
+    quint32 outputId = StringPool::npos;
+    quint32 inputId = StringPool::npos;
+    quint32 objectId = StringPool::npos;
+    quint64 inputEnd = 0;
+    int symbolStart = 0;
+    quint32 fillId = StringPool::npos;
+};
+
+// Map dosyası sembol boyutu vermez: aynı giriş bölümündeki bir sonraki sembole
+// (ya da bölüm sonuna) olan uzaklık boyut kabul edilir.
+static void finishInputSection(MemoryMapState &state) {
+    if (!state.model)
+        return;
+
+    SymbolColumns &symbols = state.model->symbols;
+    int begin = state.symbolStart;
+    int end = symbols.count();
+    state.symbolStart = end;
+    if (end - begin < 1)
+        return;
+
+    QVector<int> order;
+    for (int i = begin; i < end; ++i)
+        order.append(i);
+    std::stable_sort(order.begin(), order.end(), [&symbols](int a, int b) {
+        return symbols.address[a] < symbols.address[b];
+    });
+
+    for (int i = 0; i < order.size(); ++i) {
+        quint64 address = symbols.address[order[i]];
+        quint64 next = (i + 1 < order.size()) ? symbols.address[order[i + 1]] : state.inputEnd;
+        symbols.size[order[i]] = next > address ? next - address : 0;
+    }
+}
+
+static void addOutputSection(MemoryMapState &state, const QString &name, const QStringList &tokens, int at) {
+    finishInputSection(state);
+
+    quint64 address = hexToU64(tokens[at]);
+    quint64 size = hexToU64(tokens[at + 1]);
+    int region = regionIndexOf(*state.regions, address);
+
+    if (!isDebugSection(name) && size > 0) {
+        if (region >= 0)
+            state.vmaUsed[region] += size;
+
+        // ".data 0x20000000 0x100 load address 0x08001234" → FLASH'ta da yer kaplar
+        int loadAt = tokens.indexOf("load", at + 2);
+        if (loadAt >= 0 && loadAt + 2 < tokens.size() && isHex(tokens[loadAt + 2])) {
+            int loadRegion = regionIndexOf(*state.regions, hexToU64(tokens[loadAt + 2]));
+            if (loadRegion >= 0 && loadRegion != region)
+                state.lmaUsed[loadRegion] += size;
+        }
+    }
+
+    state.inputId = StringPool::npos;
+    state.objectId = StringPool::npos;
+    if (state.model) {
+        state.outputId = state.model->strings.intern(name);
+        state.model->outputs.append(state.outputId, state.outputId, StringPool::npos, region, address, size);
+    }
+}
+
+static void addInputSection(MemoryMapState &state, const QString &name, const QStringList &tokens, int at) {
+    finishInputSection(state);
+    if (!state.model)
+        return;
+
+    quint64 address = hexToU64(tokens[at]);
+    quint64 size = hexToU64(tokens[at + 1]);
+    QString object = tokens.mid(at + 2).join(' ');
+
+    MapModel &model = *state.model;
+    state.inputId = model.strings.intern(name);
+    state.objectId = object.isEmpty() ? StringPool::npos : model.strings.intern(object);
+    state.inputEnd = address + size;
+    model.sections.append(state.inputId, state.outputId, state.objectId,
+                          regionIndexOf(*state.regions, address), address, size);
+}
+
+static void parseMemoryMapLine(MemoryMapState &state, const QString &raw, const QString &line) {
+    if (line.isEmpty())
+        return;
+
+    QStringList tokens = line.split(QRegExp("\\s+"));
+    bool indented = raw.at(0).isSpace();
+
+    if (!state.pendingOutput.isEmpty()) {
+        QString name = state.pendingOutput;
+        state.pendingOutput.clear();
+        if (tokens.size() >= 2 && isHex(tokens[0]) && isHex(tokens[1])) {
+            addOutputSection(state, name, tokens, 0);
+            return;
+        }
+    }
+
+    if (!state.pendingInput.isEmpty()) {
+        QString name = state.pendingInput;
+        state.pendingInput.clear();
+        if (tokens.size() >= 2 && isHex(tokens[0]) && isHex(tokens[1])) {
+            addInputSection(state, name, tokens, 0);
+            return;
+        }
+    }
+
+    if (!indented) {
+        if (tokens.size() >= 3 && isHex(tokens[1]) && isHex(tokens[2])) {
+            addOutputSection(state, tokens[0], tokens, 1);
+        } else if (tokens.size() == 1 && tokens[0].startsWith('.')) {
+            state.pendingOutput = tokens[0];
+        }
+        return;
+    }
+
+    if (tokens[0] == "*fill*") {
+        if (state.model && tokens.size() >= 3 && isHex(tokens[1]) && isHex(tokens[2])) {
+            finishInputSection(state);
+            MapModel &model = *state.model;
+            if (state.fillId == StringPool::npos)
+                state.fillId = model.strings.intern("*fill*");
+            quint64 address = hexToU64(tokens[1]);
+            model.sections.append(state.fillId, state.outputId, StringPool::npos,
+                                  regionIndexOf(*state.regions, address), address, hexToU64(tokens[2]));
+            state.inputId = StringPool::npos;
+        }
+        return;
+    }
+
+    bool sectionName = tokens[0].startsWith('.') || tokens[0] == "COMMON";
+    if (sectionName && tokens.size() >= 3 && isHex(tokens[1]) && isHex(tokens[2])) {
+        addInputSection(state, tokens[0], tokens, 1);
+    } else if (sectionName && tokens.size() == 1) {
+        state.pendingInput = tokens[0];
+    } else if (tokens.size() == 2 && isHex(tokens[0]) && !isHex(tokens[1])
+               && state.model && state.inputId != StringPool::npos) {
+        // "0x08000188                main" → giriş bölümüne ait sembol
+        quint64 address = hexToU64(tokens[0]);
+        MapModel &model = *state.model;
+        model.symbols.append(model.strings.intern(tokens[1]), state.inputId, state.objectId,
+                             regionIndexOf(*state.regions, address), address, 0);
+    }
+}
+
+// "Discarded input sections" bloğu: " .text.foo  0x00000000  0x1c build/foo.o",
+// uzun adlarda adres/boyut/nesne bir sonraki satırdadır.
+static void parseDiscardedLine(MapModel &model, QString &pendingName, const QString &line) {
+    if (line.isEmpty())
+        return;
+
+    QStringList tokens = line.split(QRegExp("\\s+"));
+    QString name;
+    int at = 1;
+    if (!pendingName.isEmpty() && tokens.size() >= 2 && isHex(tokens[0]) && isHex(tokens[1])) {
+        name = pendingName;
+        at = 0;
+    } else if (tokens.size() >= 3 && isHex(tokens[1]) && isHex(tokens[2])) {
+        name = tokens[0];
+    }
+    pendingName.clear();
+
+    if (name.isEmpty()) {
+        if (tokens.size() == 1)
+            pendingName = tokens[0];
+        return;
+    }
+
+    QString object = tokens.mid(at + 2).join(' ');
+    model.discarded.append(model.strings.intern(name), StringPool::npos,
+                           object.isEmpty() ? StringPool::npos : model.strings.intern(object),
+                           -1, hexToU64(tokens[at]), hexToU64(tokens[at + 1]));
+}
+
+// "Symbol    File" tablosu: sütun 0'daki satır yeni sembol (yanında tanımlayan
+// nesne olabilir), girintili satırlar aynı sembole ait dosyalardır.
+static void parseCrossReferenceLine(MapModel &model, const QString &raw, const QString &line) {
+    if (line.isEmpty())
+        return;
+
+    if (!raw.at(0).isSpace()) {
+        QStringList tokens = line.split(QRegExp("\\s+"));
+        if (tokens.size() == 2 && tokens[0] == "Symbol" && tokens[1] == "File")
+            return;
+
+        model.cref.addSymbol(model.strings.intern(tokens[0]));
+        if (tokens.size() > 1)
+            model.cref.addFile(model.strings.intern(tokens.mid(1).join(' ')));
+    } else {
+        model.cref.addFile(model.strings.intern(line));
+    }
+}
+
+void applyRegionSummary(MemoryStats &stats) {
+    for (const MemoryRegion &region : stats.regions) {
+        if (region.name.contains("STACK", Qt::CaseInsensitive)) {
+            stats.stackUsed  = region.used;
+            stats.stackTotal = region.length;
+        } else if (region.name.contains("FLASH", Qt::CaseInsensitive)) {
+            stats.flashUsed  = region.used;
+            stats.flashTotal = region.length;
+        } else if (region.name.contains("RAM", Qt::CaseInsensitive)) {
+            stats.ramUsed    = region.used;
+            stats.ramTotal   = region.length;
+        }
+    }
+}
+
+// Tek ileri geçiş: cihaz hiç geri sarılmaz, bu yüzden stdin ve FIFO da okunabilir
+static bool parseMap(QIODevice *device, MemoryStats &stats, MapModel *model) {
+    QTextStream stream(device);
     bool configSection = false;
+    bool memoryMap = false;
+    bool crossReference = false;
+    bool discardedSection = false;
+    QString pendingDiscarded;
+
+    MemoryMapState mapState;
+    mapState.model = model;
+    mapState.regions = &stats.regions;
 
-    while (!stream.atEnd()) {
-        QString line = stream.readLine().trimmed();
+    // atEnd() boruda linker henüz yazarken true dönebilir; readLineInto gerçek EOF'u bekler
+    QString raw;
+    while (stream.readLineInto(&raw)) {
+        QString line = raw.trimmed();
+
+        if (line.startsWith("Discarded input sections")) {
+            discardedSection = true;
+            continue;
+        }
 
         if (line.startsWith("Memory Configuration")) {
+            discardedSection = false;
             configSection = true;
             continue;
         }
 
+        if (discardedSection) {
+            if (model)
+                parseDiscardedLine(*model, pendingDiscarded, line);
+            continue;
+        }
+
         if (configSection && line.startsWith("Name")) {
             // Header satırı, bir sonraki satırlar veri
             continue;
         }
 
         if (configSection && !line.isEmpty()) {
+            // "ad origin uzunluk [öznitelikler]": öznitelik sütunu boş olabilir
             QStringList tokens = line.split(QRegExp("\\s+"));
+            if (tokens.size() >= 3 && !tokens[0].startsWith('*')
+                && isHex(tokens[1]) && isHex(tokens[2])) {
+                MemoryRegion region;
+                region.name   = tokens[0];
+                region.origin = hexToU64(tokens[1]);
+                region.length = hexToU64(tokens[2]);
+                if (tokens.size() >= 5 && isHex(tokens[3]))
+                    region.used = hexToU64(tokens[3]);
+                stats.regions.append(region);
+            }
+
             if (tokens.size() >= 5) {
                 QString name = tokens[0];
                 double used  = hexToByte(tokens[3]); // KB
@@ -62,9 +327,139 @@ bool parseMapFile(const QString &filePath, MemoryStats &stats) {
 
         if (line.startsWith("Linker script") || line.startsWith("Sections")) {
             configSection = false;
+            memoryMap = true;
+            mapState.vmaUsed.fill(0, stats.regions.size());
+            mapState.lmaUsed.fill(0, stats.regions.size());
+            continue;
+        }
+
+        if (line.startsWith("Cross Reference Table")) {
+            finishInputSection(mapState);
+            memoryMap = false;
+            crossReference = true;
+            continue;
+        }
+
+        if (crossReference) {
+            if (model && !raw.isEmpty())
+                parseCrossReferenceLine(*model, raw, line);
+            continue;
+        }
+
+        if (line.startsWith("ENTRY(") && model) {
+            model->entry = model->strings.intern(line.mid(6, line.indexOf(')') - 6).trimmed());
+        } else if (line.startsWith("Start Address:") && model) {
+            model->entry = model->strings.intern(line.mid(14).trimmed());
+        }
+
+        if (memoryMap && !raw.isEmpty()) {
+            parseMemoryMapLine(mapState, raw, line);
         }
     }
+    finishInputSection(mapState);
+
+    // GNU ld "Memory Configuration" bloğunda Used sütunu yoktur; doluluk
+    // çıkış bölümlerinden hesaplanır.
+    bool hasUsedColumn = false;
+    for (const MemoryRegion &region : stats.regions)
+        hasUsedColumn |= region.used > 0;
+
+    if (!hasUsedColumn && memoryMap) {
+        for (int i = 0; i < stats.regions.size(); ++i)
+            stats.regions[i].used = mapState.vmaUsed[i] + mapState.lmaUsed[i];
+        if (stats.stackTotal == 0 && stats.flashTotal == 0 && stats.ramTotal == 0)
+            applyRegionSummary(stats);
+    }
 
     return true;
 }
 
+
+bool parseMapFile(const QString &filePath, MemoryStats &stats) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    return parseMap(&file, stats, nullptr);
+}
+
+bool parseMapFile(const QString &filePath, MemoryStats &stats, MapModel &model) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    return parseMapStream(&file, stats, model);
+}
+
+bool parseMapStream(QIODevice *device, MemoryStats &stats, MapModel &model) {
+    model.clear();
+    return parseMap(device, stats, &model);
+}
+
+#ifdef Q_OS_UNIX
+// FIFO/stdin tanımlayıcısını poll ile okur; her beklemede iptal bayrağına
+// bakar, böylece yazıcı hiç bağlanmasa da okuma durdurulabilir.
+class PipeDevice : public QIODevice {
+public:
+    PipeDevice(int fd, bool owned, const QAtomicInt *canceled)
+        : m_fd(fd), m_owned(owned), m_canceled(canceled) {}
+    ~PipeDevice() override {
+        if (m_owned)
+            ::close(m_fd);
+    }
+
+    bool isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override {
+        for (;;) {
+            if (m_canceled && m_canceled->loadAcquire())
+                return -1;
+            // Linux'ta O_NONBLOCK açılan FIFO, ilk yazıcı bağlanana dek POLLHUP vermez
+            pollfd pfd = { m_fd, POLLIN, 0 };
+            int ready = ::poll(&pfd, 1, 100);
+            if (ready < 0 && errno != EINTR)
+                return -1;
+            if (ready <= 0)
+                continue;
+            ssize_t n = ::read(m_fd, data, size_t(maxSize));
+            if (n >= 0)
+                return n;
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                return -1;
+        }
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    int m_fd;
+    bool m_owned;
+    const QAtomicInt *m_canceled;
+};
+#endif
+
+bool parseMapPipe(const QString &source, MemoryStats &stats, MapModel &model, const QAtomicInt *canceled) {
+    bool ok;
+#ifdef Q_OS_UNIX
+    // Engelleyen open() yazıcı bağlanana dek döndürmez; O_NONBLOCK ile hemen açılır
+    int fd = STDIN_FILENO;
+    bool owned = false;
+    if (!source.isEmpty() && source != "-") {
+        fd = ::open(QFile::encodeName(source).constData(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) return false;
+        owned = true;
+    }
+    PipeDevice device(fd, owned, canceled);
+    if (!device.open(QIODevice::ReadOnly)) return false;
+    ok = parseMapStream(&device, stats, model);
+#else
+    QFile file;
+    bool opened;
+    if (source.isEmpty() || source == "-") {
+        opened = file.open(stdin, QIODevice::ReadOnly);
+    } else {
+        file.setFileName(source);
+        opened = file.open(QIODevice::ReadOnly);
+    }
+    if (!opened) return false;
+    ok = parseMapStream(&file, stats, model);
+#endif
+    // İptalde okunan kısım yarımdır; sonuç kullanılmaz
+    return ok && !(canceled && canceled->loadAcquire());
+}
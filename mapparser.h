@@ -1,12 +1,31 @@
 #pragma once
 
 #include <QString>
+#include <QVector>
+#include "mapmodel.h"
+
+class QIODevice;
+class QAtomicInt;
 
 struct MemoryStats {
     double stackUsed = 0, stackTotal = 0;
     double flashUsed = 0, flashTotal = 0;
     double ramUsed   = 0, ramTotal   = 0;
+
+    // "Memory Configuration" bloğundaki tüm bölgeler (byte cinsinden)
+    QVector<MemoryRegion> regions;
 };
 
 
 bool parseMapFile(const QString &filePath, MemoryStats &stats);
+// Bölüm, nesne ve sembol ayrıntılarını da modele doldurur
+bool parseMapFile(const QString &filePath, MemoryStats &stats, MapModel &model);
+// Sıralı (seek edilemeyen) cihazdan tek geçişte okur
+bool parseMapStream(QIODevice *device, MemoryStats &stats, MapModel &model);
+// "-" veya boş: stdin, aksi hâlde FIFO/dosya yolu (ld -Map=/dev/stdout, mkfifo).
+// canceled 1 olunca bekleme bırakılır ve false döner.
+bool parseMapPipe(const QString &source, MemoryStats &stats, MapModel &model,
+                  const QAtomicInt *canceled = nullptr);
+
+// STACK/FLASH/RAM özet alanlarını bölge adlarına göre doldurur
+void applyRegionSummary(MemoryStats &stats);
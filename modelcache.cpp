@@ -0,0 +1,213 @@
+#include "modelcache.h"
+#include "frontcodednames.h"
+#include "checkedstream.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+
+static const quint32 ModelMagic = 0x4D41504D;   // "MAPM"
+static const quint32 ModelVersion = 3;   // 3: ad bölümü yeniden başlama noktalarıyla, doğrulanarak okunur
+
+// Önbellek kaydında kaynak dosyanın kimliği; elle kaydedilen modellerde boştur
+struct SourceStamp {
+    QString path;
+    qint64 size = -1;
+    qint64 modified = -1;
+};
+
+static SourceStamp stampOf(const QString &sourcePath) {
+    QFileInfo info(sourcePath);
+    SourceStamp stamp;
+    stamp.path = info.absoluteFilePath();
+    stamp.size = info.size();
+    stamp.modified = info.lastModified().toMSecsSinceEpoch();
+    return stamp;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const SymbolColumns &columns) {
+    return stream << columns.name << columns.section << columns.object
+                  << columns.region << columns.address << columns.size;
+}
+
+static QDataStream &operator>>(QDataStream &stream, SymbolColumns &columns) {
+    readVector(stream, columns.name);
+    readVector(stream, columns.section);
+    readVector(stream, columns.object);
+    readVector(stream, columns.region);
+    readVector(stream, columns.address);
+    readVector(stream, columns.size);
+    int rows = columns.name.size();
+    if (columns.section.size() != rows || columns.object.size() != rows || columns.region.size() != rows
+        || columns.address.size() != rows || columns.size.size() != rows) {
+        columns.clear();
+        stream.setStatus(QDataStream::ReadCorruptData);
+    }
+    return stream;
+}
+
+// Kayıt kullanıcıdan gelebilir: sütunlardaki kimlikler ve indeksler, okunan
+// ad ve bölge sayılarına sığmalı. npos "yok" anlamındadır.
+static bool idsValid(const QVector<quint32> &ids, int stringCount) {
+    return std::all_of(ids.begin(), ids.end(), [stringCount](quint32 id) {
+        return id == StringPool::npos || id < quint32(stringCount);
+    });
+}
+
+static bool columnsValid(const SymbolColumns &columns, int stringCount, int regionCount) {
+    return idsValid(columns.name, stringCount) && idsValid(columns.section, stringCount)
+        && idsValid(columns.object, stringCount)
+        && std::all_of(columns.region.begin(), columns.region.end(), [regionCount](qint32 region) {
+               return region >= -1 && region < regionCount;
+           });
+}
+
+static bool crossReferenceValid(const CrossReference &cref, int stringCount) {
+    const QVector<int> &offsets = cref.refOffset;
+    if (cref.definer.size() != cref.symbol.size() || offsets.size() != cref.symbol.size() + 1
+        || offsets.first() != 0 || offsets.last() != cref.referrers.size())
+        return false;
+    for (int i = 1; i < offsets.size(); ++i) {
+        if (offsets[i] < offsets[i - 1])
+            return false;
+    }
+    return idsValid(cref.symbol, stringCount) && idsValid(cref.definer, stringCount)
+        && idsValid(cref.referrers, stringCount);
+}
+
+static bool writeModel(const QString &path, const SourceStamp &stamp, const MemoryStats &stats, const MapModel &model) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    // Kayıttan yüklenen havuzun dizini hazırdır; yeniden sıralamaya gerek yok
+    NameIndex built;
+    const NameIndex *names = model.strings.sortedIndex();
+    if (!names) {
+        built.build(model.strings);
+        names = &built;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << ModelMagic << ModelVersion << stamp.path << stamp.size << stamp.modified;
+
+    out << stats.stackUsed << stats.stackTotal << stats.flashUsed << stats.flashTotal
+        << stats.ramUsed << stats.ramTotal << qint32(stats.regions.size());
+    for (const MemoryRegion &region : stats.regions)
+        out << region.name << region.origin << region.length << region.used;
+
+    out << *names << model.outputs << model.sections << model.symbols << model.discarded
+        << model.cref.symbol << model.cref.definer << model.cref.refOffset << model.cref.referrers
+        << model.entry << model.exactSymbolSizes;
+
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+static bool readModel(const QString &path, SourceStamp *stamp, MemoryStats &stats, MapModel &model) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+    quint32 magic, version;
+    SourceStamp stored;
+    in >> magic >> version;
+    if (magic != ModelMagic || version != ModelVersion)
+        return false;
+    readString(in, stored.path);
+    in >> stored.size >> stored.modified;
+    // Önbellek eskimişse sütunları okumaya gerek yok
+    if (stamp && (stored.path != stamp->path || stored.size != stamp->size || stored.modified != stamp->modified))
+        return false;
+
+    MemoryStats loadedStats;
+    qint32 regionCount;
+    in >> loadedStats.stackUsed >> loadedStats.stackTotal >> loadedStats.flashUsed >> loadedStats.flashTotal
+       >> loadedStats.ramUsed >> loadedStats.ramTotal >> regionCount;
+    // En kısa bölge kaydı: boş ad uzunluğu ve üç quint64
+    const qint64 minRegionBytes = sizeof(quint32) + 3 * sizeof(quint64);
+    if (regionCount < 0 || in.status() != QDataStream::Ok
+        || regionCount > file.bytesAvailable() / minRegionBytes)
+        return false;
+    loadedStats.regions.reserve(regionCount);
+    for (qint32 i = 0; i < regionCount && in.status() == QDataStream::Ok; ++i) {
+        MemoryRegion region;
+        readString(in, region.name);
+        in >> region.origin >> region.length >> region.used;
+        loadedStats.regions.append(region);
+    }
+
+    QSharedPointer<NameIndex> names(new NameIndex);
+    model.clear();
+    in >> *names >> model.outputs >> model.sections >> model.symbols >> model.discarded;
+    readVector(in, model.cref.symbol);
+    readVector(in, model.cref.definer);
+    readVector(in, model.cref.refOffset);
+    readVector(in, model.cref.referrers);
+    in >> model.entry >> model.exactSymbolSizes;
+    if (in.status() != QDataStream::Ok) {
+        model.clear();
+        return false;
+    }
+
+    // Havuz hash kurmadan dizini kullanır; adlar yalnızca kimlik sırasına çözülür
+    QVector<QString> byId;
+    const int stringCount = names->count();
+    const int regionTotal = loadedStats.regions.size();
+    if (!names->decode(byId)
+        || !columnsValid(model.outputs, stringCount, regionTotal)
+        || !columnsValid(model.sections, stringCount, regionTotal)
+        || !columnsValid(model.symbols, stringCount, regionTotal)
+        || !columnsValid(model.discarded, stringCount, regionTotal)
+        || !crossReferenceValid(model.cref, stringCount)
+        || !(model.entry == StringPool::npos || model.entry < quint32(stringCount))) {
+        model.clear();
+        return false;
+    }
+    model.strings.assign(byId, names);
+    stats = loadedStats;
+    return true;
+}
+
+static QString cachePathFor(const QString &sourcePath) {
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/models";
+    QByteArray key = QCryptographicHash::hash(QFileInfo(sourcePath).absoluteFilePath().toUtf8(),
+                                              QCryptographicHash::Sha1).toHex();
+    return dir + "/" + QString::fromLatin1(key) + ".mapmodel";
+}
+
+bool saveModel(const QString &path, const MemoryStats &stats, const MapModel &model) {
+    return writeModel(path, SourceStamp(), stats, model);
+}
+
+bool loadModel(const QString &path, MemoryStats &stats, MapModel &model) {
+    return readModel(path, nullptr, stats, model);
+}
+
+bool isModelFile(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream in(&file);
+    quint32 magic = 0;
+    in >> magic;
+    return magic == ModelMagic;
+}
+
+bool loadCachedModel(const QString &sourcePath, MemoryStats &stats, MapModel &model) {
+    SourceStamp stamp = stampOf(sourcePath);
+    return readModel(cachePathFor(sourcePath), &stamp, stats, model);
+}
+
+void storeCachedModel(const QString &sourcePath, const MemoryStats &stats, const MapModel &model) {
+    QString path = cachePathFor(sourcePath);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    writeModel(path, stampOf(sourcePath), stats, model);
+}
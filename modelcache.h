@@ -0,0 +1,17 @@
+#pragma once
+
+#include <QString>
+#include "MapParser.h"
+
+// Ayrıştırılmış modelin ikili kaydı. Adlar NameIndex (front-coded) biçiminde,
+// sütunlar ham vektörler olarak yazılır; yükleme yeniden ayrıştırmadan çok hızlıdır.
+bool saveModel(const QString &path, const MemoryStats &stats, const MapModel &model);
+bool loadModel(const QString &path, MemoryStats &stats, MapModel &model);
+// Dosya bir model kaydı mı (imza denetimi)
+bool isModelFile(const QString &path);
+
+// QStandardPaths::CacheLocation altındaki otomatik önbellek. Kayıt kaynak
+// dosyanın mutlak yoluna göre adlandırılır; boyut veya değişiklik zamanı
+// tutmazsa geçersiz sayılır.
+bool loadCachedModel(const QString &sourcePath, MemoryStats &stats, MapModel &model);
+void storeCachedModel(const QString &sourcePath, const MemoryStats &stats, const MapModel &model);
@@ -0,0 +1,253 @@
+#include "occupancymap.h"
+#include <QHash>
+#include <algorithm>
+
+static const QColor EmptyColor(236, 240, 241);
+
+// Arşiv modunda en büyük arşivler ayrı renk alır, kalanlar tek grupta toplanır
+static const int MaxArchiveColors = 13;
+
+static const QVector<QColor> &palette() {
+    static const QVector<QColor> colors = {
+        QColor("#3498db"), QColor("#e67e22"), QColor("#2ecc71"), QColor("#9b59b6"),
+        QColor("#e74c3c"), QColor("#1abc9c"), QColor("#f1c40f"), QColor("#34495e"),
+        QColor("#d35400"), QColor("#16a085"), QColor("#8e44ad"), QColor("#c0392b"),
+        QColor("#27ae60"), QColor("#7f8c8d"), QColor("#bdc3c7"), QColor("#2c3e50"),
+    };
+    return colors;
+}
+
+enum SectionType { Code, ReadOnly, Data, Bss, HeapStack, Fill, Other, SectionTypeCount };
+
+static SectionType sectionType(const QString &input, const QString &output) {
+    if (input == "*fill*")
+        return Fill;
+    for (const QString &name : { input, output }) {
+        if (name.isEmpty())
+            continue;
+        QString lower = name.toLower();
+        if (lower.contains("heap") || lower.contains("stack"))
+            return HeapStack;
+        if (lower.startsWith(".text") || lower.startsWith(".init") || lower.startsWith(".fini")
+            || lower.contains("isr_vector") || lower.contains("vectors"))
+            return Code;
+        if (lower.startsWith(".rodata") || lower.startsWith(".arm.ex") || lower.startsWith(".init_array")
+            || lower.startsWith(".fini_array") || lower.startsWith(".preinit_array"))
+            return ReadOnly;
+        if (lower.startsWith(".bss") || lower.startsWith(".sbss") || lower == "common" || lower.startsWith(".noinit"))
+            return Bss;
+        if (lower.startsWith(".data") || lower.startsWith(".sdata"))
+            return Data;
+    }
+    return Other;
+}
+
+// [a, b) aralığını step baytlık piksel kutularına dağıtır; rowBegin piksel 0'ın adresidir
+template <typename Add>
+static void distribute(quint64 step, quint64 rowBegin, quint64 a, quint64 b, Add add) {
+    while (a < b) {
+        int pixel = int((a - rowBegin) / step);
+        quint64 binEnd = rowBegin + quint64(pixel + 1) * step;
+        quint64 n = qMin(b, binEnd) - a;
+        add(pixel, n);
+        a += n;
+    }
+}
+
+OccupancyMap::OccupancyMap(const MapModel &model, const MemoryRegion &region, ColorMode mode)
+    : m_strings(model.strings), m_region(region)
+{
+    // Giriş bölümleri yoksa (ELF) çıkış bölümleri kullanılır
+    const SymbolColumns &rows = model.sections.count() > 0 ? model.sections : model.outputs;
+    const quint64 regionEnd = region.origin + region.length;
+
+    QVector<int> selected;
+    for (int i = 0; i < rows.count(); ++i) {
+        quint64 begin = rows.address[i];
+        if (rows.size[i] == 0 || begin >= regionEnd || begin + rows.size[i] <= region.origin)
+            continue;
+        if (rows.section[i] != StringPool::npos && isDebugSection(model.strings.at(rows.section[i])))
+            continue;
+        selected.append(i);
+    }
+
+    auto text = [&model](quint32 id) {
+        return id == StringPool::npos ? QString() : model.strings.at(id);
+    };
+
+    QVector<quint8> categories(selected.size());
+    if (mode == BySectionType) {
+        m_categoryNames = QStringList{ "Kod", "Salt okunur", "Veri", "BSS", "Heap / Stack", "*fill*", "Diğer" };
+        m_categoryColors = { palette()[0], palette()[6], palette()[1], palette()[3], palette()[4],
+                             palette()[14], palette()[13] };
+        for (int k = 0; k < selected.size(); ++k) {
+            int i = selected[k];
+            categories[k] = quint8(sectionType(text(rows.name[i]), text(rows.section[i])));
+        }
+    } else {
+        // Önce arşiv başına bayt, sonra en büyükler renk alır
+        QVector<QString> archives(selected.size());
+        QHash<QString, quint64> bytes;
+        for (int k = 0; k < selected.size(); ++k) {
+            int i = selected[k];
+            QString object = text(rows.object[i]);
+            archives[k] = object.isEmpty() ? QString() : archiveOf(object);
+            if (!archives[k].isEmpty())
+                bytes[archives[k]] += rows.size[i];
+        }
+        QStringList ranked = bytes.keys();
+        std::sort(ranked.begin(), ranked.end(), [&bytes](const QString &a, const QString &b) {
+            return bytes[a] > bytes[b];
+        });
+        ranked = ranked.mid(0, MaxArchiveColors);
+
+        m_categoryNames = ranked;
+        m_categoryNames << "Diğer arşivler" << "Nesne dosyaları" << "*fill*";
+        for (int c = 0; c < ranked.size(); ++c)
+            m_categoryColors.append(palette()[c]);
+        m_categoryColors << palette()[15] << palette()[13] << palette()[14];
+
+        const int otherArchives = ranked.size(), objects = ranked.size() + 1, fill = ranked.size() + 2;
+        for (int k = 0; k < selected.size(); ++k) {
+            int i = selected[k];
+            int index = archives[k].isEmpty() ? -1 : ranked.indexOf(archives[k]);
+            if (text(rows.name[i]) == "*fill*")
+                categories[k] = quint8(fill);
+            else if (archives[k].isEmpty())
+                categories[k] = quint8(objects);
+            else
+                categories[k] = quint8(index >= 0 ? index : otherArchives);
+        }
+    }
+
+    m_spans.reserve(selected.size());
+    for (int k = 0; k < selected.size(); ++k) {
+        int i = selected[k];
+        Span span;
+        span.begin = qMax(rows.address[i], region.origin);
+        span.end = qMin(rows.address[i] + rows.size[i], regionEnd);
+        span.name = rows.name[i];
+        span.object = rows.object[i];
+        span.category = categories[k];
+        m_spans.append(span);
+    }
+    std::sort(m_spans.begin(), m_spans.end(), [](const Span &a, const Span &b) {
+        return a.begin < b.begin;
+    });
+
+    // Kareye yakın ızgara: genişlik √uzunluk'tan büyük ilk 2'nin kuvveti
+    m_width = 64;
+    while (m_width * m_width < region.length)
+        m_width *= 2;
+    m_height = qMax<quint64>(1, (region.length + m_width - 1) / m_width);
+
+    while ((quint64(TileSize) << m_maxLevel) < qMax(m_width, m_height))
+        ++m_maxLevel;
+}
+
+int OccupancyMap::tilesX(int level) const {
+    quint64 tileCells = quint64(TileSize) << level;
+    return int((m_width + tileCells - 1) / tileCells);
+}
+
+int OccupancyMap::tilesY(int level) const {
+    quint64 tileCells = quint64(TileSize) << level;
+    return int((m_height + tileCells - 1) / tileCells);
+}
+
+QImage OccupancyMap::renderTile(int level, int tileX, int tileY) const {
+    QImage image(TileSize, TileSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    const int categoryCount = m_categoryNames.size();
+    const quint64 step = quint64(1) << level;          // piksel başına hücre (her eksende)
+    const quint64 regionEnd = m_region.origin + m_region.length;
+    const quint64 x0 = quint64(tileX) * TileSize * step;
+    if (x0 >= m_width)
+        return image;
+    const quint64 x1 = qMin(m_width, x0 + quint64(TileSize) * step);
+
+    QVector<quint64> counts(TileSize * categoryCount);
+    QVector<quint64> occupied(TileSize), capacity(TileSize);
+
+    for (int py = 0; py < TileSize; ++py) {
+        quint64 gy0 = (quint64(tileY) * TileSize + quint64(py)) * step;
+        if (gy0 >= m_height)
+            break;
+        std::fill(counts.begin(), counts.end(), 0);
+        std::fill(occupied.begin(), occupied.end(), 0);
+        std::fill(capacity.begin(), capacity.end(), 0);
+
+        quint64 gy1 = qMin(m_height, gy0 + step);
+        for (quint64 gy = gy0; gy < gy1; ++gy) {
+            quint64 rowBegin = m_region.origin + gy * m_width + x0;
+            quint64 rowEnd = qMin(m_region.origin + gy * m_width + x1, regionEnd);
+            if (rowBegin >= rowEnd)
+                break;
+
+            distribute(step, rowBegin, rowBegin, rowEnd, [&capacity](int pixel, quint64 n) {
+                capacity[pixel] += n;
+            });
+
+            // Bölümler çakışmaz: bitişi satır başından büyük ilk bölümden ilerlenir
+            auto it = std::upper_bound(m_spans.constBegin(), m_spans.constEnd(), rowBegin,
+                                       [](quint64 address, const Span &span) { return address < span.end; });
+            for (; it != m_spans.constEnd() && it->begin < rowEnd; ++it) {
+                quint64 a = qMax(it->begin, rowBegin), b = qMin(it->end, rowEnd);
+                if (a >= b)
+                    continue;
+                int category = it->category;
+                distribute(step, rowBegin, a, b, [&](int pixel, quint64 n) {
+                    counts[pixel * categoryCount + category] += n;
+                    occupied[pixel] += n;
+                });
+            }
+        }
+
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(py));
+        for (int px = 0; px < TileSize; ++px) {
+            if (capacity[px] == 0)
+                continue;
+            if (occupied[px] == 0) {
+                line[px] = EmptyColor.rgba();
+                continue;
+            }
+
+            int dominant = 0;
+            for (int c = 1; c < categoryCount; ++c) {
+                if (counts[px * categoryCount + c] > counts[px * categoryCount + dominant])
+                    dominant = c;
+            }
+            // Kısmen dolu pikseller boş renge doğru açılır
+            double fill = 0.35 + 0.65 * qMin(1.0, double(occupied[px]) / double(capacity[px]));
+            const QColor &color = m_categoryColors[dominant];
+            line[px] = qRgb(int(EmptyColor.red() + (color.red() - EmptyColor.red()) * fill),
+                            int(EmptyColor.green() + (color.green() - EmptyColor.green()) * fill),
+                            int(EmptyColor.blue() + (color.blue() - EmptyColor.blue()) * fill));
+        }
+    }
+    return image;
+}
+
+bool OccupancyMap::addressAt(quint64 x, quint64 y, quint64 *address) const {
+    if (x >= m_width || y >= m_height)
+        return false;
+    quint64 offset = y * m_width + x;
+    if (offset >= m_region.length)
+        return false;
+    *address = m_region.origin + offset;
+    return true;
+}
+
+QString OccupancyMap::describe(quint64 address) const {
+    QString text = QString("0x%1").arg(address, 8, 16, QChar('0'));
+    auto it = std::upper_bound(m_spans.constBegin(), m_spans.constEnd(), address,
+                               [](quint64 value, const Span &span) { return value < span.end; });
+    if (it == m_spans.constEnd() || it->begin > address)
+        return text + "  (boş)";
+
+    text += "  " + m_strings.at(it->name);
+    if (it->object != StringPool::npos)
+        text += "  (" + m_strings.at(it->object) + ")";
+    return text + "  " + m_categoryNames.value(it->category);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QColor>
+#include <QImage>
+#include <QStringList>
+#include <QVector>
+#include "mapmodel.h"
+
+// Bir bellek bölgesinin 2B doluluk ızgarası. Adresler satır satır dizilir:
+// ızgara genişliği 2'nin kuvvetidir, 1 hücre = 1 byte. Seviye L'de her piksel
+// 2^L x 2^L hücreyi özetler (döşeme piramidi); seviye 0 byte çözünürlüğüdür.
+// Oluşturulduktan sonra değişmez, renderTile() iş parçacıklarından çağrılabilir.
+class OccupancyMap {
+public:
+    enum ColorMode { BySectionType, ByArchive };
+    static const int TileSize = 256;
+
+    OccupancyMap(const MapModel &model, const MemoryRegion &region, ColorMode mode);
+
+    quint64 gridWidth() const { return m_width; }
+    quint64 gridHeight() const { return m_height; }
+    int maxLevel() const { return m_maxLevel; }
+    int tilesX(int level) const;
+    int tilesY(int level) const;
+
+    QImage renderTile(int level, int tileX, int tileY) const;
+
+    const QStringList &categoryNames() const { return m_categoryNames; }
+    const QVector<QColor> &categoryColors() const { return m_categoryColors; }
+
+    // Izgara hücresinin adresi; bölge dışındaysa false
+    bool addressAt(quint64 x, quint64 y, quint64 *address) const;
+    // "0x20000400  .bss.buffer  (net.o)" biçiminde kısa açıklama
+    QString describe(quint64 address) const;
+
+private:
+    struct Span {
+        quint64 begin, end;
+        quint32 name, object;
+        quint8 category;
+    };
+
+    StringPool m_strings;       // paylaşımlı kopya: açıklamalar için
+    MemoryRegion m_region;
+    QVector<Span> m_spans;      // adrese göre sıralı
+    QStringList m_categoryNames;
+    QVector<QColor> m_categoryColors;
+    quint64 m_width = 0, m_height = 0;
+    int m_maxLevel = 0;
+};
@@ -0,0 +1,164 @@
+#include "paddinganalysis.h"
+#include <QHash>
+#include <QPair>
+#include <algorithm>
+
+// Linker betiklerinde bundan büyük hizalama pek görülmez
+static const quint64 MaxAlignment = 4096;
+
+// Boşluk, sonraki adresin doğal hizası içinde kalıyorsa hizalama dolgusudur.
+// Daha büyük boşluklar (". = 0x...", yığın rezervasyonu) bilinçli yerleşimdir.
+static bool isAlignmentGap(quint64 end, quint64 address) {
+    quint64 alignment = address == 0 ? MaxAlignment : qMin(address & (~address + 1), MaxAlignment);
+    return address > end && address - end < alignment;
+}
+
+// Satırları (bölge, adres) sırasına dizer; bölgesizler ve hata ayıklama bölümleri dışarıda kalır
+static QVector<int> sortedRows(const MapModel &model, const SymbolColumns &columns, bool containers) {
+    QVector<int> rows;
+    rows.reserve(columns.count());
+    for (int i = 0; i < columns.count(); ++i) {
+        if (columns.region[i] < 0)
+            continue;
+        if (containers && columns.section[i] != StringPool::npos
+            && isDebugSection(model.strings.at(columns.section[i])))
+            continue;
+        rows.append(i);
+    }
+    std::sort(rows.begin(), rows.end(), [&columns](int a, int b) {
+        if (columns.region[a] != columns.region[b])
+            return columns.region[a] < columns.region[b];
+        return columns.address[a] < columns.address[b];
+    });
+    return rows;
+}
+
+quint64 PaddingReport::total(PaddingCause cause) const {
+    quint64 sum = 0;
+    for (const QVector<quint64> &bytes : regionBytes)
+        sum += bytes[int(cause)];
+    return sum;
+}
+
+PaddingReport analyzePadding(const MapModel &model, const QVector<MemoryRegion> &regions) {
+    PaddingReport report;
+    report.regionBytes.fill(QVector<quint64>(int(PaddingCause::CauseCount), 0), regions.size());
+
+    const SymbolColumns &containers = model.sections.count() > 0 ? model.sections : model.outputs;
+    const SymbolColumns &symbols = model.symbols;
+    const quint32 fillId = model.strings.find("*fill*");
+
+    QVector<int> order = sortedRows(model, containers, true);
+    QVector<int> symbolOrder;
+    if (model.exactSymbolSizes)
+        symbolOrder = sortedRows(model, symbols, false);
+
+    auto addGap = [&](PaddingCause cause, int region, quint64 address, quint64 bytes, quint32 name, quint32 object) {
+        PaddingGap gap;
+        gap.cause = cause;
+        gap.region = region;
+        gap.address = address;
+        gap.bytes = bytes;
+        gap.name = name;
+        gap.object = object;
+        report.gaps.append(gap);
+        report.regionBytes[region][int(cause)] += bytes;
+    };
+
+    int region = -1;
+    quint64 cursor = 0;
+    int pendingFill = -1;       // sahibi henüz bilinmeyen ilk *fill* boşluğu
+    int s = 0;                  // symbolOrder üzerindeki ortak imleç
+
+    for (int row : order) {
+        quint64 address = containers.address[row];
+        quint64 end = address + containers.size[row];
+        if (containers.region[row] != region) {
+            region = containers.region[row];
+            cursor = address;
+            pendingFill = -1;
+        }
+
+        if (containers.name[row] == fillId) {
+            if (containers.size[row] > 0) {
+                if (pendingFill < 0)
+                    pendingFill = report.gaps.size();
+                addGap(PaddingCause::Fill, region, address, containers.size[row], StringPool::npos, StringPool::npos);
+            }
+            cursor = qMax(cursor, end);
+            continue;
+        }
+
+        // Dolgu, hizalanmak zorunda kalan bir sonraki bölüme aittir
+        if (pendingFill >= 0) {
+            for (int g = pendingFill; g < report.gaps.size(); ++g) {
+                report.gaps[g].name = containers.name[row];
+                report.gaps[g].object = containers.object[row];
+            }
+            pendingFill = -1;
+        }
+
+        if (isAlignmentGap(cursor, address))
+            addGap(PaddingCause::SectionAlignment, region, cursor, address - cursor,
+                   containers.name[row], containers.object[row]);
+
+        // Bu bölümün içindeki semboller: imleç yalnızca ileri gider
+        if (!symbolOrder.isEmpty()) {
+            while (s < symbolOrder.size()
+                   && (symbols.region[symbolOrder[s]] < region
+                       || (symbols.region[symbolOrder[s]] == region && symbols.address[symbolOrder[s]] < address)))
+                ++s;
+
+            quint64 symbolCursor = address;
+            for (; s < symbolOrder.size(); ++s) {
+                int sym = symbolOrder[s];
+                if (symbols.region[sym] != region || symbols.address[sym] >= end)
+                    break;
+                quint64 symbolAddress = symbols.address[sym];
+                if (symbolCursor > address && isAlignmentGap(symbolCursor, symbolAddress))
+                    addGap(PaddingCause::SymbolAlignment, region, symbolCursor, symbolAddress - symbolCursor,
+                           symbols.name[sym], symbols.object[sym] != StringPool::npos ? symbols.object[sym]
+                                                                                      : containers.object[row]);
+                symbolCursor = qMax(symbolCursor, symbolAddress + symbols.size[sym]);
+            }
+        }
+
+        cursor = qMax(cursor, end);
+    }
+    return report;
+}
+
+QVector<PaddingGap> topOffenders(const PaddingReport &report, int limit) {
+    QVector<PaddingGap> rows;
+    QHash<QPair<quint32, quint32>, int> rowOf[int(PaddingCause::CauseCount)];
+
+    for (const PaddingGap &gap : report.gaps) {
+        QHash<QPair<quint32, quint32>, int> &index = rowOf[int(gap.cause)];
+        QPair<quint32, quint32> key(gap.name, gap.object);
+        auto it = index.constFind(key);
+        if (it == index.constEnd()) {
+            index.insert(key, rows.size());
+            rows.append(gap);
+            continue;
+        }
+        PaddingGap &row = rows[it.value()];
+        row.bytes += gap.bytes;
+        ++row.count;
+    }
+
+    std::sort(rows.begin(), rows.end(), [](const PaddingGap &a, const PaddingGap &b) {
+        return a.bytes > b.bytes;
+    });
+    if (limit >= 0 && rows.size() > limit)
+        rows.resize(limit);
+    return rows;
+}
+
+QString paddingCauseName(PaddingCause cause) {
+    switch (cause) {
+    case PaddingCause::SectionAlignment: return "bölüm hizalaması";
+    case PaddingCause::SymbolAlignment:  return "sembol hizalaması";
+    case PaddingCause::Fill:             return "*fill*";
+    default:                             return QString();
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QVector>
+#include "mapmodel.h"
+
+enum class PaddingCause { SectionAlignment, SymbolAlignment, Fill, CauseCount };
+
+// Bir boşluk ve onu doğuran öğe: hizalama isteyen bir sonraki giriş bölümü
+// veya sembol. name/object bu öğenin string kimlikleridir.
+struct PaddingGap {
+    PaddingCause cause = PaddingCause::SectionAlignment;
+    int region = -1;
+    quint64 address = 0;
+    quint64 bytes = 0;
+    quint32 name = StringPool::npos;
+    quint32 object = StringPool::npos;
+    int count = 1;      // topOffenders'ta birleştirilen boşluk sayısı
+};
+
+struct PaddingReport {
+    // regionBytes[bölge][neden]
+    QVector<QVector<quint64>> regionBytes;
+    QVector<PaddingGap> gaps;   // adres sırasıyla, bölge bölge
+
+    quint64 total(PaddingCause cause) const;
+};
+
+// Her bölgeyi adres sırasıyla tek doğrusal geçişte tarar. Giriş bölümleri
+// yoksa (ELF) çıkış bölümleri kullanılır. Sembol hizalaması yalnızca sembol
+// boyutları kesin olduğunda (exactSymbolSizes) ölçülebilir.
+PaddingReport analyzePadding(const MapModel &model, const QVector<MemoryRegion> &regions);
+
+// Aynı neden, ad ve nesneye ait boşluklar toplanır; bayta göre büyükten küçüğe
+QVector<PaddingGap> topOffenders(const PaddingReport &report, int limit);
+
+QString paddingCauseName(PaddingCause cause);
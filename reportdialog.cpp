@@ -0,0 +1,39 @@
+#include "reportdialog.h"
+#include <QVBoxLayout>
+#include <QLabel>
+#include <QTableWidget>
+#include <QHeaderView>
+
+ReportDialog::ReportDialog(const QString &title, const QString &info, const QStringList &headers,
+                           const QVector<QStringList> &rows, QWidget *parent)
+    : QDialog(parent)
+{
+    setWindowTitle(title);
+    setMinimumSize(800, 450);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+
+    if (!info.isEmpty()) {
+        QLabel *infoLabel = new QLabel(info, this);
+        infoLabel->setWordWrap(true);
+        infoLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+        layout->addWidget(infoLabel);
+    }
+
+    QTableWidget *table = new QTableWidget(rows.size(), headers.size(), this);
+    table->setHorizontalHeaderLabels(headers);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->setStyleSheet("QTableWidget { background-color: #f8f9fa; border: 1px solid #ddd; }"
+                         "QHeaderView::section { background-color: #3498db; color: white; padding: 5px; }");
+
+    for (int row = 0; row < rows.size(); ++row) {
+        const QStringList &cells = rows[row];
+        for (int col = 0; col < cells.size() && col < headers.size(); ++col)
+            table->setItem(row, col, new QTableWidgetItem(cells[col]));
+    }
+
+    table->resizeColumnsToContents();
+    table->horizontalHeader()->setStretchLastSection(true);
+    layout->addWidget(table);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <QDialog>
+#include <QStringList>
+#include <QVector>
+
+// Analiz sonuçlarını başlık, açıklama ve salt okunur bir tablo olarak gösterir.
+class ReportDialog : public QDialog {
+    Q_OBJECT
+public:
+    ReportDialog(const QString &title, const QString &info, const QStringList &headers,
+                 const QVector<QStringList> &rows, QWidget *parent = nullptr);
+};
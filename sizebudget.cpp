@@ -0,0 +1,227 @@
+#include "sizebudget.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QTextStream>
+
+QString BudgetRule::scopeText() const {
+    static const char *names[] = { "region", "archive", "symbol" };
+    QString text = QString("%1 %2").arg(names[scope], pattern);
+    if (!region.isEmpty())
+        text += " @" + region;
+    return text;
+}
+
+// "480K", "2KB", "0x800", "1M"
+static bool parseSize(QString word, qint64 *value) {
+    word = word.toLower();
+    qint64 scale = 1;
+    if (word.endsWith("kb") || word.endsWith("mb")) {
+        scale = word.endsWith("kb") ? 1024 : 1024 * 1024;
+        word.chop(2);
+    } else if (!word.startsWith("0x") && (word.endsWith('k') || word.endsWith('m'))) {
+        scale = word.endsWith('k') ? 1024 : 1024 * 1024;
+        word.chop(1);
+    }
+
+    bool ok;
+    *value = word.startsWith("0x") ? word.mid(2).toLongLong(&ok, 16) : word.toLongLong(&ok, 10);
+    *value *= scale;
+    return ok && *value >= 0;
+}
+
+// "12K" → bytes, "5%" → percent
+static bool parseLimit(const QString &word, qint64 *bytes, double *percent) {
+    if (word.endsWith('%')) {
+        bool ok;
+        *percent = word.left(word.size() - 1).toDouble(&ok);
+        return ok && *percent >= 0;
+    }
+    return parseSize(word, bytes);
+}
+
+bool parseBudgetFile(const QString &path, QVector<BudgetRule> &rules, QString *error) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+
+    auto fail = [error](int line, const QString &message) -> bool {
+        if (error)
+            *error = QString("%1. satır: %2").arg(line).arg(message);
+        return false;
+    };
+
+    rules.clear();
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+    for (int lineNumber = 1; !in.atEnd(); ++lineNumber) {
+        QString line = in.readLine();
+        int comment = line.indexOf('#');
+        if (comment >= 0)
+            line.truncate(comment);
+        QStringList words = line.simplified().split(' ');
+        if (words.size() == 1 && words[0].isEmpty())
+            continue;
+        if (words.size() < 3)
+            return fail(lineNumber, "Beklenen biçim: <region|archive|symbol> <ad> <sınır>...");
+
+        BudgetRule rule;
+        rule.line = lineNumber;
+        QString scope = words[0].toLower();
+        if (scope == "region")
+            rule.scope = BudgetRule::Region;
+        else if (scope == "archive")
+            rule.scope = BudgetRule::Archive;
+        else if (scope == "symbol")
+            rule.scope = BudgetRule::Symbol;
+        else
+            return fail(lineNumber, QString("Bilinmeyen kapsam: %1").arg(words[0]));
+        rule.pattern = words[1];
+
+        QStringList limits;
+        for (int i = 2; i < words.size(); ++i) {
+            QString key = words[i].section('=', 0, 0).toLower();
+            QString value = words[i].section('=', 1);
+            if (value.isEmpty())
+                return fail(lineNumber, QString("Değer eksik: %1").arg(words[i]));
+
+            bool ok;
+            if (key == "region" && rule.scope != BudgetRule::Region) {
+                rule.region = value;
+                continue;
+            }
+            if (key == "max") {
+                ok = parseLimit(value, &rule.maxBytes, &rule.maxPercent);
+                if (ok && rule.maxPercent >= 0 && rule.scope != BudgetRule::Region)
+                    return fail(lineNumber, "Yüzde tavan yalnızca bölgeler için geçerlidir");
+            } else if (key == "growth" || key == "grow") {
+                ok = parseLimit(value, &rule.maxGrowth, &rule.maxGrowthPercent);
+            } else {
+                return fail(lineNumber, QString("Bilinmeyen sınır: %1").arg(key));
+            }
+            if (!ok)
+                return fail(lineNumber, QString("Geçersiz değer: %1").arg(words[i]));
+            limits << words[i];
+        }
+        if (limits.isEmpty())
+            return fail(lineNumber, "En az bir max= veya growth= sınırı gerekli");
+        rule.limits = limits.join(' ');
+        rules.append(rule);
+    }
+    return true;
+}
+
+static int findRegion(const QVector<MemoryRegion> &regions, const QString &name) {
+    for (int i = 0; i < regions.size(); ++i) {
+        if (regions[i].name.compare(name, Qt::CaseInsensitive) == 0)
+            return i;
+    }
+    return -1;
+}
+
+// Kuralın kapsadığı bayt sayısı; bölge bulunamazsa found false olur
+static quint64 measure(const BudgetRule &rule, const QRegularExpression &pattern,
+                       const MemoryStats &stats, const MapModel &model, bool *found) {
+    *found = true;
+    if (rule.scope == BudgetRule::Region) {
+        int index = findRegion(stats.regions, rule.pattern);
+        *found = index >= 0;
+        return index >= 0 ? stats.regions[index].used : 0;
+    }
+
+    int only = -1;
+    if (!rule.region.isEmpty()) {
+        only = findRegion(stats.regions, rule.region);
+        if (only < 0) {
+            *found = false;
+            return 0;
+        }
+    }
+
+    // Arşivler giriş bölümlerinden (yoksa sembollerden), semboller sembol tablosundan toplanır
+    const SymbolColumns &rows = rule.scope == BudgetRule::Symbol || model.sections.count() == 0
+                                ? model.symbols : model.sections;
+    const QVector<quint32> &keys = rule.scope == BudgetRule::Symbol ? rows.name : rows.object;
+
+    // Desen her string kimliği için bir kez eşlenir
+    enum { Unknown = 2 };
+    QVector<quint8> matches(model.strings.size(), quint8(Unknown));
+    quint64 total = 0;
+    for (int i = 0; i < rows.count(); ++i) {
+        int region = rows.region[i];
+        if (region < 0 || (only >= 0 && region != only))
+            continue;
+        quint32 id = keys[i];
+        if (id == StringPool::npos)
+            continue;
+        quint8 &match = matches[int(id)];
+        if (match == Unknown) {
+            QString text = model.strings.at(id);
+            if (rule.scope == BudgetRule::Archive) {
+                QString archive = archiveOf(text);
+                text = archive.isEmpty() ? QFileInfo(text).fileName() : archive;
+            }
+            match = pattern.match(text).hasMatch();
+        }
+        if (match)
+            total += rows.size[i];
+    }
+    return total;
+}
+
+QVector<BudgetResult> evaluateBudget(const QVector<BudgetRule> &rules,
+                                     const MemoryStats &stats, const MapModel &model,
+                                     const MemoryStats *baseStats, const MapModel *baseModel) {
+    const bool baseline = baseStats && baseModel;
+    QVector<BudgetResult> results;
+    results.reserve(rules.size());
+
+    for (int r = 0; r < rules.size(); ++r) {
+        const BudgetRule &rule = rules[r];
+        QRegularExpression pattern(QRegularExpression::wildcardToRegularExpression(rule.pattern));
+
+        BudgetResult result;
+        result.rule = r;
+        result.current = measure(rule, pattern, stats, model, &result.found);
+        if (baseline) {
+            bool found;
+            result.baseline = measure(rule, pattern, *baseStats, *baseModel, &found);
+            result.hasBaseline = found;
+        }
+
+        if (!result.found) {
+            results.append(result);
+            continue;
+        }
+
+        if (rule.maxBytes >= 0 && result.current > quint64(rule.maxBytes))
+            result.violations << QString("%1 > max %2").arg(result.current).arg(rule.maxBytes);
+        if (rule.maxPercent >= 0) {
+            int index = findRegion(stats.regions, rule.pattern);
+            quint64 length = stats.regions[index].length;
+            double percent = length > 0 ? result.current * 100.0 / length : 0.0;
+            if (percent > rule.maxPercent)
+                result.violations << QString("%1% > max %2%").arg(percent, 0, 'f', 2).arg(rule.maxPercent);
+        }
+
+        // Tabanda karşılığı olmayan bölge yeni sayılır: büyüme sınırları uygulanmaz
+        if (result.hasBaseline && result.current > result.baseline) {
+            quint64 growth = result.current - result.baseline;
+            if (rule.maxGrowth >= 0 && growth > quint64(rule.maxGrowth))
+                result.violations << QString("+%1 > growth %2").arg(growth).arg(rule.maxGrowth);
+            if (rule.maxGrowthPercent >= 0 && result.baseline == 0) {
+                result.violations << QString("tabanda 0 byte, yüzde büyüme sınırsız");
+            } else if (rule.maxGrowthPercent >= 0) {
+                double percent = growth * 100.0 / result.baseline;
+                if (percent > rule.maxGrowthPercent)
+                    result.violations << QString("+%1% > growth %2%")
+                                         .arg(percent, 0, 'f', 2).arg(rule.maxGrowthPercent);
+            }
+        }
+        results.append(result);
+    }
+    return results;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "MapParser.h"
+
+// Bütçe dosyasının bir satırı:
+//   region  FLASH        max=480K growth=2K
+//   region  RAM          max=90% growth=1%
+//   archive libc_nano.a  max=12K growth=5%
+//   symbol  *_buffer     region=RAM max=4K
+// max mutlak tavandır (region için bölge uzunluğunun yüzdesi de olabilir),
+// growth tabana göre bayt veya yüzde artıştır. Desenler joker ifadedir (*, ?);
+// arşiv üyesi olmayan nesneler dosya adlarıyla (main.o) eşlenir.
+struct BudgetRule {
+    enum Scope { Region, Archive, Symbol };
+
+    Scope scope = Region;
+    QString pattern;            // bölge adı, arşiv veya sembol deseni
+    QString region;             // archive/symbol için isteğe bağlı bölge kısıtı
+    qint64 maxBytes = -1;       // < 0: denetlenmez
+    double maxPercent = -1;
+    qint64 maxGrowth = -1;
+    double maxGrowthPercent = -1;
+    QString limits;             // rapor için sınırların yazıldığı hâli
+    int line = 0;
+
+    bool needsBaseline() const { return maxGrowth >= 0 || maxGrowthPercent >= 0; }
+    QString scopeText() const;
+};
+
+struct BudgetResult {
+    int rule = -1;
+    bool found = true;          // bölge adı adayda (veya tabanda) bulunamadıysa false
+    quint64 current = 0;
+    quint64 baseline = 0;
+    bool hasBaseline = false;
+    QStringList violations;
+
+    bool passed() const { return found && violations.isEmpty(); }
+};
+
+bool parseBudgetFile(const QString &path, QVector<BudgetRule> &rules, QString *error = nullptr);
+
+// Her kural tek doğrusal geçişte ölçülür; baseStats/baseModel yoksa büyüme
+// sınırları denetlenmez. Arşiv ve sembol toplamlarına yalnızca bir bölgeye
+// yerleşen satırlar girer.
+QVector<BudgetResult> evaluateBudget(const QVector<BudgetRule> &rules,
+                                     const MemoryStats &stats, const MapModel &model,
+                                     const MemoryStats *baseStats = nullptr,
+                                     const MapModel *baseModel = nullptr);
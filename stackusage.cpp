@@ -0,0 +1,303 @@
+#include "stackusage.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSet>
+#include <QTextStream>
+#include <algorithm>
+
+static QStringList readLines(const QString &path, bool *ok) {
+    QFile file(path);
+    *ok = file.open(QIODevice::ReadOnly | QIODevice::Text);
+    if (!*ok)
+        return QStringList();
+    return QTextStream(&file).readAll().split('\n');
+}
+
+quint32 StackAnalyzer::node(const QString &name) {
+    quint32 id = m_names.intern(name);
+    if (int(id) >= m_frame.size()) {
+        m_frame.append(0);
+        m_flags.append(0);
+    }
+    return id;
+}
+
+void StackAnalyzer::setFrame(quint32 id, quint64 bytes, bool dynamic) {
+    // Aynı adlı static fonksiyonlar farklı dosyalarda olabilir; büyüğü tutulur
+    if (!(m_flags[id] & HasFrame) || bytes > m_frame[id])
+        m_frame[id] = bytes;
+    m_flags[id] |= HasFrame;
+    if (dynamic)
+        m_flags[id] |= Dynamic;
+}
+
+void StackAnalyzer::addEdge(quint32 from, quint32 to) {
+    m_edgeFrom.append(from);
+    m_edgeTo.append(to);
+}
+
+int StackAnalyzer::loadStackUsage(const QString &suPath) {
+    bool ok;
+    QStringList lines = readLines(suPath, &ok);
+    if (!ok)
+        return -1;
+
+    // "main.c:10:5:main<TAB>16<TAB>static"
+    static const QRegularExpression location("^(.*?):(\\d+):(\\d+):(.+)$");
+    int count = 0;
+    for (const QString &line : lines) {
+        QStringList fields = line.split('\t');
+        if (fields.size() < 3)
+            continue;
+
+        QRegularExpressionMatch match = location.match(fields[0]);
+        if (!match.hasMatch())
+            continue;
+
+        bool numberOk;
+        quint64 bytes = fields[1].trimmed().toULongLong(&numberOk);
+        if (!numberOk)
+            continue;
+
+        setFrame(node(match.captured(4)), bytes, fields[2].contains("dynamic"));
+        ++count;
+    }
+    return count;
+}
+
+int StackAnalyzer::loadStackUsageForObjects(const QStringList &objectFiles, const QString &baseDir) {
+    int count = 0;
+    QDir base(baseDir);
+    for (const QString &object : objectFiles) {
+        // Arşiv üyeleri (libfoo.a(bar.o)) için .su dosyası ayrı durmaz
+        if (object.endsWith(')'))
+            continue;
+
+        // GCC çıktı adının son uzantısını .su ile değiştirir: main.c.o → main.c.su
+        QFileInfo info(base.absoluteFilePath(object));
+        QString suPath = info.absolutePath() + "/" + info.completeBaseName() + ".su";
+        if (!QFile::exists(suPath))
+            continue;
+
+        int loaded = loadStackUsage(suPath);
+        if (loaded > 0)
+            count += loaded;
+    }
+    return count;
+}
+
+bool StackAnalyzer::loadCallGraph(const QString &path) {
+    bool ok;
+    QStringList lines = readLines(path, &ok);
+    if (!ok)
+        return false;
+
+    for (const QString &line : lines) {
+        if (line.startsWith("graph:") || line.contains("node: {"))
+            return loadVcg(lines);
+    }
+    return loadObjdump(lines);
+}
+
+// gcc -fcallgraph-info=su çıktısı:
+//   node: { title: "main" label: "main\nmain.c:5:5\n16 bytes (static)\n..." }
+//   edge: { sourcename: "main" targetname: "foo" label: "main.c:7:3" }
+bool StackAnalyzer::loadVcg(const QStringList &lines) {
+    static const QRegularExpression nodeRe("node:\\s*\\{\\s*title:\\s*\"([^\"]+)\"(?:\\s*label:\\s*\"([^\"]*)\")?");
+    static const QRegularExpression edgeRe("edge:\\s*\\{\\s*sourcename:\\s*\"([^\"]+)\"\\s*targetname:\\s*\"([^\"]+)\"");
+    static const QRegularExpression frameRe("(\\d+) bytes \\(([^)]*)\\)");
+
+    for (const QString &line : lines) {
+        QRegularExpressionMatch match = nodeRe.match(line);
+        if (match.hasMatch()) {
+            if (match.captured(1) == "__indirect_call")
+                continue;
+            quint32 id = node(match.captured(1));
+            QRegularExpressionMatch frame = frameRe.match(match.captured(2));
+            if (frame.hasMatch())
+                setFrame(id, frame.captured(1).toULongLong(), frame.captured(2).contains("dynamic"));
+            continue;
+        }
+
+        match = edgeRe.match(line);
+        if (match.hasMatch()) {
+            quint32 from = node(match.captured(1));
+            if (match.captured(2) == "__indirect_call")
+                m_flags[from] |= Indirect;
+            else
+                addEdge(from, node(match.captured(2)));
+        }
+    }
+    return true;
+}
+
+// objdump -d çıktısı:
+//   08000188 <main>:
+//    800018c:	f000 f810 	bl	80001b0 <foo>
+//    8000190:	4798      	blx	r3
+bool StackAnalyzer::loadObjdump(const QStringList &lines) {
+    static const QRegularExpression functionRe("^[0-9a-fA-F]+ <([^>]+)>:\\s*$");
+    static const QRegularExpression targetRe("<([^>+]+)(\\+0x[0-9a-fA-F]+)?>");
+    static const QSet<QString> calls = { "bl", "blx", "call", "callq", "calll", "jal", "jalr", "bsr", "brasl" };
+    static const QSet<QString> jumps = { "b", "jmp", "jmpq", "j" };
+
+    quint32 current = StringPool::npos;
+    bool found = false;
+    for (const QString &line : lines) {
+        QRegularExpressionMatch match = functionRe.match(line);
+        if (match.hasMatch()) {
+            current = node(match.captured(1));
+            found = true;
+            continue;
+        }
+        if (current == StringPool::npos)
+            continue;
+
+        QStringList fields = line.split('\t');
+        if (fields.size() < 3)
+            continue;
+
+        QString instruction = fields.mid(2).join(' ').simplified();
+        QString mnemonic = instruction.section(' ', 0, 0).toLower();
+        QString operands = instruction.section(' ', 1);
+        mnemonic = mnemonic.section('.', 0, 0);   // bl.w, b.n ...
+
+        bool isCall = calls.contains(mnemonic);
+        bool isJump = jumps.contains(mnemonic);
+        if (!isCall && !isJump)
+            continue;
+
+        QRegularExpressionMatch target = targetRe.match(operands);
+        if (!target.hasMatch()) {
+            // blx r3, call *%rax → fonksiyon işaretçisi
+            if (isCall)
+                m_flags[current] |= Indirect;
+            continue;
+        }
+
+        QString name = target.captured(1);
+        bool hasOffset = !target.captured(2).isEmpty();
+        // Fonksiyon içi dallanmalar çağrı değildir; ofsetsiz b/jmp kuyruk çağrısıdır
+        if (hasOffset && (isJump || m_names.find(name) == current))
+            continue;
+        if (isJump && m_names.find(name) == current)
+            continue;
+
+        addEdge(current, node(name));
+    }
+    return found;
+}
+
+QVector<StackEntryReport> StackAnalyzer::analyze(const QStringList &entryPoints) const {
+    const quint8 Cycle = 0x08;
+
+    const int n = m_names.size();
+    m_cycles.clear();
+
+    // Kenar listesinden CSR: offsets[u]..offsets[u+1] aralığı u'nun çağırdıkları
+    QVector<int> offsets(n + 1, 0);
+    QVector<int> inDegree(n, 0);
+    for (int i = 0; i < m_edgeFrom.size(); ++i) {
+        ++offsets[int(m_edgeFrom[i]) + 1];
+        ++inDegree[int(m_edgeTo[i])];
+    }
+    for (int i = 0; i < n; ++i)
+        offsets[i + 1] += offsets[i];
+    QVector<quint32> targets(m_edgeTo.size());
+    QVector<int> fill = offsets;
+    for (int i = 0; i < m_edgeFrom.size(); ++i)
+        targets[fill[int(m_edgeFrom[i])]++] = m_edgeTo[i];
+
+    QVector<quint32> roots;
+    if (entryPoints.isEmpty()) {
+        for (int i = 0; i < n; ++i) {
+            if (inDegree[i] == 0)
+                roots.append(quint32(i));
+        }
+    } else {
+        for (const QString &name : entryPoints) {
+            quint32 id = m_names.find(name);
+            if (id != StringPool::npos)
+                roots.append(id);
+        }
+    }
+
+    // Memoize edilmiş, özyinelemesiz DFS: her düğüm bir kez çözülür
+    QVector<quint8> state(n, 0);            // 0: görülmedi, 1: yığında, 2: bitti
+    QVector<quint64> worst(n, 0);
+    QVector<quint32> next(n, StringPool::npos);
+    QVector<quint8> flags(n, 0);
+    QVector<int> unknown(n, 0);
+
+    struct Frame { quint32 node; int edge; };
+    QVector<Frame> stack;
+
+    for (quint32 root : roots) {
+        if (state[int(root)] == 2)
+            continue;
+
+        state[int(root)] = 1;
+        stack.append({ root, offsets[int(root)] });
+        while (!stack.isEmpty()) {
+            Frame &top = stack.last();
+            int u = int(top.node);
+            if (top.edge < offsets[u + 1]) {
+                quint32 child = targets[top.edge++];
+                if (state[int(child)] == 0) {
+                    state[int(child)] = 1;
+                    stack.append({ child, offsets[int(child)] });
+                } else if (state[int(child)] == 1) {
+                    flags[u] |= Cycle;
+                    m_cycles.append(m_names.at(quint32(u)) + " -> " + m_names.at(child));
+                }
+                continue;
+            }
+            stack.removeLast();
+
+            quint8 f = flags[u] | (m_flags[u] & (Dynamic | Indirect));
+
+            quint64 best = 0;
+            quint32 bestChild = StringPool::npos;
+            for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+                int c = int(targets[e]);
+                if (state[c] != 2)   // geri kenar: döngü, derinliğe katılmaz
+                    continue;
+                f |= flags[c];
+                if (bestChild == StringPool::npos || worst[c] > best) {
+                    best = worst[c];
+                    bestChild = quint32(c);
+                }
+            }
+
+            worst[u] = m_frame[u] + best;
+            next[u] = bestChild;
+            flags[u] = f;
+            unknown[u] = ((m_flags[u] & HasFrame) ? 0 : 1)
+                         + (bestChild != StringPool::npos ? unknown[int(bestChild)] : 0);
+            state[u] = 2;
+        }
+    }
+
+    QVector<StackEntryReport> reports;
+    for (quint32 root : roots) {
+        int r = int(root);
+        StackEntryReport report;
+        report.function = m_names.at(root);
+        report.worstBytes = worst[r];
+        report.recursive = flags[r] & Cycle;
+        report.indirect = flags[r] & Indirect;
+        report.dynamic = flags[r] & Dynamic;
+        report.unknownFrames = unknown[r];
+        for (quint32 id = root; id != StringPool::npos; id = next[int(id)])
+            report.path.append(m_names.at(id));
+        reports.append(report);
+    }
+
+    std::sort(reports.begin(), reports.end(), [](const StackEntryReport &a, const StackEntryReport &b) {
+        return a.worstBytes > b.worstBytes;
+    });
+    m_cycles.removeDuplicates();
+    return reports;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "mapmodel.h"
+
+// GCC -fstack-usage (.su) çıktıları ve çağrı grafiğinden en kötü durum
+// stack derinliği hesabı.
+struct StackEntryReport {
+    QString function;
+    quint64 worstBytes = 0;
+    QStringList path;          // en derin çağrı zinciri
+    bool recursive = false;    // zincirde döngü var, sonuç alt sınırdır
+    bool indirect = false;     // fonksiyon işaretçisi çağrısı var, sonuç alt sınırdır
+    bool dynamic = false;      // .su "dynamic" çerçeve (alloca/VLA)
+    int unknownFrames = 0;     // .su kaydı bulunamayan fonksiyon sayısı
+};
+
+class StackAnalyzer {
+public:
+    // Tek bir .su dosyası; okunan kayıt sayısını döndürür, açılamazsa -1
+    int loadStackUsage(const QString &suPath);
+    // Map'teki nesne dosyalarının yanındaki .su dosyalarını bulur ve okur
+    int loadStackUsageForObjects(const QStringList &objectFiles, const QString &baseDir);
+    // -fcallgraph-info .ci (VCG) veya objdump -d çıktısı
+    bool loadCallGraph(const QString &path);
+
+    int functionCount() const { return m_names.size(); }
+    int edgeCount() const { return m_edgeFrom.size(); }
+
+    // entryPoints boşsa çağrılmayan tüm fonksiyonlar giriş noktası kabul edilir.
+    // Sonuçlar en derinden en sığa sıralıdır.
+    QVector<StackEntryReport> analyze(const QStringList &entryPoints = QStringList()) const;
+    // Son analizde bulunan döngü kenarları ("a -> b")
+    QStringList cycles() const { return m_cycles; }
+
+private:
+    enum NodeFlag : quint8 {
+        HasFrame = 0x01,
+        Dynamic  = 0x02,
+        Indirect = 0x04,
+    };
+
+    quint32 node(const QString &name);
+    void setFrame(quint32 id, quint64 bytes, bool dynamic);
+    void addEdge(quint32 from, quint32 to);
+    bool loadVcg(const QStringList &lines);
+    bool loadObjdump(const QStringList &lines);
+
+    StringPool m_names;
+    QVector<quint64> m_frame;
+    QVector<quint8> m_flags;
+    QVector<quint32> m_edgeFrom, m_edgeTo;
+    mutable QStringList m_cycles;
+};
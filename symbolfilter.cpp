@@ -0,0 +1,446 @@
+#include "symbolfilter.h"
+#include <QRegularExpression>
+#include <cstring>
+
+namespace {
+
+enum class Field { Name, Section, Object, Archive, Region, Size, Address };
+enum class Op { Equal, NotEqual, Match, NotMatch, Less, LessEqual, Greater, GreaterEqual };
+
+struct Context {
+    const MapModel *model;
+    const QVector<MemoryRegion> *regions;
+};
+
+} // namespace
+
+class SymbolFilter::Node {
+public:
+    virtual ~Node() {}
+    // Modele bağlı önbellekleri hazırlar
+    virtual void bind(const Context &context) = 0;
+    // out[0 .. end-begin) = satır eşleşiyor mu (0/1)
+    virtual void evaluate(int begin, int end, quint8 *out) const = 0;
+};
+
+namespace {
+
+class NotNode : public SymbolFilter::Node {
+public:
+    explicit NotNode(std::shared_ptr<Node> child) : m_child(child) {}
+    void bind(const Context &context) override { m_child->bind(context); }
+    void evaluate(int begin, int end, quint8 *out) const override {
+        m_child->evaluate(begin, end, out);
+        for (int i = 0; i < end - begin; ++i)
+            out[i] ^= 1;
+    }
+private:
+    std::shared_ptr<Node> m_child;
+};
+
+class LogicNode : public SymbolFilter::Node {
+public:
+    LogicNode(bool isAnd, std::shared_ptr<Node> left, std::shared_ptr<Node> right)
+        : m_and(isAnd), m_left(left), m_right(right) {}
+
+    void bind(const Context &context) override {
+        m_left->bind(context);
+        m_right->bind(context);
+    }
+
+    void evaluate(int begin, int end, quint8 *out) const override {
+        const int n = end - begin;
+        m_left->evaluate(begin, end, out);
+
+        // Blok tamamen belirlendiyse sağ taraf hiç değerlendirilmez
+        bool any = false, all = true;
+        for (int i = 0; i < n; ++i) {
+            any |= out[i] != 0;
+            all &= out[i] != 0;
+        }
+        if ((m_and && !any) || (!m_and && all))
+            return;
+
+        quint8 right[SymbolFilter::BlockSize];
+        m_right->evaluate(begin, end, right);
+        if (m_and) {
+            for (int i = 0; i < n; ++i)
+                out[i] &= right[i];
+        } else {
+            for (int i = 0; i < n; ++i)
+                out[i] |= right[i];
+        }
+    }
+
+private:
+    bool m_and;
+    std::shared_ptr<Node> m_left, m_right;
+};
+
+class NumberNode : public SymbolFilter::Node {
+public:
+    NumberNode(Field field, Op op, quint64 value) : m_field(field), m_op(op), m_value(value) {}
+
+    void bind(const Context &context) override {
+        const SymbolColumns &symbols = context.model->symbols;
+        m_column = (m_field == Field::Size ? symbols.size : symbols.address).constData();
+    }
+
+    void evaluate(int begin, int end, quint8 *out) const override {
+        const quint64 *values = m_column + begin;
+        const quint64 v = m_value;
+        const int n = end - begin;
+        // Her işleç için ayrı düz döngü: derleyici vektörleştirebilir
+        switch (m_op) {
+        case Op::Equal:        for (int i = 0; i < n; ++i) out[i] = values[i] == v; break;
+        case Op::NotEqual:     for (int i = 0; i < n; ++i) out[i] = values[i] != v; break;
+        case Op::Less:         for (int i = 0; i < n; ++i) out[i] = values[i] <  v; break;
+        case Op::LessEqual:    for (int i = 0; i < n; ++i) out[i] = values[i] <= v; break;
+        case Op::Greater:      for (int i = 0; i < n; ++i) out[i] = values[i] >  v; break;
+        case Op::GreaterEqual: for (int i = 0; i < n; ++i) out[i] = values[i] >= v; break;
+        default:               std::memset(out, 0, size_t(n)); break;
+        }
+    }
+
+private:
+    Field m_field;
+    Op m_op;
+    quint64 m_value;
+    const quint64 *m_column = nullptr;
+};
+
+// name/section/object/archive: string kimliği başına bir kez hesaplanan sonuç tablosu
+class TextNode : public SymbolFilter::Node {
+public:
+    TextNode(Field field, Op op, const QString &value) : m_field(field), m_op(op), m_value(value) {
+        if (op == Op::Match || op == Op::NotMatch)
+            m_regex.setPattern(value);
+    }
+
+    void bind(const Context &context) override {
+        const SymbolColumns &symbols = context.model->symbols;
+        m_strings = &context.model->strings;
+        switch (m_field) {
+        case Field::Name:    m_column = symbols.name.constData(); break;
+        case Field::Section: m_column = symbols.section.constData(); break;
+        default:             m_column = symbols.object.constData(); break;
+        }
+        m_cache.fill(quint8(Unknown), m_strings->size() + 1);
+    }
+
+    void evaluate(int begin, int end, quint8 *out) const override {
+        const quint32 *ids = m_column + begin;
+        const int missing = m_cache.size() - 1;   // npos için ayrılan son hücre
+        for (int i = 0; i < end - begin; ++i) {
+            int slot = ids[i] == StringPool::npos ? missing : int(ids[i]);
+            quint8 &cached = m_cache[slot];
+            if (cached == Unknown)
+                cached = matches(slot == missing ? QString() : m_strings->at(ids[i])) ? 1 : 0;
+            out[i] = cached;
+        }
+    }
+
+private:
+    enum { Unknown = 2 };
+
+    bool matches(const QString &raw) const {
+        QString text = m_field == Field::Archive ? archiveOf(raw) : raw;
+        switch (m_op) {
+        case Op::Equal:    return text == m_value;
+        case Op::NotEqual: return text != m_value;
+        case Op::Match:    return m_regex.match(text).hasMatch();
+        case Op::NotMatch: return !m_regex.match(text).hasMatch();
+        default:           return false;
+        }
+    }
+
+    Field m_field;
+    Op m_op;
+    QString m_value;
+    QRegularExpression m_regex;
+    const StringPool *m_strings = nullptr;
+    const quint32 *m_column = nullptr;
+    mutable QVector<quint8> m_cache;
+};
+
+// region: bölge adı bölge indeksine çözülür, satırlarda yalnızca tamsayı karşılaştırılır
+class RegionNode : public SymbolFilter::Node {
+public:
+    RegionNode(Op op, const QString &value) : m_op(op), m_value(value) {
+        if (op == Op::Match || op == Op::NotMatch)
+            m_regex.setPattern(value);
+    }
+
+    void bind(const Context &context) override {
+        const QVector<MemoryRegion> &regions = *context.regions;
+        m_column = context.model->symbols.region.constData();
+        m_match.fill(0, regions.size() + 1);
+        for (int i = 0; i <= regions.size(); ++i) {
+            QString name = i < regions.size() ? regions[i].name : QString();
+            bool hit;
+            switch (m_op) {
+            case Op::Equal:    hit = name.compare(m_value, Qt::CaseInsensitive) == 0; break;
+            case Op::NotEqual: hit = name.compare(m_value, Qt::CaseInsensitive) != 0; break;
+            case Op::Match:    hit = m_regex.match(name).hasMatch(); break;
+            case Op::NotMatch: hit = !m_regex.match(name).hasMatch(); break;
+            default:           hit = false; break;
+            }
+            m_match[i] = hit ? 1 : 0;
+        }
+    }
+
+    void evaluate(int begin, int end, quint8 *out) const override {
+        const qint32 *regions = m_column + begin;
+        const int none = m_match.size() - 1;   // -1 (bölge yok) son hücreye düşer
+        for (int i = 0; i < end - begin; ++i)
+            out[i] = m_match[regions[i] < 0 ? none : regions[i]];
+    }
+
+private:
+    Op m_op;
+    QString m_value;
+    QRegularExpression m_regex;
+    const qint32 *m_column = nullptr;
+    QVector<quint8> m_match;
+};
+
+// Özyinelemeli iniş ayrıştırıcı
+class Parser {
+public:
+    explicit Parser(const QString &text) : m_text(text) {}
+
+    std::shared_ptr<SymbolFilter::Node> parse() {
+        std::shared_ptr<SymbolFilter::Node> node = parseOr();
+        skipSpace();
+        if (node && m_pos < m_text.size())
+            fail(QString("Beklenmeyen karakter: '%1'").arg(m_text.mid(m_pos, 1)));
+        return m_error.isEmpty() ? node : nullptr;
+    }
+
+    QString error() const { return m_error; }
+
+private:
+    void skipSpace() {
+        while (m_pos < m_text.size() && m_text[m_pos].isSpace())
+            ++m_pos;
+    }
+
+    bool accept(const char *token) {
+        skipSpace();
+        QLatin1String literal(token);
+        if (m_text.midRef(m_pos).startsWith(literal)) {
+            m_pos += literal.size();
+            return true;
+        }
+        return false;
+    }
+
+    void fail(const QString &message) {
+        if (m_error.isEmpty())
+            m_error = QString("%1 (konum %2)").arg(message).arg(m_pos + 1);
+    }
+
+    std::shared_ptr<SymbolFilter::Node> parseOr() {
+        std::shared_ptr<SymbolFilter::Node> left = parseAnd();
+        while (left && accept("||")) {
+            std::shared_ptr<SymbolFilter::Node> right = parseAnd();
+            if (!right)
+                return nullptr;
+            left = std::make_shared<LogicNode>(false, left, right);
+        }
+        return left;
+    }
+
+    std::shared_ptr<SymbolFilter::Node> parseAnd() {
+        std::shared_ptr<SymbolFilter::Node> left = parseUnary();
+        while (left && accept("&&")) {
+            std::shared_ptr<SymbolFilter::Node> right = parseUnary();
+            if (!right)
+                return nullptr;
+            left = std::make_shared<LogicNode>(true, left, right);
+        }
+        return left;
+    }
+
+    std::shared_ptr<SymbolFilter::Node> parseUnary() {
+        skipSpace();
+        // "!=" ve "!~" karşılaştırma işleçleridir, burada yalnızca tekli "!" alınır
+        if (m_pos < m_text.size() && m_text[m_pos] == '!'
+            && !(m_pos + 1 < m_text.size() && (m_text[m_pos + 1] == '=' || m_text[m_pos + 1] == '~'))) {
+            ++m_pos;
+            std::shared_ptr<SymbolFilter::Node> child = parseUnary();
+            return child ? std::make_shared<NotNode>(child) : nullptr;
+        }
+        if (accept("(")) {
+            std::shared_ptr<SymbolFilter::Node> inner = parseOr();
+            if (inner && !accept(")")) {
+                fail("')' bekleniyor");
+                return nullptr;
+            }
+            return inner;
+        }
+        return parseComparison();
+    }
+
+    QString parseWord() {
+        skipSpace();
+        int start = m_pos;
+        while (m_pos < m_text.size()
+               && (m_text[m_pos].isLetterOrNumber() || m_text[m_pos] == '_' || m_text[m_pos] == '.'))
+            ++m_pos;
+        return m_text.mid(start, m_pos - start);
+    }
+
+    bool parseString(QString *value) {
+        skipSpace();
+        if (m_pos >= m_text.size() || m_text[m_pos] != '"') {
+            *value = parseWord();
+            return !value->isEmpty();
+        }
+
+        ++m_pos;
+        value->clear();
+        while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+            // \" dışındaki kaçışlar regex'e olduğu gibi geçer (\.bss)
+            if (m_text[m_pos] == '\\' && m_pos + 1 < m_text.size() && m_text[m_pos + 1] == '"')
+                ++m_pos;
+            value->append(m_text[m_pos++]);
+        }
+        if (m_pos >= m_text.size()) {
+            fail("Kapanmamış tırnak");
+            return false;
+        }
+        ++m_pos;
+        return true;
+    }
+
+    bool parseNumber(quint64 *value) {
+        QString word = parseWord().toLower();
+        quint64 scale = 1;
+        if (word.endsWith("kb") || word.endsWith("mb")) {
+            scale = word.endsWith("kb") ? 1024 : 1024 * 1024;
+            word.chop(2);
+        } else if (!word.startsWith("0x") && (word.endsWith('k') || word.endsWith('m'))) {
+            scale = word.endsWith('k') ? 1024 : 1024 * 1024;
+            word.chop(1);
+        }
+
+        bool ok;
+        *value = word.startsWith("0x") ? word.mid(2).toULongLong(&ok, 16) : word.toULongLong(&ok, 10);
+        *value *= scale;
+        return ok;
+    }
+
+    bool parseOp(Op *op) {
+        static const struct { const char *text; Op op; } ops[] = {
+            { "==", Op::Equal }, { "!=", Op::NotEqual }, { "=~", Op::Match }, { "!~", Op::NotMatch },
+            { "<=", Op::LessEqual }, { ">=", Op::GreaterEqual }, { "<", Op::Less }, { ">", Op::Greater },
+            { "=", Op::Equal },
+        };
+        for (const auto &candidate : ops) {
+            if (accept(candidate.text)) {
+                *op = candidate.op;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::shared_ptr<SymbolFilter::Node> parseComparison() {
+        QString name = parseWord().toLower();
+        Field field;
+        if (name == "name" || name == "symbol")
+            field = Field::Name;
+        else if (name == "section")
+            field = Field::Section;
+        else if (name == "object" || name == "file")
+            field = Field::Object;
+        else if (name == "archive" || name == "lib")
+            field = Field::Archive;
+        else if (name == "region")
+            field = Field::Region;
+        else if (name == "size")
+            field = Field::Size;
+        else if (name == "address" || name == "addr")
+            field = Field::Address;
+        else {
+            fail(name.isEmpty() ? QString("Alan adı bekleniyor") : QString("Bilinmeyen alan: %1").arg(name));
+            return nullptr;
+        }
+
+        Op op;
+        if (!parseOp(&op)) {
+            fail("Karşılaştırma işleci bekleniyor");
+            return nullptr;
+        }
+
+        bool numeric = field == Field::Size || field == Field::Address;
+        bool textOp = op == Op::Equal || op == Op::NotEqual || op == Op::Match || op == Op::NotMatch;
+        if (numeric) {
+            quint64 value;
+            if (op == Op::Match || op == Op::NotMatch || !parseNumber(&value)) {
+                fail("Sayı bekleniyor");
+                return nullptr;
+            }
+            return std::make_shared<NumberNode>(field, op, value);
+        }
+
+        QString value;
+        if (!textOp || !parseString(&value)) {
+            fail("Metin değeri bekleniyor");
+            return nullptr;
+        }
+        if ((op == Op::Match || op == Op::NotMatch) && !QRegularExpression(value).isValid()) {
+            fail(QString("Geçersiz düzenli ifade: %1").arg(value));
+            return nullptr;
+        }
+        if (field == Field::Region)
+            return std::make_shared<RegionNode>(op, value);
+        return std::make_shared<TextNode>(field, op, value);
+    }
+
+    QString m_text;
+    int m_pos = 0;
+    QString m_error;
+};
+
+} // namespace
+
+SymbolFilter SymbolFilter::compile(const QString &expression) {
+    SymbolFilter filter;
+    Parser parser(expression);
+    filter.m_root = parser.parse();
+    filter.m_error = parser.error();
+    if (!filter.m_root && filter.m_error.isEmpty())
+        filter.m_error = "Boş ifade";
+    return filter;
+}
+
+QVector<int> SymbolFilter::apply(const MapModel &model, const QVector<MemoryRegion> &regions) const {
+    QVector<int> rows;
+    if (!m_root)
+        return rows;
+
+    Context context = { &model, &regions };
+    m_root->bind(context);
+
+    quint8 mask[BlockSize];
+    const int count = model.symbols.count();
+    for (int begin = 0; begin < count; begin += BlockSize) {
+        int end = qMin(begin + BlockSize, count);
+        m_root->evaluate(begin, end, mask);
+        for (int i = 0; i < end - begin; ++i) {
+            if (mask[i])
+                rows.append(begin + i);
+        }
+    }
+    return rows;
+}
+
+bool SymbolFilter::looksLikeExpression(const QString &text) {
+    // "std::vector<int>" gibi adlar düz arama kalsın: ifade bir alan adıyla başlar
+    static const QRegularExpression expression(
+        "^[\\s!(]*(name|symbol|section|object|file|archive|lib|region|size|address|addr)\\s*[=!<>]",
+        QRegularExpression::CaseInsensitiveOption);
+    return expression.match(text).hasMatch();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <memory>
+#include "mapmodel.h"
+
+// Sembol tablosu için küçük sorgu dili:
+//   region==RAM && section=~"\.bss" && size>1024 && object=~"lwip"
+//
+// Alanlar : name, section, object, archive, region, size, address
+// İşleçler: == != =~ !~ < <= > >=, &&, ||, !, parantez
+// Değerler: "metin", çıplak kelime (RAM), sayı (1024, 0x400, 4K, 1M)
+//
+// İfade bir kez düğüm ağacına derlenir; değerlendirme sütunlar üzerinde
+// blok blok (BlockSize satır) yapılır. Metin karşılaştırmaları her farklı
+// string kimliği için yalnızca bir kez hesaplanır.
+class SymbolFilter {
+public:
+    class Node;
+    static const int BlockSize = 4096;
+
+    static SymbolFilter compile(const QString &expression);
+
+    bool isValid() const { return m_root != nullptr; }
+    QString errorString() const { return m_error; }
+
+    // Eşleşen sembol satırlarının indeksleri (artan sırada). Düğümler modele
+    // bağlanan önbellek tutar; aynı filtre iki iş parçacığında birlikte çalıştırılmamalı.
+    QVector<int> apply(const MapModel &model, const QVector<MemoryRegion> &regions) const;
+
+    // Arama kutusundaki metnin düz arama mı, ifade mi olduğunu ayırt eder
+    static bool looksLikeExpression(const QString &text);
+
+private:
+    std::shared_ptr<Node> m_root;
+    QString m_error;
+};
@@ -0,0 +1,71 @@
+#include "symboltabledialog.h"
+#include "symboltablemodel.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QTableView>
+#include <QHeaderView>
+#include <QTimer>
+#include <QApplication>
+
+SymbolTableDialog::SymbolTableDialog(const MapModel &model, const QVector<MemoryRegion> &regions,
+                                     QSharedPointer<Demangler> demangler, QWidget *parent)
+    : QDialog(parent)
+{
+    setWindowTitle("Semboller");
+    setMinimumSize(900, 550);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    QHBoxLayout *searchLayout = new QHBoxLayout();
+
+    searchEdit = new QLineEdit(this);
+    searchEdit->setPlaceholderText("Sembol ara, ön ek için _ZN4core* ... veya: region==RAM && size>1K && object=~\"lwip\"");
+    searchEdit->setClearButtonEnabled(true);
+    countLabel = new QLabel(this);
+    searchLayout->addWidget(searchEdit);
+    searchLayout->addWidget(countLabel);
+    layout->addLayout(searchLayout);
+
+    tableModel = new SymbolTableModel(model, regions, demangler, this);
+    tableView = new QTableView(this);
+    tableView->setModel(tableModel);
+    tableView->setSortingEnabled(true);
+    tableView->sortByColumn(SymbolTableModel::AddressColumn, Qt::AscendingOrder);
+    tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    tableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    tableView->verticalHeader()->setDefaultSectionSize(22);
+    tableView->verticalHeader()->hide();
+    tableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    tableView->horizontalHeader()->setStretchLastSection(true);
+    tableView->setColumnWidth(SymbolTableModel::NameColumn, 320);
+    tableView->setStyleSheet("QTableView { background-color: #f8f9fa; border: 1px solid #ddd; }"
+                             "QHeaderView::section { background-color: #3498db; color: white; padding: 5px; }");
+    layout->addWidget(tableView);
+
+    // Her tuşta değil, yazma durunca ara
+    searchTimer = new QTimer(this);
+    searchTimer->setSingleShot(true);
+    searchTimer->setInterval(250);
+    connect(searchTimer, &QTimer::timeout, this, &SymbolTableDialog::applySearch);
+    connect(searchEdit, &QLineEdit::textChanged, searchTimer, QOverload<>::of(&QTimer::start));
+
+    countLabel->setText(QString("%1 sembol").arg(tableModel->totalCount()));
+}
+
+void SymbolTableDialog::applySearch() {
+    QString error;
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    bool ok = tableModel->setSearch(searchEdit->text(), &error);
+    if (ok) {
+        QHeaderView *header = tableView->horizontalHeader();
+        tableModel->sort(header->sortIndicatorSection(), header->sortIndicatorOrder());
+    }
+    QApplication::restoreOverrideCursor();
+
+    if (!ok) {
+        countLabel->setText(QString("<span style='color:#c0392b'>%1</span>").arg(error.toHtmlEscaped()));
+        return;
+    }
+    countLabel->setText(QString("%1 / %2 sembol").arg(tableModel->rowCount()).arg(tableModel->totalCount()));
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QDialog>
+#include <QSharedPointer>
+#include "mapmodel.h"
+#include "demangler.h"
+
+class QLabel;
+class QLineEdit;
+class QTableView;
+class QTimer;
+class SymbolTableModel;
+
+// Sembol tablosu: arama kutusu ve sıralanabilir, tembel çözülen ad sütunu
+class SymbolTableDialog : public QDialog {
+    Q_OBJECT
+public:
+    SymbolTableDialog(const MapModel &model, const QVector<MemoryRegion> &regions,
+                      QSharedPointer<Demangler> demangler, QWidget *parent = nullptr);
+
+private:
+    void applySearch();
+
+    SymbolTableModel *tableModel;
+    QLineEdit *searchEdit;
+    QTableView *tableView;
+    QLabel *countLabel;
+    QTimer *searchTimer;
+};
@@ -0,0 +1,167 @@
+#include "symboltablemodel.h"
+#include "symbolfilter.h"
+#include <QBitArray>
+#include <algorithm>
+
+SymbolTableModel::SymbolTableModel(const MapModel &model, const QVector<MemoryRegion> &regions,
+                                   QSharedPointer<Demangler> demangler, QObject *parent)
+    : QAbstractTableModel(parent), m_model(model), m_regions(regions), m_demangler(demangler)
+{
+    setSearch(QString());
+}
+
+int SymbolTableModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+int SymbolTableModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QString SymbolTableModel::text(quint32 id) const {
+    return id == StringPool::npos ? QString() : m_model.strings.at(id);
+}
+
+QVariant SymbolTableModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= m_rows.size())
+        return QVariant();
+
+    const SymbolColumns &symbols = m_model.symbols;
+    int row = m_rows[index.row()];
+
+    if (role == Qt::ToolTipRole && index.column() == NameColumn)
+        return text(symbols.name[row]);
+
+    if (role == Qt::TextAlignmentRole && (index.column() == AddressColumn || index.column() == SizeColumn))
+        return int(Qt::AlignRight | Qt::AlignVCenter);
+
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    switch (index.column()) {
+    case NameColumn:
+        return m_demangler ? m_demangler->name(symbols.name[row]) : text(symbols.name[row]);
+    case AddressColumn:
+        return QString("0x%1").arg(symbols.address[row], 8, 16, QChar('0'));
+    case SizeColumn:
+        return QString::number(symbols.size[row]);
+    case SectionColumn:
+        return text(symbols.section[row]);
+    case ObjectColumn:
+        return text(symbols.object[row]);
+    case RegionColumn: {
+        int region = symbols.region[row];
+        return region >= 0 && region < m_regions.size() ? m_regions[region].name : QString();
+    }
+    }
+    return QVariant();
+}
+
+QVariant SymbolTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    static const char *headers[ColumnCount] = { "Sembol", "Adres", "Boyut (byte)", "Bölüm", "Nesne", "Bölge" };
+    return section >= 0 && section < ColumnCount ? QString(headers[section]) : QVariant();
+}
+
+void SymbolTableModel::sort(int column, Qt::SortOrder order) {
+    const SymbolColumns &symbols = m_model.symbols;
+    const StringPool &strings = m_model.strings;
+
+    // Ad sıralaması ham adlarla yapılır; tüm tabloyu çözmek gerekmez
+    auto byString = [&strings](const QVector<quint32> &column) {
+        const QVector<quint32> *ids = &column;
+        return [&strings, ids](int a, int b) {
+            quint32 left = ids->at(a), right = ids->at(b);
+            if (left == right || right == StringPool::npos)
+                return false;
+            if (left == StringPool::npos)
+                return true;
+            return strings.at(left) < strings.at(right);
+        };
+    };
+
+    beginResetModel();
+    switch (column) {
+    case NameColumn:
+        std::stable_sort(m_rows.begin(), m_rows.end(), byString(symbols.name));
+        break;
+    case AddressColumn:
+        std::stable_sort(m_rows.begin(), m_rows.end(), [&symbols](int a, int b) {
+            return symbols.address[a] < symbols.address[b];
+        });
+        break;
+    case SizeColumn:
+        std::stable_sort(m_rows.begin(), m_rows.end(), [&symbols](int a, int b) {
+            return symbols.size[a] < symbols.size[b];
+        });
+        break;
+    case SectionColumn:
+        std::stable_sort(m_rows.begin(), m_rows.end(), byString(symbols.section));
+        break;
+    case ObjectColumn:
+        std::stable_sort(m_rows.begin(), m_rows.end(), byString(symbols.object));
+        break;
+    case RegionColumn:
+        std::stable_sort(m_rows.begin(), m_rows.end(), [&symbols](int a, int b) {
+            return symbols.region[a] < symbols.region[b];
+        });
+        break;
+    }
+    if (order == Qt::DescendingOrder)
+        std::reverse(m_rows.begin(), m_rows.end());
+    endResetModel();
+}
+
+bool SymbolTableModel::setSearch(const QString &text, QString *error) {
+    const SymbolColumns &symbols = m_model.symbols;
+    QString needle = text.trimmed();
+
+    SymbolFilter filter;
+    if (SymbolFilter::looksLikeExpression(needle)) {
+        filter = SymbolFilter::compile(needle);
+        if (!filter.isValid()) {
+            if (error)
+                *error = filter.errorString();
+            return false;
+        }
+    }
+
+    beginResetModel();
+    m_rows.clear();
+
+    if (filter.isValid()) {
+        m_rows = filter.apply(m_model, m_regions);
+    } else if (needle.isEmpty()) {
+        m_rows.reserve(symbols.count());
+        for (int i = 0; i < symbols.count(); ++i)
+            m_rows.append(i);
+    } else if (needle.endsWith('*') && needle.indexOf('*') == needle.size() - 1) {
+        // "_ZN4core3hal*": ön ek araması; kayıttan yüklenen modelde sıralı ad
+        // dizininde ikili arama, aksi hâlde havuzun tek taraması
+        QBitArray matches(m_model.strings.size());
+        for (quint32 id : m_model.strings.withPrefix(needle.left(needle.size() - 1)))
+            matches.setBit(int(id));
+        for (int i = 0; i < symbols.count(); ++i) {
+            quint32 id = symbols.name[i];
+            if (id < quint32(matches.size()) && matches.testBit(int(id)))
+                m_rows.append(i);
+        }
+    } else if (m_demangler && (needle.contains("::") || needle.contains('('))) {
+        // Niteliklendirilmiş ad aranıyor: yalnızca bu durumda tüm adlar (paralel) çözülür
+        QVector<QString> names = m_demangler->names(symbols.name);
+        for (int i = 0; i < names.size(); ++i) {
+            if (names[i].contains(needle, Qt::CaseInsensitive))
+                m_rows.append(i);
+        }
+    } else {
+        // Mangled adlar tanımlayıcıları düz metin olarak içerir (_ZN4core3hal...)
+        for (int i = 0; i < symbols.count(); ++i) {
+            if (m_model.strings.at(symbols.name[i]).contains(needle, Qt::CaseInsensitive))
+                m_rows.append(i);
+        }
+    }
+    endResetModel();
+    return true;
+}
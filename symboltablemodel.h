@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QSharedPointer>
+#include <QVector>
+#include "mapmodel.h"
+#include "demangler.h"
+
+// MapModel sembol sütunlarını QTableView'a bağlar. Satırlar bir indeks
+// vektörüdür; adlar yalnızca görünür hücreler istendiğinde çözülür.
+class SymbolTableModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    enum Column { NameColumn, AddressColumn, SizeColumn, SectionColumn, ObjectColumn, RegionColumn, ColumnCount };
+
+    SymbolTableModel(const MapModel &model, const QVector<MemoryRegion> &regions,
+                     QSharedPointer<Demangler> demangler, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    // Boş metin tüm sembolleri gösterir. İşleç içeren metin SymbolFilter
+    // ifadesi olarak derlenir; derlenemezse satırlar değişmez ve false döner.
+    // Sonda tek '*' olan metin mangled ad ön eki olarak aranır.
+    bool setSearch(const QString &text, QString *error = nullptr);
+    int totalCount() const { return m_model.symbols.count(); }
+
+private:
+    QString text(quint32 id) const;
+
+    const MapModel &m_model;
+    QVector<MemoryRegion> m_regions;
+    QSharedPointer<Demangler> m_demangler;
+    QVector<int> m_rows;
+};